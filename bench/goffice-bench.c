@@ -0,0 +1,759 @@
+#include <goffice/goffice.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+
+// Microbenchmarks for the math library.
+//
+// Every benchmark is run at a few sizes.  For each we report the best
+// time per element over several samples and the number of allocations
+// made by a single call.  Results can be written as JSON and compared
+// against such a file from an earlier run, typically of the previous
+// release:
+//
+//     goffice-bench --json=new.json --baseline=old.json
+//
+// The exit code is 1 if anything got slower than the tolerance allows or
+// allocates more than before.  Timings are only comparable between runs
+// on the same, otherwise idle, machine.
+//
+// With GOFFICE_BENCH_QUICK set in the environment, as for "make check",
+// everything runs once at the smallest size and the data is allocated
+// for that size only.  That only checks that the benchmarks work.
+
+// ------------------------------------------------------------------------
+
+// Allocation counting.  glib no longer lets us hook g_malloc, so with
+// glibc we interpose malloc and friends instead.  That sees allocations
+// made from within libgoffice and glib too.  glibc has no __libc_
+// versions of posix_memalign and aligned_alloc, so those go through
+// __libc_memalign.
+
+#if defined(__GLIBC__) && !defined(GO_BENCH_NO_ALLOC_COUNT)
+#define COUNT_ALLOCS 1
+
+extern void *__libc_malloc (size_t size);
+extern void *__libc_calloc (size_t nmemb, size_t size);
+extern void *__libc_realloc (void *ptr, size_t size);
+extern void *__libc_memalign (size_t alignment, size_t size);
+
+static gint alloc_count;
+
+void *
+malloc (size_t size)
+{
+	g_atomic_int_inc (&alloc_count);
+	return __libc_malloc (size);
+}
+
+void *
+calloc (size_t nmemb, size_t size)
+{
+	g_atomic_int_inc (&alloc_count);
+	return __libc_calloc (nmemb, size);
+}
+
+void *
+realloc (void *ptr, size_t size)
+{
+	g_atomic_int_inc (&alloc_count);
+	return __libc_realloc (ptr, size);
+}
+
+void *
+memalign (size_t alignment, size_t size)
+{
+	g_atomic_int_inc (&alloc_count);
+	return __libc_memalign (alignment, size);
+}
+
+void *
+aligned_alloc (size_t alignment, size_t size)
+{
+	g_atomic_int_inc (&alloc_count);
+	return __libc_memalign (alignment, size);
+}
+
+int
+posix_memalign (void **memptr, size_t alignment, size_t size)
+{
+	void *p;
+
+	if (alignment == 0 || alignment % sizeof (void *) != 0 ||
+	    (alignment & (alignment - 1)) != 0)
+		return EINVAL;
+
+	g_atomic_int_inc (&alloc_count);
+	p = __libc_memalign (alignment, size);
+	if (!p)
+		return ENOMEM;
+	*memptr = p;
+	return 0;
+}
+#endif
+
+// ------------------------------------------------------------------------
+
+#define MAX_N 1000000
+#define QUAD_MAX_N 10000
+#define QUAD_COLS 32
+
+static double *unif;	// uniform on (0,1)
+static double *xs;	// uniform on (-5,5)
+static double *knots;	// increasing
+static double *ys;	// roughly 2x+1
+static double *work;
+static go_complex *cin;
+static GOQuad *qa, *qb, *qres;
+
+static GOCSpline *spline;
+static GOCSplineWorkspace *spline_ws;
+static double *queries;
+static GOData *vec_data;
+
+// Results go here so the compiler cannot drop the computations.
+static volatile double sink;
+
+// The data is shared by all benchmarks.  n elements suffice for sizes up
+// to n, except that the quad benchmarks need qn rows of QUAD_COLS.
+static void
+setup_data (int n, int qn)
+{
+	GRand *rand = g_rand_new_with_seed (42);
+	double x = 0;
+	int i;
+
+	unif = g_new (double, n);
+	xs = g_new (double, n);
+	knots = g_new (double, n);
+	ys = g_new (double, n);
+	work = g_new (double, n);
+	cin = g_new (go_complex, n);
+	for (i = 0; i < n; i++) {
+		unif[i] = g_rand_double_range (rand, 1e-9, 1 - 1e-9);
+		xs[i] = 10 * unif[i] - 5;
+		x += g_rand_double_range (rand, 0.5, 1.5);
+		knots[i] = x;
+		ys[i] = 2 * x + 1 + xs[i];
+		go_complex_init (cin + i, xs[i], unif[i]);
+	}
+
+	qa = g_new (GOQuad, qn);
+	qb = g_new (GOQuad, qn * QUAD_COLS);
+	qres = g_new (GOQuad, qn);
+	for (i = 0; i < qn; i++)
+		go_quad_init (qa + i, xs[i % n]);
+	for (i = 0; i < qn * QUAD_COLS; i++)
+		go_quad_init (qb + i, xs[i % n] * unif[i % n]);
+
+	g_rand_free (rand);
+}
+
+static void
+free_data (void)
+{
+	g_free (unif);
+	g_free (xs);
+	g_free (knots);
+	g_free (ys);
+	g_free (work);
+	g_free (cin);
+	g_free (qa);
+	g_free (qb);
+	g_free (qres);
+}
+
+// ------------------------------------------------------------------------
+// The benchmarks.  Each does one call, or one loop of calls, of size n
+// and returns the number of elements handled.
+
+#define RANGE_BENCH(f_)				\
+static int					\
+bench_ ## f_ (int n)				\
+{						\
+	double r;				\
+	f_ (xs, n, &r);				\
+	sink = r;				\
+	return n;				\
+}
+
+RANGE_BENCH(go_range_sum)
+RANGE_BENCH(go_range_sum_parallel)
+RANGE_BENCH(go_range_sumsq)
+RANGE_BENCH(go_range_average)
+RANGE_BENCH(go_range_min)
+RANGE_BENCH(go_range_max)
+RANGE_BENCH(go_range_maxabs)
+RANGE_BENCH(go_range_devsq)
+RANGE_BENCH(go_range_median_inter)
+
+#undef RANGE_BENCH
+
+static int
+bench_go_range_increasing (int n)
+{
+	sink = go_range_increasing (knots, n);
+	return n;
+}
+
+static int
+bench_go_fourier_fft (int n)
+{
+	go_complex *res;
+	go_fourier_fft (cin, n, 1, &res, FALSE);
+	sink = res[n / 2].re;
+	g_free (res);
+	return n;
+}
+
+static int
+bench_go_fourier_fft_real (int n)
+{
+	go_complex *res;
+	go_fourier_fft_real (xs, n, 1, &res);
+	sink = res[n / 2].re;
+	g_free (res);
+	return n;
+}
+
+static int
+bench_go_linear_regression (int n)
+{
+	double *xss[1] = { knots };
+	double res[2];
+	go_linear_regression (xss, 1, ys, n, TRUE, res, NULL);
+	sink = res[1];
+	return n;
+}
+
+static int
+bench_go_cspline_init (int n)
+{
+	GOCSpline *sp = go_cspline_init (knots, ys, n,
+					 GO_CSPLINE_NATURAL, 0, 0);
+	sink = sp->a[0];
+	go_cspline_destroy (sp);
+	return n;
+}
+
+static int
+bench_go_cspline_refit (int n)
+{
+	go_cspline_refit (spline, knots, ys, n,
+			  GO_CSPLINE_NATURAL, 0, 0, spline_ws);
+	sink = spline->a[0];
+	return n;
+}
+
+static int
+bench_go_cspline_get_values (int n)
+{
+	double *res = go_cspline_get_values (spline, queries, n);
+	sink = res[n / 2];
+	g_free (res);
+	return n;
+}
+
+static int
+bench_go_quad_dot_product (int n)
+{
+	GOQuad r;
+	void *state = go_quad_start ();
+	go_quad_dot_product (&r, qa, qb, n);
+	sink = go_quad_value (&r);
+	go_quad_end (state);
+	return n;
+}
+
+static int
+bench_go_quad_dot_product_v (int n)
+{
+	void *state = go_quad_start ();
+	go_quad_dot_product_v (qres, qa, qb, n, QUAD_COLS);
+	sink = go_quad_value (qres);
+	go_quad_end (state);
+	return n * QUAD_COLS;
+}
+
+static int
+bench_go_quad_axpy_v (int n)
+{
+	void *state = go_quad_start ();
+	memcpy (qres, qb, n * sizeof (GOQuad));
+	go_quad_axpy_v (qres, qa + 1, qa, n);
+	sink = go_quad_value (qres + n / 2);
+	go_quad_end (state);
+	return n;
+}
+
+static int
+bench_go_pnorm (int n)
+{
+	double s = 0;
+	int i;
+	for (i = 0; i < n; i++)
+		s += go_pnorm (xs[i], 0, 1, TRUE, FALSE);
+	sink = s;
+	return n;
+}
+
+static int
+bench_go_pnorm_v (int n)
+{
+	go_pnorm_v (xs, work, n, 0, 1, TRUE, FALSE);
+	sink = work[n / 2];
+	return n;
+}
+
+static int
+bench_go_qnorm (int n)
+{
+	double s = 0;
+	int i;
+	for (i = 0; i < n; i++)
+		s += go_qnorm (unif[i], 0, 1, TRUE, FALSE);
+	sink = s;
+	return n;
+}
+
+static int
+bench_go_qnorm_v (int n)
+{
+	go_qnorm_v (unif, work, n, 0, 1, TRUE, FALSE);
+	sink = work[n / 2];
+	return n;
+}
+
+static void
+prepare_spline (int n)
+{
+	// Unsorted queries spread over the whole spline.
+	int i;
+	double *x = g_new (double, n);
+	queries = g_new (double, n);
+	for (i = 0; i < n; i++) {
+		x[i] = i;
+		queries[i] = unif[i] * (n - 1);
+	}
+	spline = go_cspline_init (x, ys, n, GO_CSPLINE_NATURAL, 0, 0);
+	g_free (x);
+}
+
+static void
+cleanup_spline (int n)
+{
+	go_cspline_destroy (spline);
+	g_free (queries);
+	spline = NULL;
+	queries = NULL;
+}
+
+static void
+prepare_refit (int n)
+{
+	spline = go_cspline_init (knots, ys, n, GO_CSPLINE_NATURAL, 0, 0);
+	spline_ws = go_cspline_workspace_new ();
+}
+
+static void
+cleanup_refit (int n)
+{
+	go_cspline_destroy (spline);
+	go_cspline_workspace_free (spline_ws);
+	spline = NULL;
+	spline_ws = NULL;
+}
+
+static void
+prepare_vector (int n)
+{
+	vec_data = go_data_vector_val_new (knots, n, NULL);
+}
+
+static void
+cleanup_vector (int n)
+{
+	g_object_unref (vec_data);
+	vec_data = NULL;
+}
+
+// What chart layout asks of a vector after each change.
+static int
+bench_go_data_vector_get_stats (int n)
+{
+	GODataVector *vec = GO_DATA_VECTOR (vec_data);
+	double min, max;
+
+	go_data_emit_changed (vec_data);
+	go_data_vector_get_minmax (vec, &min, &max);
+	sink = min + max +
+		go_data_vector_increasing (vec) +
+		go_data_vector_decreasing (vec) +
+		go_data_vector_vary_uniformly (vec);
+	return n;
+}
+
+static const int sizes_range[] = { 100, 10000, MAX_N, 0 };
+static const int sizes_fft[] = { 256, 1000, 65536, 0 };
+static const int sizes_reg[] = { 100, 10000, 100000, 0 };
+static const int sizes_quad[] = { 100, QUAD_MAX_N, 0 };
+static const int sizes_dist[] = { 100, 100000, 0 };
+
+typedef struct {
+	const char *name;
+	int (*run) (int n);
+	const int *sizes;
+	void (*prepare) (int n);
+	void (*cleanup) (int n);
+} Benchmark;
+
+#define BENCH(f_,sizes_) { #f_, bench_ ## f_, sizes_, NULL, NULL }
+#define BENCH_PREP(f_,sizes_,p_) { #f_, bench_ ## f_, sizes_, prepare_ ## p_, cleanup_ ## p_ }
+
+static const Benchmark benchmarks[] = {
+	BENCH (go_range_sum, sizes_range),
+	BENCH (go_range_sum_parallel, sizes_range),
+	BENCH (go_range_sumsq, sizes_range),
+	BENCH (go_range_average, sizes_range),
+	BENCH (go_range_min, sizes_range),
+	BENCH (go_range_max, sizes_range),
+	BENCH (go_range_maxabs, sizes_range),
+	BENCH (go_range_devsq, sizes_range),
+	BENCH (go_range_median_inter, sizes_range),
+	BENCH (go_range_increasing, sizes_range),
+	BENCH_PREP (go_data_vector_get_stats, sizes_range, vector),
+	BENCH (go_fourier_fft, sizes_fft),
+	BENCH (go_fourier_fft_real, sizes_fft),
+	BENCH (go_linear_regression, sizes_reg),
+	BENCH (go_cspline_init, sizes_reg),
+	BENCH_PREP (go_cspline_refit, sizes_reg, refit),
+	BENCH_PREP (go_cspline_get_values, sizes_reg, spline),
+	BENCH (go_quad_dot_product, sizes_quad),
+	BENCH (go_quad_dot_product_v, sizes_quad),
+	BENCH (go_quad_axpy_v, sizes_quad),
+	BENCH (go_pnorm, sizes_dist),
+	BENCH (go_pnorm_v, sizes_dist),
+	BENCH (go_qnorm, sizes_dist),
+	BENCH (go_qnorm_v, sizes_dist),
+};
+
+#undef BENCH
+#undef BENCH_PREP
+
+// ------------------------------------------------------------------------
+
+typedef struct {
+	char *name;
+	int n;
+	double ns_per_element;
+	double allocs_per_call;	// -1 if not known
+} BenchResult;
+
+static gboolean quick;
+static int samples = 5;
+static gint64 min_sample_us = 50000;
+
+// The largest of sizes that will be run.
+static int
+max_size (const int *sizes)
+{
+	int si, n = 0;
+
+	for (si = 0; sizes[si]; si++) {
+		n = MAX (n, sizes[si]);
+		if (quick)
+			break;
+	}
+	return n;
+}
+
+static void
+measure (const Benchmark *b, int n, BenchResult *res)
+{
+	int reps = 1, s, r, elems = 0;
+	gint64 t0, dt;
+	double best = -1;
+
+	// One warm-up call, e.g., for fft plans and caches.
+	b->run (n);
+
+	for (s = 0; s < samples; s++) {
+		while (1) {
+			t0 = g_get_monotonic_time ();
+			for (r = 0; r < reps; r++)
+				elems = b->run (n);
+			dt = g_get_monotonic_time () - t0;
+			if (dt >= min_sample_us || s > 0)
+				break;
+			// Calibrate the number of repetitions.
+			reps = dt <= 0
+				? reps * 16
+				: MAX (reps * 2, (int)(reps * 1.2 * min_sample_us / dt));
+		}
+		if (best < 0 || dt < best)
+			best = dt;
+	}
+
+	res->name = g_strdup (b->name);
+	res->n = n;
+	res->ns_per_element = best * 1000.0 / reps / elems;
+
+#ifdef COUNT_ALLOCS
+	g_atomic_int_set (&alloc_count, 0);
+	b->run (n);
+	res->allocs_per_call = g_atomic_int_get (&alloc_count);
+#else
+	res->allocs_per_call = -1;
+#endif
+}
+
+static void
+write_json (const char *filename, GArray *results)
+{
+	GString *s = g_string_new (NULL);
+	GError *err = NULL;
+	unsigned ui;
+	char buf[G_ASCII_DTOSTR_BUF_SIZE];
+
+	g_string_append (s, "{\n");
+	g_string_append_printf (s, "  \"version\": \"%s\",\n",
+				GOFFICE_VERSION);
+	g_string_append (s, "  \"results\": [\n");
+	for (ui = 0; ui < results->len; ui++) {
+		BenchResult const *r = &g_array_index (results, BenchResult, ui);
+		// One result per line; read_baseline relies on that.
+		g_string_append_printf (s, "    {\"name\": \"%s\", \"n\": %d, ",
+					r->name, r->n);
+		g_string_append_printf (s, "\"ns_per_element\": %s, ",
+					g_ascii_formatd (buf, sizeof (buf),
+							 "%.6g", r->ns_per_element));
+		if (r->allocs_per_call < 0)
+			g_string_append (s, "\"allocs_per_call\": null}");
+		else
+			g_string_append_printf (s, "\"allocs_per_call\": %.0f}",
+						r->allocs_per_call);
+		g_string_append (s, ui + 1 < results->len ? ",\n" : "\n");
+	}
+	g_string_append (s, "  ]\n}\n");
+
+	if (!g_file_set_contents (filename, s->str, s->len, &err)) {
+		g_printerr ("%s\n", err->message);
+		g_error_free (err);
+	}
+	g_string_free (s, TRUE);
+}
+
+// Find "key": in line and return a pointer to the value after it.
+static const char *
+json_field (const char *line, const char *key)
+{
+	char *pat = g_strdup_printf ("\"%s\":", key);
+	const char *p = strstr (line, pat);
+	if (p) {
+		p += strlen (pat);
+		while (*p == ' ')
+			p++;
+	}
+	g_free (pat);
+	return p;
+}
+
+// This reads only what write_json writes, not general JSON.
+static GArray *
+read_baseline (const char *filename)
+{
+	char *contents;
+	char **lines;
+	GError *err = NULL;
+	GArray *results;
+	int i;
+
+	if (!g_file_get_contents (filename, &contents, NULL, &err)) {
+		g_printerr ("%s\n", err->message);
+		g_error_free (err);
+		return NULL;
+	}
+
+	results = g_array_new (FALSE, FALSE, sizeof (BenchResult));
+	lines = g_strsplit (contents, "\n", -1);
+	for (i = 0; lines[i]; i++) {
+		const char *name = json_field (lines[i], "name");
+		const char *n = json_field (lines[i], "n");
+		const char *ns = json_field (lines[i], "ns_per_element");
+		const char *allocs = json_field (lines[i], "allocs_per_call");
+		const char *end;
+		BenchResult r;
+
+		if (!name || !n || !ns || !allocs || *name != '"')
+			continue;
+		name++;
+		end = strchr (name, '"');
+		if (!end)
+			continue;
+		r.name = g_strndup (name, end - name);
+		r.n = atoi (n);
+		r.ns_per_element = g_ascii_strtod (ns, NULL);
+		r.allocs_per_call = g_str_has_prefix (allocs, "null")
+			? -1
+			: g_ascii_strtod (allocs, NULL);
+		g_array_append_val (results, r);
+	}
+
+	g_strfreev (lines);
+	g_free (contents);
+	return results;
+}
+
+static BenchResult const *
+find_result (GArray *results, const char *name, int n)
+{
+	unsigned ui;
+	for (ui = 0; ui < results->len; ui++) {
+		BenchResult const *r = &g_array_index (results, BenchResult, ui);
+		if (r->n == n && strcmp (r->name, name) == 0)
+			return r;
+	}
+	return NULL;
+}
+
+static void
+free_results (GArray *results)
+{
+	unsigned ui;
+	if (!results)
+		return;
+	for (ui = 0; ui < results->len; ui++)
+		g_free (g_array_index (results, BenchResult, ui).name);
+	g_array_free (results, TRUE);
+}
+
+// ------------------------------------------------------------------------
+
+static char *json_file;
+static char *baseline_file;
+static char *filter;
+static double tolerance = 10;
+
+static const GOptionEntry options[] = {
+	{ "json", 'j', 0, G_OPTION_ARG_FILENAME, &json_file,
+	  "Write results to FILE as JSON", "FILE" },
+	{ "baseline", 'b', 0, G_OPTION_ARG_FILENAME, &baseline_file,
+	  "Compare against results from FILE", "FILE" },
+	{ "tolerance", 't', 0, G_OPTION_ARG_DOUBLE, &tolerance,
+	  "Percentage slowdown to accept when comparing [10]", "PCT" },
+	{ "filter", 'f', 0, G_OPTION_ARG_STRING, &filter,
+	  "Run only benchmarks whose name contains STR", "STR" },
+	{ "quick", 'q', 0, G_OPTION_ARG_NONE, &quick,
+	  "Run everything once at the smallest size", NULL },
+	{ NULL }
+};
+
+int
+main (int argc, char **argv)
+{
+	GOptionContext *ctx;
+	GError *err = NULL;
+	GArray *results, *baseline = NULL;
+	int regressions = 0, data_n = 0;
+	unsigned bi;
+
+	ctx = g_option_context_new (NULL);
+	g_option_context_set_summary (ctx, "Time the goffice math library.");
+	g_option_context_add_main_entries (ctx, options, NULL);
+	if (!g_option_context_parse (ctx, &argc, &argv, &err)) {
+		g_printerr ("%s\n", err->message);
+		g_error_free (err);
+		g_option_context_free (ctx);
+		return 2;
+	}
+	g_option_context_free (ctx);
+
+	if (g_getenv ("GOFFICE_BENCH_QUICK"))
+		quick = TRUE;
+	if (quick) {
+		samples = 1;
+		min_sample_us = 0;
+	}
+
+	if (baseline_file && !quick) {
+		baseline = read_baseline (baseline_file);
+		if (!baseline)
+			return 2;
+	}
+
+	// In quick mode this keeps the data small; full size is about 70MB.
+	for (bi = 0; bi < G_N_ELEMENTS (benchmarks); bi++)
+		data_n = MAX (data_n, max_size (benchmarks[bi].sizes));
+
+	libgoffice_init ();
+	setup_data (data_n, max_size (sizes_quad));
+
+	results = g_array_new (FALSE, FALSE, sizeof (BenchResult));
+
+	g_printerr ("%-28s %8s %12s %8s", "benchmark", "n", "ns/elem", "allocs");
+	if (baseline)
+		g_printerr (" %12s %7s", "baseline", "ratio");
+	g_printerr ("\n");
+
+	for (bi = 0; bi < G_N_ELEMENTS (benchmarks); bi++) {
+		const Benchmark *b = benchmarks + bi;
+		int si;
+
+		if (filter && !strstr (b->name, filter))
+			continue;
+
+		for (si = 0; b->sizes[si]; si++) {
+			int n = b->sizes[si];
+			BenchResult r;
+			BenchResult const *base;
+			const char *flag = "";
+
+			if (quick && si > 0)
+				break;
+
+			if (b->prepare)
+				b->prepare (n);
+			measure (b, n, &r);
+			if (b->cleanup)
+				b->cleanup (n);
+			g_array_append_val (results, r);
+
+			g_printerr ("%-28s %8d %12.4g %8.0f",
+				    r.name, n, r.ns_per_element,
+				    r.allocs_per_call);
+
+			base = baseline ? find_result (baseline, r.name, n) : NULL;
+			if (base) {
+				double ratio = r.ns_per_element / base->ns_per_element;
+				if (ratio > 1 + tolerance / 100) {
+					flag = "  SLOWER";
+					regressions++;
+				}
+				if (r.allocs_per_call > base->allocs_per_call &&
+				    base->allocs_per_call >= 0) {
+					flag = "  MORE ALLOCS";
+					regressions++;
+				}
+				g_printerr (" %12.4g %7.3f%s",
+					    base->ns_per_element, ratio, flag);
+			} else if (baseline)
+				g_printerr (" %12s", "-");
+			g_printerr ("\n");
+		}
+	}
+
+	if (json_file)
+		write_json (json_file, results);
+
+	if (baseline)
+		g_printerr ("%d regression%s\n",
+			    regressions, regressions == 1 ? "" : "s");
+
+	free_results (results);
+	free_results (baseline);
+	free_data ();
+	libgoffice_shutdown ();
+
+	return regressions ? 1 : 0;
+}
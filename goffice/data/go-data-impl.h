@@ -32,7 +32,8 @@ typedef enum {
 	GO_DATA_CACHE_IS_VALID =	1 << 0,
 	GO_DATA_IS_EDITABLE =		1 << 1,
 	GO_DATA_SIZE_CACHED =		1 << 2,
-	GO_DATA_HAS_VALUE = 1 << 3
+	GO_DATA_HAS_VALUE = 1 << 3,
+	GO_DATA_STATS_CACHED =		1 << 4
 } GODataFlags;
 
 struct _GOData {
@@ -79,6 +80,7 @@ typedef struct {
 } GODataScalarClass;
 
 #define GO_DATA_VECTOR_LEN_CACHED GO_DATA_SIZE_CACHED
+#define GO_DATA_VECTOR_STATS_CACHED GO_DATA_STATS_CACHED
 
 struct _GODataVector {
 	GOData base;
@@ -97,6 +99,9 @@ typedef struct {
 	PangoAttrList *(*get_markup) (GODataVector *vec, unsigned i);
 } GODataVectorClass;
 
+void go_data_vector_class_set_load_values_range (GODataVectorClass *klass,
+	void (*load_values_range) (GODataVector *vec, int first, int last));
+
 #define	GO_DATA_MATRIX_SIZE_CACHED GO_DATA_SIZE_CACHED
 
 struct _GODataMatrix {
@@ -0,0 +1,675 @@
+/*
+ * go-data-mapped.c :
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of the
+ * License, or (at your option) version 3.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301
+ * USA
+ */
+#include <goffice/goffice-config.h>
+#include "go-data-mapped.h"
+#include "go-data-impl.h"
+#include <goffice/app/go-cmd-context.h>
+#include <goffice/utils/go-glib-extras.h>
+#include <goffice/math/go-math.h>
+#include <goffice/math/go-dtoa.h>
+
+#include <gsf/gsf-impl-utils.h>
+#include <glib/gi18n-lib.h>
+#include <glib/gstdio.h>
+
+#include <string.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <float.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+
+#ifndef O_NONBLOCK
+#define O_NONBLOCK 0
+#endif
+
+/**
+ * SECTION:go-data-mapped
+ * @short_description: Data read from memory-mapped files
+ *
+ * #GODataVectorMapped and #GODataMatrixMapped show the contents of a file
+ * of raw little-endian doubles without copying it into memory.  The file
+ * is mapped privately; this also works for shared memory that has a file
+ * name, such as POSIX shared memory under /dev/shm.  Other special files,
+ * such as devices and fifos, are refused.
+ *
+ * As for other data, the array from go_data_vector_get_values() or
+ * go_data_matrix_get_values() may be written to.  Only the pages written
+ * to are copied, the file itself never changes, and the changes are lost
+ * when the file is mapped again.
+ *
+ * The file may start with a header of #GO_DATA_MAPPED_HEADER_SIZE bytes:
+ * the 8 bytes of #GO_DATA_MAPPED_MAGIC followed by the number of rows and
+ * the number of columns as little-endian 32-bit unsigned integers.  The
+ * values follow in row-major order.  Without a header, a vector is the
+ * whole file and a matrix needs its dimensions from the caller.
+ *
+ * Bounds are only computed when values or bounds are asked for, and
+ * large files are scanned in chunks on several threads.  Single values
+ * are read straight from the map.
+ *
+ * The file must not be truncated while it is mapped.  If it is rewritten
+ * or grows, go_data_mapped_refresh() maps it again.
+ **/
+
+typedef struct {
+	char *filename;
+	GMappedFile *file;
+	double *val;		/* in the map, or in copy */
+	double *copy;		/* byte-swapped values on big-endian hosts */
+	int rows, columns;
+	int req_rows, req_columns;	/* as passed in, 0 to use the header */
+	gint64 size, mtime;	/* for noticing changes */
+} GODataMapping;
+
+static gboolean
+go_data_mapping_open (GODataMapping *m, char const *filename,
+		      int rows, int columns, gboolean is_vector,
+		      GError **err)
+{
+	struct stat st;
+	GMappedFile *file;
+	char *contents;
+	gsize size, offset = 0;
+	guint64 n;
+	int fd;
+
+	/*
+	 * Open the file just once so that what we check is what we map.
+	 * Mapping anything but a regular file, a fifo say, makes no sense.
+	 * O_NONBLOCK keeps the open of a fifo from waiting for a writer.
+	 */
+	fd = g_open (filename, O_RDONLY | O_NONBLOCK, 0);
+	if (fd < 0 || fstat (fd, &st) != 0) {
+		int save_errno = errno;
+		if (fd >= 0)
+			g_close (fd, NULL);
+		g_set_error (err, G_FILE_ERROR,
+			     g_file_error_from_errno (save_errno),
+			     _("Could not open %s: %s"),
+			     filename, g_strerror (save_errno));
+		return FALSE;
+	}
+	if (!S_ISREG (st.st_mode)) {
+		g_close (fd, NULL);
+		g_set_error (err, G_FILE_ERROR, G_FILE_ERROR_INVAL,
+			     _("%s is not a regular file"), filename);
+		return FALSE;
+	}
+
+	/*
+	 * Writable means copy-on-write here, so that the values can be handed
+	 * out as the non-const arrays of GODataVector and GODataMatrix.
+	 */
+	file = g_mapped_file_new_from_fd (fd, TRUE, err);
+	g_close (fd, NULL);
+	if (!file)
+		return FALSE;
+	contents = g_mapped_file_get_contents (file);
+	size = g_mapped_file_get_length (file);
+
+	if (size >= GO_DATA_MAPPED_HEADER_SIZE &&
+	    memcmp (contents, GO_DATA_MAPPED_MAGIC, 8) == 0) {
+		guint32 r, c;
+		memcpy (&r, contents + 8, 4);
+		memcpy (&c, contents + 12, 4);
+		r = GUINT32_FROM_LE (r);
+		c = GUINT32_FROM_LE (c);
+		if (r > G_MAXINT || c > G_MAXINT ||
+		    (rows > 0 && (guint32)rows != r) ||
+		    (columns > 0 && (guint32)columns != c)) {
+			g_set_error (err, go_error_import (), 0,
+				     _("The dimensions in %s do not match"),
+				     filename);
+			g_mapped_file_unref (file);
+			return FALSE;
+		}
+		m->rows = r;
+		m->columns = c;
+		offset = GO_DATA_MAPPED_HEADER_SIZE;
+	} else if (is_vector) {
+		if (size % sizeof (double) != 0 ||
+		    size / sizeof (double) > G_MAXINT) {
+			g_set_error (err, go_error_import (), 0,
+				     _("%s does not hold a vector of doubles"),
+				     filename);
+			g_mapped_file_unref (file);
+			return FALSE;
+		}
+		m->rows = size / sizeof (double);
+		m->columns = 1;
+	} else if (rows > 0 && columns > 0) {
+		m->rows = rows;
+		m->columns = columns;
+	} else {
+		g_set_error (err, go_error_import (), 0,
+			     _("%s has no header with the matrix dimensions"),
+			     filename);
+		g_mapped_file_unref (file);
+		return FALSE;
+	}
+
+	n = (guint64)m->rows * m->columns;
+	if (n > G_MAXINT || n > (size - offset) / sizeof (double)) {
+		g_set_error (err, go_error_import (), 0,
+			     _("%s is too short for %d by %d values"),
+			     filename, m->rows, m->columns);
+		g_mapped_file_unref (file);
+		return FALSE;
+	}
+
+#if G_BYTE_ORDER == G_LITTLE_ENDIAN
+	/* The map is page aligned and so is the header, so this is fine.  */
+	m->val = n ? (double *)(contents + offset) : NULL;
+	m->copy = NULL;
+#else
+	{
+		guint64 i;
+		m->copy = g_new (double, n);
+		for (i = 0; i < n; i++) {
+			guint64 u;
+			memcpy (&u, contents + offset + i * sizeof (u), sizeof (u));
+			u = GUINT64_FROM_LE (u);
+			memcpy (m->copy + i, &u, sizeof (u));
+		}
+		m->val = m->copy;
+	}
+#endif
+
+	m->filename = g_strdup (filename);
+	m->file = file;
+	m->req_rows = rows;
+	m->req_columns = columns;
+	m->size = st.st_size;
+	m->mtime = st.st_mtime;
+	return TRUE;
+}
+
+static void
+go_data_mapping_clear (GODataMapping *m)
+{
+	g_free (m->filename);
+	if (m->file)
+		g_mapped_file_unref (m->file);
+	g_free (m->copy);
+	memset (m, 0, sizeof (*m));
+}
+
+/*
+ * The copy gets a map of its own, so that writes to the values of one do
+ * not show in the other.  That also picks up any change to the file.  If
+ * the file cannot be mapped any more, the values are copied instead.
+ */
+static void
+go_data_mapping_copy (GODataMapping *dst, GODataMapping const *src,
+		      gboolean is_vector)
+{
+	if (src->file &&
+	    go_data_mapping_open (dst, src->filename,
+				  src->req_rows, src->req_columns,
+				  is_vector, NULL))
+		return;
+
+	*dst = *src;
+	dst->filename = g_strdup (src->filename);
+	dst->file = NULL;
+	dst->copy = go_memdup_n (src->val, (gsize)src->rows * src->columns,
+				 sizeof (double));
+	dst->val = dst->copy;
+}
+
+static gboolean
+go_data_mapping_eq (GODataMapping const *a, GODataMapping const *b)
+{
+	return g_strcmp0 (a->filename, b->filename) == 0 &&
+		a->rows == b->rows && a->columns == b->columns;
+}
+
+/* Sizes below this are scanned on one thread.  */
+#define MAPPED_CHUNK (1 << 20)
+
+typedef struct {
+	double const *xs;
+	gsize n;
+	double minimum, maximum;
+} GODataMappedBoundsJob;
+
+static void
+mapped_bounds_job (GODataMappedBoundsJob *job, G_GNUC_UNUSED gpointer user)
+{
+	double minimum = DBL_MAX, maximum = -DBL_MAX;
+	gsize i;
+
+	for (i = 0; i < job->n; i++) {
+		double x = job->xs[i];
+		if (!go_finite (x))
+			continue;
+		if (minimum > x)
+			minimum = x;
+		if (maximum < x)
+			maximum = x;
+	}
+	job->minimum = minimum;
+	job->maximum = maximum;
+}
+
+static void
+mapped_bounds (double const *xs, gsize n, double *minimum, double *maximum)
+{
+	int nthreads = MIN ((gsize)g_get_num_processors (), n / MAPPED_CHUNK);
+	GODataMappedBoundsJob *jobs;
+	GThreadPool *pool;
+	int i;
+
+	if (nthreads <= 1) {
+		GODataMappedBoundsJob job = { xs, n, 0, 0 };
+		mapped_bounds_job (&job, NULL);
+		*minimum = job.minimum;
+		*maximum = job.maximum;
+		return;
+	}
+
+	/* As for go_range_sum_parallel.  */
+	jobs = g_new (GODataMappedBoundsJob, nthreads);
+	pool = g_thread_pool_new ((GFunc)mapped_bounds_job, NULL,
+				  nthreads - 1, FALSE, NULL);
+	for (i = 0; i < nthreads; i++) {
+		gsize start = (guint64)n * i / nthreads;
+		gsize end = (guint64)n * (i + 1) / nthreads;
+		jobs[i].xs = xs + start;
+		jobs[i].n = end - start;
+		if (i > 0)
+			g_thread_pool_push (pool, jobs + i, NULL);
+	}
+	mapped_bounds_job (jobs, NULL);
+	g_thread_pool_free (pool, FALSE, TRUE);
+
+	for (i = 1; i < nthreads; i++) {
+		jobs[0].minimum = MIN (jobs[0].minimum, jobs[i].minimum);
+		jobs[0].maximum = MAX (jobs[0].maximum, jobs[i].maximum);
+	}
+	*minimum = jobs[0].minimum;
+	*maximum = jobs[0].maximum;
+	g_free (jobs);
+}
+
+#undef MAPPED_CHUNK
+
+static char *
+render_val (double val)
+{
+	char buf[GO_DTOA_SHORTEST_BUF_SIZE];
+	go_dtoa_shortest (val, buf);
+	return g_strdup (buf);
+}
+
+/*****************************************************************************/
+
+struct _GODataVectorMapped {
+	GODataVector	 base;
+	GODataMapping	 map;
+};
+typedef GODataVectorClass GODataVectorMappedClass;
+
+static GObjectClass *vector_mapped_parent_klass;
+
+static void
+go_data_vector_mapped_finalize (GObject *obj)
+{
+	GODataVectorMapped *vec = (GODataVectorMapped *)obj;
+	go_data_mapping_clear (&vec->map);
+	(*vector_mapped_parent_klass->finalize) (obj);
+}
+
+static GOData *
+go_data_vector_mapped_dup (GOData const *src)
+{
+	GODataVectorMapped *dst = g_object_new (G_OBJECT_TYPE (src), NULL);
+	go_data_mapping_copy (&dst->map, &((GODataVectorMapped const *)src)->map,
+			      TRUE);
+	return GO_DATA (dst);
+}
+
+static gboolean
+go_data_vector_mapped_eq (GOData const *a, GOData const *b)
+{
+	return go_data_mapping_eq (&((GODataVectorMapped const *)a)->map,
+				   &((GODataVectorMapped const *)b)->map);
+}
+
+static char *
+go_data_vector_mapped_serialize (GOData const *dat, gpointer user)
+{
+	return g_strdup (((GODataVectorMapped const *)dat)->map.filename);
+}
+
+static gboolean
+go_data_vector_mapped_unserialize (GOData *dat, char const *str, gpointer user)
+{
+	GODataVectorMapped *vec = (GODataVectorMapped *)dat;
+	GODataMapping map = { NULL };
+
+	g_return_val_if_fail (str != NULL, FALSE);
+
+	if (!go_data_mapping_open (&map, str, 0, 0, TRUE, NULL))
+		return FALSE;
+	go_data_mapping_clear (&vec->map);
+	vec->map = map;
+	go_data_emit_changed (dat);
+	return TRUE;
+}
+
+static void
+go_data_vector_mapped_load_len (GODataVector *vec)
+{
+	GODataMapping const *map = &((GODataVectorMapped *)vec)->map;
+	vec->base.flags |= GO_DATA_VECTOR_LEN_CACHED;
+	vec->len = map->rows * map->columns;
+}
+
+static void
+go_data_vector_mapped_load_values (GODataVector *vec)
+{
+	GODataMapping const *map = &((GODataVectorMapped *)vec)->map;
+
+	vec->len = map->rows * map->columns;
+	vec->values = map->val;
+	mapped_bounds (map->val, vec->len, &vec->minimum, &vec->maximum);
+	vec->base.flags |= GO_DATA_CACHE_IS_VALID;
+}
+
+static double
+go_data_vector_mapped_get_value (GODataVector *vec, unsigned i)
+{
+	GODataMapping const *map = &((GODataVectorMapped *)vec)->map;
+	g_return_val_if_fail (i < (unsigned)(map->rows * map->columns), go_nan);
+	return map->val[i];
+}
+
+static char *
+go_data_vector_mapped_get_str (GODataVector *vec, unsigned i)
+{
+	GODataMapping const *map = &((GODataVectorMapped *)vec)->map;
+	g_return_val_if_fail (i < (unsigned)(map->rows * map->columns), NULL);
+	return render_val (map->val[i]);
+}
+
+static void
+go_data_vector_mapped_class_init (GObjectClass *gobject_klass)
+{
+	GODataClass *godata_klass = (GODataClass *) gobject_klass;
+	GODataVectorClass *vector_klass = (GODataVectorClass *) gobject_klass;
+
+	vector_mapped_parent_klass = g_type_class_peek_parent (gobject_klass);
+	gobject_klass->finalize = go_data_vector_mapped_finalize;
+	godata_klass->dup	= go_data_vector_mapped_dup;
+	godata_klass->eq	= go_data_vector_mapped_eq;
+	godata_klass->serialize	= go_data_vector_mapped_serialize;
+	godata_klass->unserialize = go_data_vector_mapped_unserialize;
+	vector_klass->load_len    = go_data_vector_mapped_load_len;
+	vector_klass->load_values = go_data_vector_mapped_load_values;
+	vector_klass->get_value   = go_data_vector_mapped_get_value;
+	vector_klass->get_str     = go_data_vector_mapped_get_str;
+}
+
+GSF_CLASS (GODataVectorMapped, go_data_vector_mapped,
+	   go_data_vector_mapped_class_init, NULL,
+	   GO_TYPE_DATA_VECTOR)
+
+/**
+ * go_data_vector_mapped_new:
+ * @filename: the file to map.
+ * @err: #GError
+ *
+ * All values in the file make up the vector, which may be described by
+ * a header as a matrix of any shape.  The serialized form is @filename.
+ *
+ * Returns: (transfer full) (nullable): the newly created #GOData, or %NULL
+ * if the file could not be mapped.
+ **/
+GOData *
+go_data_vector_mapped_new (char const *filename, GError **err)
+{
+	GODataVectorMapped *res;
+	GODataMapping map = { NULL };
+
+	g_return_val_if_fail (filename != NULL, NULL);
+
+	if (!go_data_mapping_open (&map, filename, 0, 0, TRUE, err))
+		return NULL;
+
+	res = g_object_new (GO_TYPE_DATA_VECTOR_MAPPED, NULL);
+	res->map = map;
+	return GO_DATA (res);
+}
+
+/*****************************************************************************/
+
+struct _GODataMatrixMapped {
+	GODataMatrix	 base;
+	GODataMapping	 map;
+};
+typedef GODataMatrixClass GODataMatrixMappedClass;
+
+static GObjectClass *matrix_mapped_parent_klass;
+
+static void
+go_data_matrix_mapped_finalize (GObject *obj)
+{
+	GODataMatrixMapped *mat = (GODataMatrixMapped *)obj;
+	go_data_mapping_clear (&mat->map);
+	(*matrix_mapped_parent_klass->finalize) (obj);
+}
+
+static GOData *
+go_data_matrix_mapped_dup (GOData const *src)
+{
+	GODataMatrixMapped *dst = g_object_new (G_OBJECT_TYPE (src), NULL);
+	go_data_mapping_copy (&dst->map, &((GODataMatrixMapped const *)src)->map,
+			      FALSE);
+	return GO_DATA (dst);
+}
+
+static gboolean
+go_data_matrix_mapped_eq (GOData const *a, GOData const *b)
+{
+	return go_data_mapping_eq (&((GODataMatrixMapped const *)a)->map,
+				   &((GODataMatrixMapped const *)b)->map);
+}
+
+/* Dimensions that did not come from a header are kept as "RxC:".  */
+static char *
+go_data_matrix_mapped_serialize (GOData const *dat, gpointer user)
+{
+	GODataMapping const *map = &((GODataMatrixMapped const *)dat)->map;
+
+	if (map->req_rows > 0)
+		return g_strdup_printf ("%dx%d:%s", map->req_rows,
+					map->req_columns, map->filename);
+	return g_strdup (map->filename);
+}
+
+static gboolean
+go_data_matrix_mapped_unserialize (GOData *dat, char const *str, gpointer user)
+{
+	GODataMatrixMapped *mat = (GODataMatrixMapped *)dat;
+	GODataMapping map = { NULL };
+	int rows = 0, columns = 0;
+	char *end;
+
+	g_return_val_if_fail (str != NULL, FALSE);
+
+	if (g_ascii_isdigit (*str)) {
+		long r = strtol (str, &end, 10), c;
+		if (*end == 'x' && g_ascii_isdigit (end[1])) {
+			c = strtol (end + 1, &end, 10);
+			if (*end == ':' && r > 0 && r <= G_MAXINT &&
+			    c > 0 && c <= G_MAXINT) {
+				rows = r;
+				columns = c;
+				str = end + 1;
+			}
+		}
+	}
+
+	if (!go_data_mapping_open (&map, str, rows, columns, FALSE, NULL))
+		return FALSE;
+	go_data_mapping_clear (&mat->map);
+	mat->map = map;
+	go_data_emit_changed (dat);
+	return TRUE;
+}
+
+static void
+go_data_matrix_mapped_load_size (GODataMatrix *mat)
+{
+	GODataMapping const *map = &((GODataMatrixMapped *)mat)->map;
+	mat->base.flags |= GO_DATA_MATRIX_SIZE_CACHED;
+	mat->size.rows = map->rows;
+	mat->size.columns = map->columns;
+}
+
+static void
+go_data_matrix_mapped_load_values (GODataMatrix *mat)
+{
+	GODataMapping const *map = &((GODataMatrixMapped *)mat)->map;
+
+	mat->size.rows = map->rows;
+	mat->size.columns = map->columns;
+	mat->values = map->val;
+	mapped_bounds (map->val, (gsize)map->rows * map->columns,
+		       &mat->minimum, &mat->maximum);
+	mat->base.flags |= GO_DATA_CACHE_IS_VALID;
+}
+
+static double
+go_data_matrix_mapped_get_value (GODataMatrix *mat, unsigned i, unsigned j)
+{
+	GODataMapping const *map = &((GODataMatrixMapped *)mat)->map;
+	g_return_val_if_fail (i < (unsigned)map->rows &&
+			      j < (unsigned)map->columns, go_nan);
+	return map->val[(gsize)i * map->columns + j];
+}
+
+static char *
+go_data_matrix_mapped_get_str (GODataMatrix *mat, unsigned i, unsigned j)
+{
+	GODataMapping const *map = &((GODataMatrixMapped *)mat)->map;
+	g_return_val_if_fail (i < (unsigned)map->rows &&
+			      j < (unsigned)map->columns, NULL);
+	return render_val (map->val[(gsize)i * map->columns + j]);
+}
+
+static void
+go_data_matrix_mapped_class_init (GObjectClass *gobject_klass)
+{
+	GODataClass *godata_klass = (GODataClass *) gobject_klass;
+	GODataMatrixClass *matrix_klass = (GODataMatrixClass *) gobject_klass;
+
+	matrix_mapped_parent_klass = g_type_class_peek_parent (gobject_klass);
+	gobject_klass->finalize = go_data_matrix_mapped_finalize;
+	godata_klass->dup	= go_data_matrix_mapped_dup;
+	godata_klass->eq	= go_data_matrix_mapped_eq;
+	godata_klass->serialize	= go_data_matrix_mapped_serialize;
+	godata_klass->unserialize = go_data_matrix_mapped_unserialize;
+	matrix_klass->load_size   = go_data_matrix_mapped_load_size;
+	matrix_klass->load_values = go_data_matrix_mapped_load_values;
+	matrix_klass->get_value   = go_data_matrix_mapped_get_value;
+	matrix_klass->get_str     = go_data_matrix_mapped_get_str;
+}
+
+GSF_CLASS (GODataMatrixMapped, go_data_matrix_mapped,
+	   go_data_matrix_mapped_class_init, NULL,
+	   GO_TYPE_DATA_MATRIX)
+
+/**
+ * go_data_matrix_mapped_new:
+ * @filename: the file to map.
+ * @rows: the number of rows, or 0.
+ * @columns: the number of columns, or 0.
+ * @err: #GError
+ *
+ * If @rows and @columns are 0, the dimensions are taken from the file's
+ * header.  Otherwise they must match the header, if any.
+ *
+ * Returns: (transfer full) (nullable): the newly created #GOData, or %NULL
+ * if the file could not be mapped.
+ **/
+GOData *
+go_data_matrix_mapped_new (char const *filename, int rows, int columns,
+			   GError **err)
+{
+	GODataMatrixMapped *res;
+	GODataMapping map = { NULL };
+
+	g_return_val_if_fail (filename != NULL, NULL);
+	g_return_val_if_fail ((rows > 0) == (columns > 0), NULL);
+
+	if (!go_data_mapping_open (&map, filename, MAX (rows, 0),
+				   MAX (columns, 0), FALSE, err))
+		return NULL;
+
+	res = g_object_new (GO_TYPE_DATA_MATRIX_MAPPED, NULL);
+	res->map = map;
+	return GO_DATA (res);
+}
+
+/*****************************************************************************/
+
+/**
+ * go_data_mapped_refresh:
+ * @dat: #GODataVectorMapped or #GODataMatrixMapped
+ * @err: #GError
+ *
+ * Checks whether the file behind @dat changed size or modification time
+ * since it was mapped, and if so maps it again and emits 'changed'.
+ * Changes within the same second that keep the size are not noticed.
+ * If the file can no longer be mapped, the old map is kept.
+ *
+ * Returns: %TRUE if @dat changed.
+ **/
+gboolean
+go_data_mapped_refresh (GOData *dat, GError **err)
+{
+	GODataMapping *old, map = { NULL };
+	GStatBuf st;
+
+	if (GO_IS_DATA_VECTOR_MAPPED (dat))
+		old = &((GODataVectorMapped *)dat)->map;
+	else if (GO_IS_DATA_MATRIX_MAPPED (dat))
+		old = &((GODataMatrixMapped *)dat)->map;
+	else
+		g_return_val_if_reached (FALSE);
+
+	if (old->filename == NULL)
+		return FALSE;
+	if (g_stat (old->filename, &st) == 0 &&
+	    st.st_size == old->size && st.st_mtime == old->mtime)
+		return FALSE;
+
+	if (!go_data_mapping_open (&map, old->filename,
+				   old->req_rows, old->req_columns,
+				   GO_IS_DATA_VECTOR_MAPPED (dat), err))
+		return FALSE;
+
+	go_data_mapping_clear (old);
+	*old = map;
+	go_data_emit_changed (dat);
+	return TRUE;
+}
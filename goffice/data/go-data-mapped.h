@@ -0,0 +1,51 @@
+/*
+ * go-data-mapped.h :
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of the
+ * License, or (at your option) version 3.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301
+ * USA
+ */
+#ifndef GO_DATA_MAPPED_H
+#define GO_DATA_MAPPED_H
+
+#include <goffice/data/goffice-data.h>
+#include <goffice/data/go-data.h>
+
+G_BEGIN_DECLS
+
+#define GO_DATA_MAPPED_MAGIC "GODBL\x00\x00\x01"
+#define GO_DATA_MAPPED_HEADER_SIZE 16
+
+#define GO_TYPE_DATA_VECTOR_MAPPED  (go_data_vector_mapped_get_type ())
+#define GO_DATA_VECTOR_MAPPED(o)	 (G_TYPE_CHECK_INSTANCE_CAST ((o), GO_TYPE_DATA_VECTOR_MAPPED, GODataVectorMapped))
+#define GO_IS_DATA_VECTOR_MAPPED(o) (G_TYPE_CHECK_INSTANCE_TYPE ((o), GO_TYPE_DATA_VECTOR_MAPPED))
+
+typedef struct _GODataVectorMapped GODataVectorMapped;
+GType	 go_data_vector_mapped_get_type (void);
+GOData	*go_data_vector_mapped_new      (char const *filename, GError **err);
+
+#define GO_TYPE_DATA_MATRIX_MAPPED  (go_data_matrix_mapped_get_type ())
+#define GO_DATA_MATRIX_MAPPED(o)	 (G_TYPE_CHECK_INSTANCE_CAST ((o), GO_TYPE_DATA_MATRIX_MAPPED, GODataMatrixMapped))
+#define GO_IS_DATA_MATRIX_MAPPED(o) (G_TYPE_CHECK_INSTANCE_TYPE ((o), GO_TYPE_DATA_MATRIX_MAPPED))
+
+typedef struct _GODataMatrixMapped GODataMatrixMapped;
+GType	 go_data_matrix_mapped_get_type (void);
+GOData	*go_data_matrix_mapped_new      (char const *filename,
+					 int rows, int columns, GError **err);
+
+gboolean go_data_mapped_refresh (GOData *dat, GError **err);
+
+G_END_DECLS
+
+#endif /* GO_DATA_MAPPED_H */
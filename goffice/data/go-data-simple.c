@@ -24,6 +24,7 @@
 #include <goffice/utils/go-glib-extras.h>
 #include <goffice/utils/go-locale.h>
 #include <goffice/math/go-math.h>
+#include <goffice/math/go-dtoa.h>
 
 #include <gsf/gsf-impl-utils.h>
 #include <glib/gi18n-lib.h>
@@ -38,8 +39,8 @@ render_val (double val, GOFormat const *fmt)
 	if (fmt)
 		return go_format_value (fmt, val);
 	else {
-		char buf[G_ASCII_DTOSTR_BUF_SIZE];
-		g_ascii_dtostr (buf, G_ASCII_DTOSTR_BUF_SIZE, val);
+		char buf[GO_DTOA_SHORTEST_BUF_SIZE];
+		go_dtoa_shortest (val, buf);
 		return g_strdup (buf);
 	}
 }
@@ -99,7 +100,7 @@ go_data_scalar_val_unserialize (GOData *dat, char const *str, gpointer user)
 	double tmp;
 	char *end;
 	errno = 0; /* strto(ld) sets errno, but does not clear it.  */
-	tmp = g_ascii_strtod (str, &end);
+	tmp = go_ascii_strtod (str, &end);
 
 	if (end == str || *end != '\0' || errno == ERANGE)
 		return FALSE;
@@ -314,6 +315,7 @@ struct _GODataVectorVal {
 	unsigned	 n;
 	double *val;
 	GDestroyNotify notify;
+	unsigned	 alloc;	/* size of val when we own it */
 };
 typedef GODataVectorClass GODataVectorValClass;
 
@@ -340,6 +342,7 @@ go_data_vector_val_dup (GOData const *src)
 	} else
 		dst->val = src_val->val;
 	dst->n = src_val->n;
+	dst->alloc = dst->n;
 	return GO_DATA (dst);
 }
 
@@ -364,25 +367,20 @@ static void
 go_data_vector_val_load_values (GODataVector *vec)
 {
 	GODataVectorVal const *val = (GODataVectorVal const *)vec;
-	double minimum = DBL_MAX, maximum = -DBL_MAX;
-	int i = val->n;
 
 	vec->values = (double *)val->val;
-
-	while (i-- > 0) {
-		if (!go_finite (val->val[i]))
-			continue;
-		if (minimum > val->val[i])
-			minimum = val->val[i];
-		if (maximum < val->val[i])
-			maximum = val->val[i];
-	}
-	vec->minimum = minimum;
-	vec->maximum = maximum;
 	vec->len = val->n;
+	go_data_vector_compute_stats (vec);
 	vec->base.flags |= GO_DATA_CACHE_IS_VALID;
 }
 
+static void
+go_data_vector_val_load_values_range (GODataVector *vec, int first, int last)
+{
+	/* The values are not copied, so only the pointer can be stale.  */
+	vec->values = ((GODataVectorVal *)vec)->val;
+}
+
 static double
 go_data_vector_val_get_value (GODataVector *vec, unsigned i)
 {
@@ -406,20 +404,12 @@ static char *
 go_data_vector_val_serialize (GOData const *dat, gpointer user)
 {
 	GODataVectorVal *vec = GO_DATA_VECTOR_VAL (dat);
-	GOFormat const *fmt = NULL;
 	GString *str;
 	char sep;
-	unsigned i;
 
 	sep = go_locale_get_col_sep ();
 	str = g_string_new (NULL);
-
-	for (i = 0; i < vec->n; i++) {
-		char *s = render_val (vec->val[i], fmt);
-		if (i) g_string_append_c (str, sep);
-		g_string_append (str, s);
-		g_free (s);
-	}
+	go_dtoa_shortest_v (str, vec->val, vec->n, sep);
 	return g_string_free (str, FALSE);
 }
 
@@ -442,7 +432,7 @@ go_data_vector_val_unserialize (GOData *dat, char const *str, gpointer user)
 	vec->n = 0;
 	vec->notify = (GDestroyNotify) g_free;
 	while (1) {
-		val = g_ascii_strtod (end, &end);
+		val = go_ascii_strtod (end, &end);
 		g_array_append_val (values, val);
 		if (*end) {
 			if (!sep) {
@@ -464,6 +454,7 @@ go_data_vector_val_unserialize (GOData *dat, char const *str, gpointer user)
 		return TRUE;
 	}
 	vec->n = values->len;
+	vec->alloc = vec->n;
 	vec->val = (double*) values->data;
 	g_array_free (values, FALSE);
 	go_data_emit_changed (GO_DATA (vec));
@@ -486,6 +477,8 @@ go_data_vector_val_class_init (GObjectClass *gobject_klass)
 	vector_klass->load_values = go_data_vector_val_load_values;
 	vector_klass->get_value   = go_data_vector_val_get_value;
 	vector_klass->get_str     = go_data_vector_val_get_str;
+	go_data_vector_class_set_load_values_range
+		(vector_klass, go_data_vector_val_load_values_range);
 }
 
 GSF_CLASS (GODataVectorVal, go_data_vector_val,
@@ -507,6 +500,7 @@ go_data_vector_val_new (double *val, unsigned n, GDestroyNotify notify)
 	res->val = val;
 	res->n = n;
 	res->notify = notify;
+	res->alloc = res->n;
 	return GO_DATA (res);
 }
 
@@ -524,9 +518,53 @@ go_data_vector_val_new_copy (double *val, unsigned n)
 	res->val = go_memdup_n (val, n, sizeof (double));
 	res->n = n;
 	res->notify = g_free;
+	res->alloc = n;
 	return GO_DATA (res);
 }
 
+/**
+ * go_data_vector_val_append:
+ * @vec: #GODataVectorVal
+ * @val: (array length=n): the values to append.
+ * @n: the number of values.
+ *
+ * Appends @n values to @vec, which first takes a copy of its values if
+ * it does not own them.  Listeners are told through
+ * go_data_vector_emit_changed_range(), so cached bounds are updated by
+ * looking at the new values only.
+ **/
+void
+go_data_vector_val_append (GODataVectorVal *vec, double const *val, unsigned n)
+{
+	unsigned old_n;
+
+	g_return_if_fail (GO_IS_DATA_VECTOR_VAL (vec));
+	g_return_if_fail (val != NULL || n == 0);
+
+	if (n == 0)
+		return;
+
+	old_n = vec->n;
+	if (vec->notify != (GDestroyNotify) g_free) {
+		double *copy = g_new (double, old_n + n);
+		if (old_n > 0)
+			memcpy (copy, vec->val, old_n * sizeof (double));
+		if (vec->notify && vec->val)
+			(*vec->notify) (vec->val);
+		vec->val = copy;
+		vec->notify = (GDestroyNotify) g_free;
+		vec->alloc = old_n + n;
+	} else if (old_n + n > vec->alloc) {
+		/* Grow geometrically so repeated appends are cheap.  */
+		vec->alloc = MAX (old_n + n, 2 * vec->alloc);
+		vec->val = g_renew (double, vec->val, vec->alloc);
+	}
+
+	memcpy (vec->val + old_n, val, n * sizeof (double));
+	vec->n = old_n + n;
+	go_data_vector_emit_changed_range (GO_DATA_VECTOR (vec), old_n, vec->n);
+}
+
 /*****************************************************************************/
 
 struct _GODataVectorStr {
@@ -992,22 +1030,16 @@ static char *
 go_data_matrix_val_serialize (GOData const *dat, gpointer user)
 {
 	GODataMatrixVal *mat = GO_DATA_MATRIX_VAL (dat);
-	GOFormat const *fmt = NULL;
 	GString *str;
-	int c, r;
+	int r;
 	char col_sep = go_locale_get_col_sep ();
 	char row_sep = go_locale_get_row_sep ();
 
 	str = g_string_new (NULL);
 	for (r = 0; r < mat->size.rows; r++) {
 		if (r) g_string_append_c (str, row_sep);
-		for (c = 0; c < mat->size.columns; c++) {
-			double val = mat->val[r * mat->size.columns + c];
-			char *s = render_val (val, fmt);
-			if (c) g_string_append_c (str, col_sep);
-			g_string_append (str, s);
-			g_free (s);
-		}
+		go_dtoa_shortest_v (str, mat->val + r * mat->size.columns,
+				    mat->size.columns, col_sep);
 	}
 
 	return g_string_free (str, FALSE);
@@ -1035,7 +1067,7 @@ go_data_matrix_val_unserialize (GOData *dat, char const *str, gpointer user)
 	mat->size.columns = 0;
 	mat->notify = g_free;
 	while (1) {
-		val = g_ascii_strtod (end, &end);
+		val = go_ascii_strtod (end, &end);
 		g_array_append_val (values, val);
 		if (*end) {
 			if (*end == col_sep)
@@ -1110,3 +1142,153 @@ go_data_matrix_val_new (double *val, unsigned rows, unsigned columns, GDestroyNo
 	res->notify = notify;
 	return GO_DATA (res);
 }
+
+/*****************************************************************************/
+
+/* Values in files are little-endian.  */
+static void
+copy_le_doubles (void *dst, void const *src, gsize n)
+{
+#if G_BYTE_ORDER == G_LITTLE_ENDIAN
+	memcpy (dst, src, n * sizeof (double));
+#else
+	gsize i;
+	for (i = 0; i < n; i++) {
+		guint64 u;
+		memcpy (&u, (char const *)src + i * sizeof (u), sizeof (u));
+		u = GUINT64_SWAP_LE_BE (u);
+		memcpy ((char *)dst + i * sizeof (u), &u, sizeof (u));
+	}
+#endif
+}
+
+/**
+ * go_data_serialize_base64:
+ * @dat: #GOData
+ *
+ * Serializes the values of a #GODataVectorVal or #GODataMatrixVal
+ * exactly, as base64-encoded little-endian doubles.  For a matrix, they
+ * are preceded by the numbers of rows and columns as little-endian 32-bit
+ * integers.  For large data, this is a lot faster to write and read than
+ * the text from go_data_serialize().
+ *
+ * Returns: (transfer full) (nullable): the serialized values, or %NULL if
+ * @dat has no such form.
+ **/
+char *
+go_data_serialize_base64 (GOData const *dat)
+{
+	double const *val;
+	gsize n, skip = 0;
+	guint8 *buf;
+	char *res;
+
+	if (GO_IS_DATA_VECTOR_VAL (dat)) {
+		GODataVectorVal const *vec = (GODataVectorVal const *)dat;
+		val = vec->val;
+		n = vec->n;
+	} else if (GO_IS_DATA_MATRIX_VAL (dat)) {
+		GODataMatrixVal const *mat = (GODataMatrixVal const *)dat;
+		val = mat->val;
+		n = (gsize)mat->size.rows * mat->size.columns;
+		skip = 2 * sizeof (guint32);
+	} else
+		return NULL;
+
+#if G_BYTE_ORDER == G_LITTLE_ENDIAN
+	if (skip == 0)
+		return g_base64_encode ((guchar const *)val, n * sizeof (double));
+#endif
+
+	buf = g_new (guint8, skip + n * sizeof (double));
+	if (skip) {
+		GODataMatrixVal const *mat = (GODataMatrixVal const *)dat;
+		guint32 r = GUINT32_TO_LE (mat->size.rows);
+		guint32 c = GUINT32_TO_LE (mat->size.columns);
+		memcpy (buf, &r, sizeof (r));
+		memcpy (buf + sizeof (r), &c, sizeof (c));
+	}
+	copy_le_doubles (buf + skip, val, n);
+	res = g_base64_encode (buf, skip + n * sizeof (double));
+	g_free (buf);
+	return res;
+}
+
+/**
+ * go_data_unserialize_base64:
+ * @dat: #GODataVectorVal or #GODataMatrixVal
+ * @str: values serialized by go_data_serialize_base64()
+ *
+ * Replaces the values in @dat by those in @str.
+ *
+ * Returns: %TRUE on success.
+ **/
+gboolean
+go_data_unserialize_base64 (GOData *dat, char const *str)
+{
+	guchar *buf;
+	gsize len, n, skip;
+	double *val;
+	guint32 r = 0, c = 0;
+
+	g_return_val_if_fail (str != NULL, FALSE);
+
+	if (GO_IS_DATA_VECTOR_VAL (dat))
+		skip = 0;
+	else if (GO_IS_DATA_MATRIX_VAL (dat))
+		skip = 2 * sizeof (guint32);
+	else
+		return FALSE;
+
+	buf = g_base64_decode (str, &len);
+	if (len < skip || (len - skip) % sizeof (double) != 0) {
+		g_free (buf);
+		return FALSE;
+	}
+	n = (len - skip) / sizeof (double);
+	if (skip) {
+		memcpy (&r, buf, sizeof (r));
+		memcpy (&c, buf + sizeof (r), sizeof (c));
+		r = GUINT32_FROM_LE (r);
+		c = GUINT32_FROM_LE (c);
+		if (r > G_MAXINT || c > G_MAXINT || (guint64)r * c != n) {
+			g_free (buf);
+			return FALSE;
+		}
+	}
+	if (n > G_MAXINT) {
+		g_free (buf);
+		return FALSE;
+	}
+
+#if G_BYTE_ORDER == G_LITTLE_ENDIAN
+	if (skip == 0)
+		/* g_malloc'ed memory is aligned for doubles.  */
+		val = (double *)buf;
+	else
+#endif
+	{
+		val = g_new (double, n);
+		copy_le_doubles (val, buf + skip, n);
+		g_free (buf);
+	}
+
+	if (skip == 0) {
+		GODataVectorVal *vec = (GODataVectorVal *)dat;
+		if (vec->notify && vec->val)
+			(*vec->notify) (vec->val);
+		vec->val = val;
+		vec->n = vec->alloc = n;
+		vec->notify = g_free;
+	} else {
+		GODataMatrixVal *mat = (GODataMatrixVal *)dat;
+		if (mat->notify && mat->val)
+			(*mat->notify) (mat->val);
+		mat->val = val;
+		mat->size.rows = r;
+		mat->size.columns = c;
+		mat->notify = g_free;
+	}
+	go_data_emit_changed (dat);
+	return TRUE;
+}
@@ -53,6 +53,8 @@ typedef struct _GODataVectorVal GODataVectorVal;
 GType	 go_data_vector_val_get_type (void);
 GOData	*go_data_vector_val_new      (double *val, unsigned n, GDestroyNotify   notify);
 GOData  *go_data_vector_val_new_copy (double *val, unsigned n);
+void	 go_data_vector_val_append   (GODataVectorVal *vec,
+				      double const *val, unsigned n);
 #define GO_TYPE_DATA_VECTOR_STR  (go_data_vector_str_get_type ())
 #define GO_DATA_VECTOR_STR(o)	 (G_TYPE_CHECK_INSTANCE_CAST ((o), GO_TYPE_DATA_VECTOR_STR, GODataVectorStr))
 #define GO_IS_DATA_VECTOR_STR(o) (G_TYPE_CHECK_INSTANCE_TYPE ((o), GO_TYPE_DATA_VECTOR_STR))
@@ -76,6 +78,9 @@ typedef struct _GODataMatrixVal GODataMatrixVal;
 GType	 go_data_matrix_val_get_type (void);
 GOData	*go_data_matrix_val_new      (double *val, unsigned rows, unsigned columns, GDestroyNotify   notify);
 
+char	*go_data_serialize_base64   (GOData const *dat);
+gboolean go_data_unserialize_base64 (GOData *dat, char const *str);
+
 G_END_DECLS
 
 #endif /* GO_DATA_SIMPLE_H */
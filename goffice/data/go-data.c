@@ -24,10 +24,12 @@
 #include "go-data-impl.h"
 #include <goffice/math/go-math.h>
 #include <goffice/math/go-rangefunc.h>
+#include <goffice/utils/go-marshalers.h>
 
 #include <gsf/gsf-impl-utils.h>
 #include <glib/gi18n-lib.h>
 #include <string.h>
+#include <float.h>
 
 /**
  * GODataFlags:
@@ -35,6 +37,7 @@
  * @GO_DATA_IS_EDITABLE: data can be edited.
  * @GO_DATA_SIZE_CACHED: cached size is valid.
  * @GO_DATA_HAS_VALUE: object is not empty.
+ * @GO_DATA_STATS_CACHED: cached statistics are valid.
  **/
 
 /**
@@ -325,6 +328,19 @@ go_data_check_variation (GOData *data, GODataVariationCheck check)
 
 	g_return_val_if_fail (GO_IS_DATA (data), FALSE);
 
+	if (GO_IS_DATA_VECTOR (data)) {
+		GODataVectorStats const *st =
+			go_data_vector_get_stats (GO_DATA_VECTOR (data));
+		switch (check) {
+		case GO_DATA_VARIATION_CHECK_UNIFORMLY:
+			return st->increasing || st->decreasing;
+		case GO_DATA_VARIATION_CHECK_INCREASING:
+			return st->increasing;
+		default:
+			return st->decreasing;
+		}
+	}
+
 	values = go_data_get_values (data);
 	if (values == NULL)
 		return FALSE;
@@ -894,10 +910,27 @@ go_data_scalar_get_markup (GODataScalar *scalar)
 #define GO_IS_DATA_VECTOR_CLASS(k)	(G_TYPE_CHECK_CLASS_TYPE ((k), GO_TYPE_DATA_VECTOR))
 #define GO_DATA_VECTOR_GET_CLASS(o)	(G_TYPE_INSTANCE_GET_CLASS ((o), GO_TYPE_DATA_VECTOR, GODataVectorClass))
 
+enum {
+	CHANGED_RANGE,
+	VECTOR_LAST_SIGNAL
+};
+
+static gulong go_data_vector_signals [VECTOR_LAST_SIGNAL] = { 0, };
+
+static GQuark load_values_range_quark;
+
+/* Kept out of GODataVector so that its size does not change.  */
+typedef struct {
+	GODataVectorStats stats; /* valid with GO_DATA_VECTOR_STATS_CACHED */
+} GODataVectorPrivate;
+
+#define GO_DATA_VECTOR_GET_PRIVATE(o) (G_TYPE_INSTANCE_GET_PRIVATE ((o), GO_TYPE_DATA_VECTOR, GODataVectorPrivate))
+
 static void
 _data_vector_emit_changed (GOData *data)
 {
-	data->flags &= ~(GO_DATA_CACHE_IS_VALID | GO_DATA_VECTOR_LEN_CACHED | GO_DATA_HAS_VALUE);
+	data->flags &= ~(GO_DATA_CACHE_IS_VALID | GO_DATA_VECTOR_LEN_CACHED |
+			 GO_DATA_HAS_VALUE | GO_DATA_VECTOR_STATS_CACHED);
 }
 
 static unsigned int
@@ -947,6 +980,27 @@ _data_vector_get_markup (GOData *data, unsigned int *coordinates)
 static void
 go_data_vector_class_init (GODataClass *data_class)
 {
+	/**
+	 * GODataVector::changed-range:
+	 * @vec: the vector
+	 * @first: first changed index
+	 * @last: one past the last changed index
+	 *
+	 * Emitted by go_data_vector_emit_changed_range() just before
+	 * #GOData::changed for listeners that can use the range.
+	 **/
+	go_data_vector_signals [CHANGED_RANGE] = g_signal_new ("changed-range",
+		G_TYPE_FROM_CLASS (data_class),
+		G_SIGNAL_RUN_LAST,
+		0,
+		NULL, NULL,
+		go__VOID__INT_INT,
+		G_TYPE_NONE, 2, G_TYPE_INT, G_TYPE_INT);
+
+	g_type_class_add_private (data_class, sizeof (GODataVectorPrivate));
+	load_values_range_quark =
+		g_quark_from_static_string ("go-data-vector-load-values-range");
+
 	data_class->emit_changed = 	_data_vector_emit_changed;
 	data_class->get_n_dimensions = 	_data_vector_get_n_dimensions;
 	data_class->get_sizes =		_data_vector_get_sizes;
@@ -1004,6 +1058,7 @@ go_data_vector_get_values (GODataVector *vec)
 
 		g_return_val_if_fail (klass != NULL, NULL);
 
+		vec->base.flags &= ~GO_DATA_VECTOR_STATS_CACHED;
 		(*klass->load_values) (vec);
 
 		{
@@ -1104,6 +1159,7 @@ go_data_vector_get_minmax (GODataVector *vec, double *min, double *max)
 
 		g_return_if_fail (klass != NULL);
 
+		vec->base.flags &= ~GO_DATA_VECTOR_STATS_CACHED;
 		(*klass->load_values) (vec);
 
 		g_return_if_fail (vec->base.flags & GO_DATA_CACHE_IS_VALID);
@@ -1115,6 +1171,158 @@ go_data_vector_get_minmax (GODataVector *vec, double *min, double *max)
 		*max = vec->maximum;
 }
 
+#define STATS_LANES 4
+
+/*
+ * One pass over the values for everything in GODataVectorStats as well as
+ * the finite bounds.  The loop keeps STATS_LANES independent accumulators
+ * and only does selects and compares in them: compilers will not vectorize
+ * a plain floating-point min/max reduction without -ffast-math, but they
+ * do vectorize this.  The counts are doubles to keep every lane the same
+ * width.
+ *
+ * NaNs fail all comparisons, so they spoil the monotonicity counts.  In
+ * that uncommon case the monotonicity is redone the slow way.
+ */
+static void
+vector_scan (double const *xs, int n, GODataVectorStats *st,
+	     double *minimum, double *maximum)
+{
+	double mn[STATS_LANES], mx[STATS_LANES];
+	double nfin[STATS_LANES], nnan[STATS_LANES];
+	double ninc[STATS_LANES], ndec[STATS_LANES], nodd[STATS_LANES];
+	double min = DBL_MAX, max = -DBL_MAX, d = 0, tol = 0;
+	double n_finite = 0, n_missing = 0, n_inc = 0, n_dec = 0, n_odd = 0;
+	int i, k;
+
+	if (n > 1) {
+		d = xs[1] - xs[0];
+		tol = 16 * DBL_EPSILON * MAX (fabs (xs[0]), fabs (xs[n - 1]));
+	}
+
+	for (k = 0; k < STATS_LANES; k++) {
+		mn[k] = DBL_MAX;
+		mx[k] = -DBL_MAX;
+		nfin[k] = nnan[k] = ninc[k] = ndec[k] = nodd[k] = 0;
+	}
+
+	// Each step looks at xs[i] and its predecessor; xs[0] is done below.
+	for (i = 1; i + STATS_LANES <= n; i += STATS_LANES) {
+		for (k = 0; k < STATS_LANES; k++) {
+			double a = xs[i + k - 1], x = xs[i + k];
+			gboolean fin = fabs (x) <= DBL_MAX;
+			double xl = fin ? x : DBL_MAX;
+			double xh = fin ? x : -DBL_MAX;
+			mn[k] = xl < mn[k] ? xl : mn[k];
+			mx[k] = xh > mx[k] ? xh : mx[k];
+			nfin[k] += fin ? 1 : 0;
+			nnan[k] += x != x ? 1 : 0;
+			ninc[k] += a < x ? 1 : 0;
+			ndec[k] += a > x ? 1 : 0;
+			nodd[k] += fabs (x - a - d) <= tol ? 0 : 1;
+		}
+	}
+
+	for (k = 0; k < STATS_LANES; k++) {
+		min = mn[k] < min ? mn[k] : min;
+		max = mx[k] > max ? mx[k] : max;
+		n_finite += nfin[k];
+		n_missing += nnan[k];
+		n_inc += ninc[k];
+		n_dec += ndec[k];
+		n_odd += nodd[k];
+	}
+
+	// The tail, then the first value.
+	for (; i <= n; i++) {
+		int j = (i < n) ? i : 0;
+		double x = xs[j];
+		if (go_finite (x)) {
+			n_finite++;
+			min = MIN (min, x);
+			max = MAX (max, x);
+		} else if (isnan (x))
+			n_missing++;
+		if (j > 0) {
+			double a = xs[j - 1];
+			n_inc += a < x;
+			n_dec += a > x;
+			n_odd += !(fabs (x - a - d) <= tol);
+		}
+	}
+
+	st->n_finite = n_finite;
+	st->n_missing = n_missing;
+	st->first_missing = -1;
+	if (n_missing > 0) {
+		for (i = 0; !isnan (xs[i]); i++)
+			;
+		st->first_missing = i;
+		st->increasing = go_range_increasing (xs, n);
+		st->decreasing = go_range_decreasing (xs, n);
+	} else {
+		st->increasing = n > 0 && n_inc == n - 1;
+		st->decreasing = n > 0 && n_dec == n - 1;
+	}
+	st->evenly_spaced = n > 1 && n_odd == 0 && n_finite == n &&
+		(st->increasing || st->decreasing);
+	st->step = st->evenly_spaced ? d : 0;
+
+	if (minimum)
+		*minimum = min;
+	if (maximum)
+		*maximum = max;
+}
+
+#undef STATS_LANES
+
+/**
+ * go_data_vector_compute_stats:
+ * @vec: #GODataVector
+ *
+ * protected utility for load_values implementations.  Computes the bounds
+ * and the statistics returned by go_data_vector_get_stats from the cached
+ * values in a single pass.
+ **/
+void
+go_data_vector_compute_stats (GODataVector *vec)
+{
+	g_return_if_fail (GO_IS_DATA_VECTOR (vec));
+
+	vector_scan (vec->values, vec->values ? vec->len : 0,
+		     &GO_DATA_VECTOR_GET_PRIVATE (vec)->stats,
+		     &vec->minimum, &vec->maximum);
+	vec->base.flags |= GO_DATA_VECTOR_STATS_CACHED;
+}
+
+/**
+ * go_data_vector_get_stats:
+ * @vec: #GODataVector
+ *
+ * The statistics are computed in one pass over the values when first
+ * asked for and are kept until the values change.
+ *
+ * Returns: (transfer none): statistics on the values of @vec.
+ **/
+GODataVectorStats const *
+go_data_vector_get_stats (GODataVector *vec)
+{
+	GODataVectorPrivate *priv;
+	double const *values;
+
+	g_return_val_if_fail (GO_IS_DATA_VECTOR (vec), NULL);
+
+	priv = GO_DATA_VECTOR_GET_PRIVATE (vec);
+	values = go_data_vector_get_values (vec);
+	if (!(vec->base.flags & GO_DATA_VECTOR_STATS_CACHED)) {
+		vector_scan (values, values ? vec->len : 0, &priv->stats,
+			     NULL, NULL);
+		vec->base.flags |= GO_DATA_VECTOR_STATS_CACHED;
+	}
+
+	return &priv->stats;
+}
+
 /**
  * go_data_vector_increasing:
  * @vec: #GODataVector
@@ -1124,9 +1332,7 @@ go_data_vector_get_minmax (GODataVector *vec, double *min, double *max)
 gboolean
 go_data_vector_increasing (GODataVector *vec)
 {
-	double *data = go_data_vector_get_values (vec);
-	int length = go_data_vector_get_len (vec);
-	return go_range_increasing (data, length);
+	return go_data_vector_get_stats (vec)->increasing;
 }
 
 /**
@@ -1138,9 +1344,7 @@ go_data_vector_increasing (GODataVector *vec)
 gboolean
 go_data_vector_decreasing (GODataVector *vec)
 {
-	double *data = go_data_vector_get_values (vec);
-	int length = go_data_vector_get_len (vec);
-	return go_range_decreasing (data, length);
+	return go_data_vector_get_stats (vec)->decreasing;
 }
 
 /**
@@ -1152,9 +1356,137 @@ go_data_vector_decreasing (GODataVector *vec)
 gboolean
 go_data_vector_vary_uniformly (GODataVector *vec)
 {
-	double *data = go_data_vector_get_values (vec);
-	int length = go_data_vector_get_len (vec);
-	return go_range_vary_uniformly (data, length);
+	GODataVectorStats const *st = go_data_vector_get_stats (vec);
+	return st->increasing || st->decreasing;
+}
+
+/**
+ * go_data_vector_class_set_load_values_range: (skip)
+ * @klass: #GODataVectorClass
+ * @load_values_range: reloads the cached values with indices in a range.
+ *
+ * protected utility for class_init implementations.  Registers the hook
+ * used by go_data_vector_emit_changed_range().  It must reload the cached
+ * values in [first,last) and keep the others, but the values array may
+ * need to grow.  Derived classes inherit the hook.
+ *
+ * This is not a member of #GODataVectorClass so that the size of the class
+ * does not change.
+ **/
+void
+go_data_vector_class_set_load_values_range (GODataVectorClass *klass,
+					    void (*load_values_range) (GODataVector *vec, int first, int last))
+{
+	g_return_if_fail (GO_IS_DATA_VECTOR_CLASS (klass));
+
+	g_type_set_qdata (G_TYPE_FROM_CLASS (klass), load_values_range_quark,
+			  (gpointer) load_values_range);
+}
+
+static gpointer
+go_data_vector_get_load_values_range (GODataVector *vec)
+{
+	GType t;
+
+	for (t = G_OBJECT_TYPE (vec); t != GO_TYPE_DATA_VECTOR;
+	     t = g_type_parent (t)) {
+		gpointer f = g_type_get_qdata (t, load_values_range_quark);
+		if (f != NULL)
+			return f;
+	}
+	return NULL;
+}
+
+/**
+ * go_data_vector_emit_changed_range:
+ * @vec: #GODataVector
+ * @first: first changed index
+ * @last: one past the last changed index
+ *
+ * protected utility to signal that only the values in [@first,@last)
+ * changed.  Appended values are reported with @first being the old
+ * length and @last the new one.
+ *
+ * If the values are cached and the class registered a hook with
+ * go_data_vector_class_set_load_values_range(), only the values in the
+ * range are reloaded.  Appended values then just
+ * extend the cached bounds; other changes rescan the cache for them.
+ * Otherwise, and when the vector got shorter, this invalidates the whole
+ * cache just like go_data_emit_changed().
+ *
+ * Either way, 'changed-range' and then 'changed' are emitted.
+ **/
+void
+go_data_vector_emit_changed_range (GODataVector *vec, int first, int last)
+{
+	GODataVectorClass const *klass = GO_DATA_VECTOR_GET_CLASS (vec);
+	GOData *data = GO_DATA (vec);
+	void (*load_values_range) (GODataVector *vec, int first, int last);
+	int old_len = vec->len;
+	gboolean patched = FALSE;
+
+	g_return_if_fail (klass != NULL);
+	g_return_if_fail (0 <= first && first <= last);
+
+	load_values_range = go_data_vector_get_load_values_range (vec);
+	if (load_values_range != NULL &&
+	    (data->flags & GO_DATA_CACHE_IS_VALID)) {
+		data->flags &= ~GO_DATA_VECTOR_LEN_CACHED;
+		(*klass->load_len) (vec);
+		/* New values must all be in the range.  */
+		patched = (data->flags & GO_DATA_VECTOR_LEN_CACHED) &&
+			(data->flags & GO_DATA_CACHE_IS_VALID) &&
+			vec->len >= old_len && last <= vec->len &&
+			(vec->len == old_len ||
+			 (first <= old_len && last == vec->len));
+	}
+
+	if (patched) {
+		double min = vec->minimum, max = vec->maximum;
+		double const *values;
+		int i, from = first, to = last;
+
+		data->flags &= ~GO_DATA_VECTOR_STATS_CACHED;
+		(*load_values_range) (vec, first, last);
+		values = vec->values;
+
+		if (first < old_len) {
+			/* The old values may have been the extremes.  */
+			from = 0;
+			to = vec->len;
+			min = DBL_MAX;
+			max = -DBL_MAX;
+		} else if (!(min <= max)) {
+			/* No valid values so far, maybe marked by NaNs.  */
+			min = DBL_MAX;
+			max = -DBL_MAX;
+		}
+
+		for (i = from; i < to; i++) {
+			double x = values[i];
+			if (!go_finite (x))
+				continue;
+			if (x < min)
+				min = x;
+			if (x > max)
+				max = x;
+		}
+
+		vec->minimum = min;
+		vec->maximum = max;
+		if (go_finite (min) && go_finite (max) && min <= max)
+			data->flags |= GO_DATA_HAS_VALUE;
+		else
+			data->flags &= ~GO_DATA_HAS_VALUE;
+	} else {
+		GODataClass const *data_klass = GO_DATA_GET_CLASS (data);
+		if (data_klass->emit_changed)
+			(*data_klass->emit_changed) (data);
+	}
+
+	g_signal_emit (G_OBJECT (vec), go_data_vector_signals [CHANGED_RANGE],
+		       0, first, last);
+	g_signal_emit (G_OBJECT (vec), go_data_signals [CHANGED], 0);
 }
 
 /*************************************************************************/
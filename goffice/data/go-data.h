@@ -97,6 +97,10 @@ void	 go_data_vector_get_minmax (GODataVector *vec, double *min, double *max);
 gboolean go_data_vector_increasing (GODataVector *vec);
 gboolean go_data_vector_decreasing (GODataVector *vec);
 gboolean go_data_vector_vary_uniformly (GODataVector *vec);
+GODataVectorStats const *go_data_vector_get_stats (GODataVector *vec);
+void	 go_data_vector_compute_stats (GODataVector *vec);
+void	 go_data_vector_emit_changed_range (GODataVector *vec,
+					    int first, int last);
 
 /*************************************************************************/
 
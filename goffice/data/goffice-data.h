@@ -35,11 +35,21 @@ typedef struct {
 	int rows;	/* negative if dirty, includes missing values */
 	int columns;	/* negative if dirty, includes missing values */
 } GODataMatrixSize;
+typedef struct {
+	int n_finite;		/* finite values */
+	int n_missing;		/* NaN values */
+	int first_missing;	/* index of the first NaN, -1 if none */
+	gboolean increasing;	/* as go_range_increasing */
+	gboolean decreasing;	/* as go_range_decreasing */
+	gboolean evenly_spaced;	/* all finite and a constant step */
+	double step;		/* the step when evenly spaced, 0 otherwise */
+} GODataVectorStats;
 
 G_END_DECLS
 
 #include <goffice/data/go-data.h>
 #include <goffice/data/go-data-impl.h>
 #include <goffice/data/go-data-simple.h>
+#include <goffice/data/go-data-mapped.h>
 
 #endif /* GOFFICE_DATA_H */
@@ -23,6 +23,7 @@
 #undef DOUBLE_EPSILON
 #undef DOUBLE_DIG
 #undef DOUBLE_MIN
+#undef DOUBLE_MAX
 #undef DOUBLE_RADIX
 #undef DOUBLE_ISNAN
 #undef STRTO
@@ -49,6 +50,7 @@
   #define DOUBLE_EPSILON DBL_EPSILON
   #define DOUBLE_DIG DBL_DIG
   #define DOUBLE_MIN DBL_MIN
+  #define DOUBLE_MAX DBL_MAX
   #define DOUBLE_RADIX FLT_RADIX
   // Not SUFFIX(isnan): that pastes to isnanl, a glibc extension.  C99's
   // isnan() covers float, double and long double alike; only _Decimal64
@@ -79,6 +81,7 @@
   #define DOUBLE_EPSILON LDBL_EPSILON
   #define DOUBLE_DIG LDBL_DIG
   #define DOUBLE_MIN LDBL_MIN
+  #define DOUBLE_MAX LDBL_MAX
   #define DOUBLE_RADIX FLT_RADIX
   #define DOUBLE_ISNAN(_x) isnan (_x)
   #define STRTO go_strtold
@@ -106,6 +109,7 @@
   #define DOUBLE_EPSILON DECIMAL64_EPSILON
   #define DOUBLE_DIG 16
   #define DOUBLE_MIN DECIMAL64_MIN
+  #define DOUBLE_MAX DECIMAL64_MAX
   #define DOUBLE_RADIX 10
   #define DOUBLE_ISNAN(_x) isnanD (_x)
   #define STRTO go_strtoDd
@@ -283,6 +283,7 @@ libgoffice_shutdown (void)
 	_go_locale_shutdown ();
 	_go_rsm_shutdown ();
 	_go_unit_shutdown ();
+	_go_fft_shutdown ();
 #ifdef G_OS_WIN32
 	/* const_cast, we created these above */
 	g_free ((char *)libgoffice_data_dir);
@@ -353,6 +353,69 @@ make_path_spline (GogChartMap *map,
 	return path;
 }
 
+/*
+ * What make_path_cspline needs, kept on the chart so that redrawing its
+ * spline series and curves refits the same spline in the same buffers
+ * instead of allocating new ones.  Charts are drawn by one thread at a
+ * time.
+ */
+typedef struct {
+	GOCSplineWorkspace *ws;
+	GOCSpline *spline;
+	double *uu, *vv;
+	int size;
+} GogChartMapCSplineCache;
+
+#define CSPLINE_CACHE_KEY "gog-chart-map-cspline-cache"
+
+static void
+cspline_cache_free (GogChartMapCSplineCache *cache)
+{
+	if (cache->spline)
+		go_cspline_destroy (cache->spline);
+	go_cspline_workspace_free (cache->ws);
+	g_free (cache->uu);
+	g_free (cache->vv);
+	g_free (cache);
+}
+
+static GogChartMapCSplineCache *
+cspline_cache_get (GogChartMap *map, int n_points)
+{
+	GogChartMapCSplineCache *cache = map->chart
+		? g_object_get_data (G_OBJECT (map->chart), CSPLINE_CACHE_KEY)
+		: NULL;
+
+	if (cache == NULL) {
+		cache = g_new0 (GogChartMapCSplineCache, 1);
+		cache->ws = go_cspline_workspace_new ();
+		if (map->chart)
+			g_object_set_data_full (G_OBJECT (map->chart),
+						CSPLINE_CACHE_KEY, cache,
+						(GDestroyNotify) cspline_cache_free);
+	}
+	if (cache->size < n_points) {
+		cache->size = n_points;
+		cache->uu = g_renew (double, cache->uu, n_points);
+		cache->vv = g_renew (double, cache->vv, n_points);
+	}
+	return cache;
+}
+
+/* Fit the cached spline to one run of valid points.  */
+static gboolean
+fit_cspline (GogChartMapCSplineCache *cache, int n,
+	     GOCSplineType type, double p0, double p1)
+{
+	if (cache->spline == NULL) {
+		cache->spline = go_cspline_init (cache->uu, cache->vv, n,
+						 type, p0, p1);
+		return cache->spline != NULL;
+	}
+	return go_cspline_refit (cache->spline, cache->uu, cache->vv, n,
+				 type, p0, p1, cache->ws);
+}
+
 static GOPath *
 make_path_cspline (GogChartMap *map,
 		  double const *x, double const *y, int n_points,
@@ -364,13 +427,15 @@ make_path_cspline (GogChartMap *map,
 	double *uu, *vv, u, v;
 	double p0 = 0., p1 = 0.; /* clamped derivatives */
 	GOCSpline *spline;
+	GogChartMapCSplineCache *cache;
 
 	path = go_path_new ();
 	if (n_points < 1 || (x && !go_range_vary_uniformly (x, n_points)))
 		return path;
 
-	uu = g_new (double, n_points);
-	vv = g_new (double, n_points);
+	cache = cspline_cache_get (map, n_points);
+	uu = cache->uu;
+	vv = cache->vv;
 	n_valid_points = 0;
 
 	for (i = 0; i < n_points; i++) {
@@ -393,9 +458,9 @@ make_path_cspline (GogChartMap *map,
 			} else if (n_valid_points > 2) {
 				int j;
 				/* evaluate the spline */
-				spline = go_cspline_init (uu, vv, n_valid_points, type, p0, p1);
-				if (spline) {
+				if (fit_cspline (cache, n_valid_points, type, p0, p1)) {
 					double x0, x1, x2, x3, y0, y1, y2, y3;
+					spline = cache->spline;
 					x0 = uu[0];
 					y0 = vv[0];
 					go_path_move_to (path, x0, y0);
@@ -411,7 +476,6 @@ make_path_cspline (GogChartMap *map,
 						x0 = x3;
 						y0 = y3;
 					}
-					go_cspline_destroy (spline);
 				}
 			}
 			n_valid_points = 0;
@@ -426,9 +490,9 @@ make_path_cspline (GogChartMap *map,
 			p1 = gog_chart_map_2D_derivative_to_view (map, ((double*) data)[1],
 								  uu[n_valid_points - 1], vv[n_valid_points - 1]);
 		}
-		spline = go_cspline_init (uu, vv, n_valid_points, type, p0, p1);
-		if (spline) {
+		if (fit_cspline (cache, n_valid_points, type, p0, p1)) {
 			double x0, x1, x2, x3, y0, y1, y2, y3;
+			spline = cache->spline;
 			x0 = uu[0];
 			y0 = vv[0];
 			go_path_move_to (path, x0, y0);
@@ -444,12 +508,11 @@ make_path_cspline (GogChartMap *map,
 				x0 = x3;
 				y0 = y3;
 			}
-			go_cspline_destroy (spline);
 		}
 	}
 
-	g_free (uu);
-	g_free (vv);
+	if (map->chart == NULL)
+		cspline_cache_free (cache);
 
 	return path;
 }
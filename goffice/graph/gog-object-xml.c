@@ -155,13 +155,51 @@ gog_object_write_property_sax (GogObject const *obj, GParamSpec *pspec, GsfXMLOu
 	g_value_unset (&value);
 }
 
+/*
+ * When asked for, data with at least this many values are saved in binary
+ * form, which is much faster to write and read.  Smaller data stay
+ * readable.
+ */
+#define GOG_XML_BINARY_THRESHOLD 4096
+#define GOG_XML_BINARY_KEY "gog-xml-binary-data"
+
+/**
+ * gog_object_write_xml_set_binary:
+ * @output: #GsfXMLOut
+ * @binary: whether to save large simple data in binary form
+ *
+ * Makes gog_object_write_xml_sax() save #GODataVectorVal and
+ * #GODataMatrixVal data with many values as base64, which is much faster.
+ * Older versions cannot read these and silently drop the data, so this is
+ * off by default.
+ **/
+void
+gog_object_write_xml_set_binary (GsfXMLOut *output, gboolean binary)
+{
+	g_return_if_fail (GSF_IS_XML_OUT (output));
+
+	g_object_set_data (G_OBJECT (output), GOG_XML_BINARY_KEY,
+			   GINT_TO_POINTER (binary != FALSE));
+}
+
+static gboolean
+gog_dataset_use_binary (GOData *dat, gboolean allowed)
+{
+	return allowed &&
+		(GO_IS_DATA_VECTOR_VAL (dat) || GO_IS_DATA_MATRIX_VAL (dat)) &&
+		go_data_get_n_values (dat) >= GOG_XML_BINARY_THRESHOLD;
+}
+
 static void
 gog_dataset_sax_save (GogDataset const *set, GsfXMLOut *output, gpointer user)
 {
 	GOData  *dat;
 	char    *tmp;
 	int      i, last;
+	gboolean binary, allowed;
 
+	allowed = GPOINTER_TO_INT (g_object_get_data (G_OBJECT (output),
+						      GOG_XML_BINARY_KEY));
 	gsf_xml_out_start_element (output, "data");
 	gog_dataset_dims (set, &i, &last);
 	for ( ; i <= last ; i++) {
@@ -169,15 +207,26 @@ gog_dataset_sax_save (GogDataset const *set, GsfXMLOut *output, gpointer user)
 		if (dat == NULL)
 			continue;
 
-		tmp = go_data_serialize (dat, user);
+		binary = gog_dataset_use_binary (dat, allowed);
+		tmp = binary
+			? go_data_serialize_base64 (dat)
+			: go_data_serialize (dat, user);
 		/* only save the data if there is some valid content, see #46 */
-		if (tmp == NULL || *tmp == 0)
+		if (tmp == NULL || *tmp == 0) {
+			g_free (tmp);
 			continue;
+		}
 		gsf_xml_out_start_element (output, "dimension");
 		gsf_xml_out_add_int (output, "id", i);
 		gsf_xml_out_add_cstr (output, "type",
 			G_OBJECT_TYPE_NAME (dat));
-		gsf_xml_out_add_cstr (output, NULL, tmp);
+		if (binary) {
+			/* Nothing to escape in base64.  */
+			gsf_xml_out_add_cstr_unchecked (output, "encoding",
+							"base64");
+			gsf_xml_out_add_cstr_unchecked (output, NULL, tmp);
+		} else
+			gsf_xml_out_add_cstr (output, NULL, tmp);
 		g_free (tmp);
 		gsf_xml_out_end_element (output); /* </dimension> */
 	}
@@ -233,6 +282,7 @@ typedef struct {
 	gboolean	 prop_pushed_obj;
 	GOData		*dimension;
 	int		 dimension_id;
+	gboolean	 dimension_base64;
 
 	GogObjectSaxHandler handler;
 	gpointer user_data;
@@ -262,6 +312,8 @@ gogo_dim_start (GsfXMLIn *xin, xmlChar const **attrs)
 	if (NULL == state->obj)
 		return;
 
+	state->dimension_base64 = FALSE;
+
 	g_return_if_fail (GOG_IS_DATASET (state->obj));
 
 	for (; attrs != NULL && attrs[0] && attrs[1] ; attrs += 2)
@@ -269,6 +321,8 @@ gogo_dim_start (GsfXMLIn *xin, xmlChar const **attrs)
 			dim_str = attrs[1];
 		else if (0 == strcmp (attrs[0], "type"))
 			type_str = attrs[1];
+		else if (0 == strcmp (attrs[0], "encoding"))
+			state->dimension_base64 = (0 == strcmp (attrs[1], "base64"));
 
 	if (NULL == dim_str) {
 		g_warning ("missing dimension id for class `%s'",
@@ -315,9 +369,13 @@ gogo_dim_end (GsfXMLIn *xin, G_GNUC_UNUSED GsfXMLBlob *unknown)
 	g_return_if_fail (GOG_IS_DATASET (state->obj));
 
 	if (NULL != state->dimension) {
-		if (go_data_unserialize (state->dimension,
-					 xin->content->str,
-					 state->user_unserialize))
+		gboolean ok = state->dimension_base64
+			? go_data_unserialize_base64 (state->dimension,
+						      xin->content->str)
+			: go_data_unserialize (state->dimension,
+					       xin->content->str,
+					       state->user_unserialize);
+		if (ok)
 			gog_dataset_set_dim (GOG_DATASET (state->obj),
 				state->dimension_id, state->dimension, NULL);
 		else
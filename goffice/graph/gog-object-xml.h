@@ -29,6 +29,7 @@ G_BEGIN_DECLS
 
 void	   gog_object_set_arg	   (char const *name, char const *val, GogObject *obj);
 void	   gog_object_write_xml_sax(GogObject const *obj, GsfXMLOut *output, gpointer user);
+void	   gog_object_write_xml_set_binary (GsfXMLOut *output, gboolean binary);
 
 typedef void (*GogObjectSaxHandler)(GogObject *obj, gpointer user_data);
 void	   gog_object_sax_push_parser (GsfXMLIn *xin, xmlChar const **attrs,
@@ -38,6 +38,8 @@
  * @get_value_at: returns the calculated value.
  * @get_equation: gets the regression equation as a string.
  * @populate_editor: populates the editor.
+ * @get_values_at: calculates the values for an array of x values.  This
+ * is optional; if not set, @get_value_at is called for each value.
  **/
 
 #define GOG_REG_CURVE_GET_CLASS(o)	(G_TYPE_INSTANCE_GET_CLASS ((o), GOG_TYPE_REG_CURVE, GogRegCurveClass))
@@ -296,6 +298,7 @@ gog_reg_curve_class_init (GogObjectClass *gog_klass)
 	gog_object_register_roles (gog_klass, roles, G_N_ELEMENTS (roles));
 
 	reg_curve_klass->get_value_at = NULL;
+	reg_curve_klass->get_values_at = NULL;
 	reg_curve_klass->get_equation = NULL;
 #ifdef GOFFICE_WITH_GTK
 	reg_curve_klass->populate_editor = NULL;
@@ -364,10 +367,17 @@ GSF_CLASS_FULL (GogRegCurve, gog_reg_curve,
 	   gog_reg_curve_init, GOG_TYPE_TREND_LINE, G_TYPE_FLAG_ABSTRACT,
 		GSF_INTERFACE (gog_reg_curve_dataset_init, GOG_TYPE_DATASET))
 
-static double
-gog_reg_curve_get_value_at (GogRegCurve *reg_curve, double x)
+static void
+gog_reg_curve_get_values_at (GogRegCurve *reg_curve, double const *x, double *y, int n)
 {
-	return (GOG_REG_CURVE_GET_CLASS (reg_curve))->get_value_at (reg_curve, x);
+	GogRegCurveClass *klass = GOG_REG_CURVE_GET_CLASS (reg_curve);
+	int i;
+
+	if (klass->get_values_at)
+		klass->get_values_at (reg_curve, x, y, n);
+	else
+		for (i = 0; i < n; i++)
+			y[i] = klass->get_value_at (reg_curve, x[i]);
 }
 
 gchar const*
@@ -446,11 +456,6 @@ gog_reg_curve_view_render (GogView *view, GogViewAllocation const *bbox)
 	case GOG_REG_CURVE_DRAWING_BOUNDS_NONE:
 		min = gog_axis_map_from_view (x_map, view->residual.x);
 		max = gog_axis_map_from_view (x_map, view->residual.x + view->residual.w);
-		delta_x = view->residual.w / rc->ninterp;
-		for (i = 0; i <= rc->ninterp; i++) {
-			x[i] = gog_axis_map_from_view (x_map, i * delta_x + view->residual.x);
-			y[i] = gog_reg_curve_get_value_at (rc, x[i]);
-		}
 		break;
 	case GOG_REG_CURVE_DRAWING_BOUNDS_ABSOLUTE: {
 		if (rc->bounds[2].data) {
@@ -514,10 +519,9 @@ gog_reg_curve_view_render (GogView *view, GogViewAllocation const *bbox)
 	}
 
 	delta_x = (max - min) / rc->ninterp;
-	for (i = 0; i <= rc->ninterp; i++) {
+	for (i = 0; i <= rc->ninterp; i++)
 		x[i] = min + i * delta_x;
-		y[i] = gog_reg_curve_get_value_at (rc, x[i]);
-	}
+	gog_reg_curve_get_values_at (rc, x, y, rc->ninterp + 1);
 	path = gog_chart_map_make_path (chart_map, x, y, rc->ninterp + 1, GO_LINE_INTERPOLATION_CUBIC_SPLINE, FALSE, NULL);
 	style = GOG_STYLED_OBJECT (rc)->style;
 	gog_renderer_push_style (view->renderer, style);
@@ -52,8 +52,8 @@ typedef struct {
 	double 		(*get_value_at) (GogRegCurve *reg_curve, double x);
 	char const * 	(*get_equation) (GogRegCurve *reg_curve);
 	void 		(*populate_editor) (GogRegCurve *reg_curve, gpointer table);
+	void		(*get_values_at) (GogRegCurve *reg_curve, double const *x, double *y, int n);
 	/*<private>*/
-	void	        (*reserved1) (void);
 	void	        (*reserved2) (void);
 } GogRegCurveClass;
 
@@ -119,6 +119,54 @@ go_qcauchyD (_Decimal64 p, _Decimal64 location, _Decimal64 scale, gboolean lower
 	return go_qcauchy (p, location, scale, lower_tail, log_p);
 }
 
+void
+go_pnorm_vD (_Decimal64 const *x, _Decimal64 *out, int n, _Decimal64 mu, _Decimal64 sigma, gboolean lower_tail, gboolean log_p)
+{
+	int i;
+	for (i = 0; i < n; i++)
+		out[i] = go_pnormD (x[i], mu, sigma, lower_tail, log_p);
+}
+
+void
+go_qnorm_vD (_Decimal64 const *p, _Decimal64 *out, int n, _Decimal64 mu, _Decimal64 sigma, gboolean lower_tail, gboolean log_p)
+{
+	int i;
+	for (i = 0; i < n; i++)
+		out[i] = go_qnormD (p[i], mu, sigma, lower_tail, log_p);
+}
+
+void
+go_plnorm_vD (_Decimal64 const *x, _Decimal64 *out, int n, _Decimal64 logmean, _Decimal64 logsd, gboolean lower_tail, gboolean log_p)
+{
+	int i;
+	for (i = 0; i < n; i++)
+		out[i] = go_plnormD (x[i], logmean, logsd, lower_tail, log_p);
+}
+
+void
+go_qlnorm_vD (_Decimal64 const *p, _Decimal64 *out, int n, _Decimal64 logmean, _Decimal64 logsd, gboolean lower_tail, gboolean log_p)
+{
+	int i;
+	for (i = 0; i < n; i++)
+		out[i] = go_qlnormD (p[i], logmean, logsd, lower_tail, log_p);
+}
+
+void
+go_pweibull_vD (_Decimal64 const *x, _Decimal64 *out, int n, _Decimal64 shape, _Decimal64 scale, gboolean lower_tail, gboolean log_p)
+{
+	int i;
+	for (i = 0; i < n; i++)
+		out[i] = go_pweibullD (x[i], shape, scale, lower_tail, log_p);
+}
+
+void
+go_qweibull_vD (_Decimal64 const *p, _Decimal64 *out, int n, _Decimal64 shape, _Decimal64 scale, gboolean lower_tail, gboolean log_p)
+{
+	int i;
+	for (i = 0; i < n; i++)
+		out[i] = go_qweibullD (p[i], shape, scale, lower_tail, log_p);
+}
+
 
 #endif
 
@@ -436,6 +484,43 @@ go_qcauchyD (_Decimal64 p, _Decimal64 location, _Decimal64 scale, gboolean lower
 
 // ???
 
+/*
+ * Central branches of the normal distribution, shared by the code imported
+ * from R below and the batch functions after it.  tools/import-R rewrites
+ * the imported code to use these.
+ */
+
+/* Coefficients for |x| <= 0.67448975 in go_pnorm_both.  */
+static const DOUBLE SUFFIX(pnorm_central_a)[5] = {
+	CONST (2.2352520354606839287),
+	CONST (161.02823106855587881),
+	CONST (1067.6894854603709582),
+	CONST (18154.981253343561249),
+	CONST (0.065682337918207449113)
+};
+static const DOUBLE SUFFIX(pnorm_central_b)[4] = {
+	CONST (47.20258190468824187),
+	CONST (976.09855173777669322),
+	CONST (10260.932208618978205),
+	CONST (45507.789335026729956)
+};
+
+/* AS 241 for |q| <= .425 in go_qnorm, q being p - 0.5.  */
+static inline DOUBLE
+SUFFIX(qnorm_central) (DOUBLE q)
+{
+	DOUBLE r = CONST (.180625) - q * q;
+	return q * (((((((r * CONST (2509.0809287301226727) +
+			  CONST (33430.575583588128105)) * r + CONST (67265.770927008700853)) * r +
+			CONST (45921.953931549871457)) * r + CONST (13731.693765509461125)) * r +
+		      CONST (1971.5909503065514427)) * r + CONST (133.14166789178437745)) * r +
+		    CONST (3.387132872796366608))
+		/ (((((((r * CONST (5226.495278852854561) +
+			 CONST (28729.085735721942674)) * r + CONST (39307.89580009271061)) * r +
+		       CONST (21213.794301586595867)) * r + CONST (5394.1960214247511077)) * r +
+		     CONST (687.1870074920579083)) * r + CONST (42.313330701600911252)) * r + 1.);
+}
+
 
 /* ------------------------------------------------------------------------- */
 /* --- BEGIN MAGIC R SOURCE MARKER --- */
@@ -630,19 +715,8 @@ void SUFFIX (go_pnorm_both) (DOUBLE x, DOUBLE *cum, DOUBLE *ccum, int i_tail, gb
    if(lower) return  *cum := P[X <= x]
    if(upper) return *ccum := P[X >  x] = 1 - P[X <= x]
 */
-    const static DOUBLE a[5] = {
-	CONST (2.2352520354606839287),
-	CONST (161.02823106855587881),
-	CONST (1067.6894854603709582),
-	CONST (18154.981253343561249),
-	CONST (0.065682337918207449113)
-    };
-    const static DOUBLE b[4] = {
-	CONST (47.20258190468824187),
-	CONST (976.09855173777669322),
-	CONST (10260.932208618978205),
-	CONST (45507.789335026729956)
-    };
+    const DOUBLE *a = SUFFIX (pnorm_central_a);
+    const DOUBLE *b = SUFFIX (pnorm_central_b);
     const static DOUBLE c[9] = {
 	CONST (0.39894151208813466764),
 	CONST (8.8831497943883759412),
@@ -902,17 +976,7 @@ DOUBLE SUFFIX (go_qnorm) (DOUBLE p, DOUBLE mu, DOUBLE sigma, gboolean lower_tail
          and provided hash codes for checking them...)
 */
     if (SUFFIX (fabs) (q) <= .425) {/* 0.075 <= p <= 0.925 */
-        r = CONST (.180625) - q * q;
-	val =
-            q * (((((((r * CONST (2509.0809287301226727) +
-                       CONST (33430.575583588128105)) * r + CONST (67265.770927008700853)) * r +
-                     CONST (45921.953931549871457)) * r + CONST (13731.693765509461125)) * r +
-                   CONST (1971.5909503065514427)) * r + CONST (133.14166789178437745)) * r +
-                 CONST (3.387132872796366608))
-            / (((((((r * CONST (5226.495278852854561) +
-                     CONST (28729.085735721942674)) * r + CONST (39307.89580009271061)) * r +
-                   CONST (21213.794301586595867)) * r + CONST (5394.1960214247511077)) * r +
-                 CONST (687.1870074920579083)) * r + CONST (42.313330701600911252)) * r + 1.);
+	val = SUFFIX (qnorm_central) (q);
     }
     else { /* closer than 0.075 from {0,1} boundary */
 
@@ -1400,6 +1464,302 @@ DOUBLE SUFFIX (go_qcauchy) (DOUBLE p, DOUBLE location, DOUBLE scale,
 /* ------------------------------------------------------------------------ */
 /* --- END MAGIC R SOURCE MARKER --- */
 
+/* ------------------------------------------------------------------------- */
+/*
+ * Batch versions.  The parameter checks are done once per call and the
+ * central branch of the normal approximations is evaluated for a block of
+ * values at a time in loops without data-dependent control flow, which
+ * the compiler can vectorize.  Values outside the central branch are
+ * handed to the scalar functions.  The results are identical to calling
+ * the scalar functions one value at a time.
+ */
+
+#define R_BATCH_BLOCK 64
+
+/**
+ * go_pnorm_v:
+ * @x: (array length=n): values
+ * @out: (out) (array length=n): location for results
+ * @n: number of values
+ * @mu: mean of the distribution
+ * @sigma: standard deviation of the distribution
+ * @lower_tail: if %TRUE, compute P(X &le; x)
+ * @log_p: if %TRUE, return the logarithm of the probability
+ *
+ * Stores go_pnorm (@x[i], @mu, @sigma, @lower_tail, @log_p) in @out[i]
+ * for all i.  @x and @out may be the same array.
+ */
+void
+SUFFIX(go_pnorm_v) (DOUBLE const *x, DOUBLE *out, int n,
+		    DOUBLE mu, DOUBLE sigma,
+		    gboolean lower_tail, gboolean log_p)
+{
+	const DOUBLE *a = SUFFIX(pnorm_central_a);
+	const DOUBLE *b = SUFFIX(pnorm_central_b);
+	DOUBLE const eps = DOUBLE_EPSILON * 0.5;
+	DOUBLE z[R_BATCH_BLOCK], t[R_BATCH_BLOCK];
+	int i0, i;
+
+	if (DOUBLE_ISNAN (mu) || DOUBLE_ISNAN (sigma) || !(sigma > 0)) {
+		for (i = 0; i < n; i++)
+			out[i] = SUFFIX(go_pnorm) (x[i], mu, sigma, lower_tail, log_p);
+		return;
+	}
+
+	for (i0 = 0; i0 < n; i0 += R_BATCH_BLOCK) {
+		int m = MIN (R_BATCH_BLOCK, n - i0);
+
+		for (i = 0; i < m; i++) {
+			DOUBLE zi = (x[i0 + i] - mu) / sigma;
+			DOUBLE xsq = zi * zi;
+			DOUBLE xnum = a[4] * xsq, xden = xsq;
+			xnum = (xnum + a[0]) * xsq;
+			xden = (xden + b[0]) * xsq;
+			xnum = (xnum + a[1]) * xsq;
+			xden = (xden + b[1]) * xsq;
+			xnum = (xnum + a[2]) * xsq;
+			xden = (xden + b[2]) * xsq;
+			if (!(SUFFIX(fabs) (zi) > eps))
+				xnum = xden = 0;
+			z[i] = zi;
+			t[i] = zi * (xnum + a[3]) / (xden + b[3]);
+		}
+
+		for (i = 0; i < m; i++) {
+			if (SUFFIX(fabs) (z[i]) <= CONST (0.67448975)) {
+				DOUBLE r = lower_tail ? 0.5 + t[i] : 0.5 - t[i];
+				out[i0 + i] = log_p ? SUFFIX(log) (r) : r;
+			} else
+				out[i0 + i] = SUFFIX(go_pnorm) (x[i0 + i], mu, sigma,
+								lower_tail, log_p);
+		}
+	}
+}
+
+/**
+ * go_qnorm_v:
+ * @p: (array length=n): probabilities
+ * @out: (out) (array length=n): location for results
+ * @n: number of probabilities
+ * @mu: mean of the distribution
+ * @sigma: standard deviation of the distribution
+ * @lower_tail: if %TRUE, @p are lower tail probabilities
+ * @log_p: if %TRUE, @p are logarithms of probabilities
+ *
+ * Stores go_qnorm (@p[i], @mu, @sigma, @lower_tail, @log_p) in @out[i]
+ * for all i.  @p and @out may be the same array.
+ */
+void
+SUFFIX(go_qnorm_v) (DOUBLE const *p, DOUBLE *out, int n,
+		    DOUBLE mu, DOUBLE sigma,
+		    gboolean lower_tail, gboolean log_p)
+{
+	DOUBLE q[R_BATCH_BLOCK], val[R_BATCH_BLOCK];
+	int i0, i;
+
+	if (DOUBLE_ISNAN (mu) || DOUBLE_ISNAN (sigma) || !(sigma > 0)) {
+		for (i = 0; i < n; i++)
+			out[i] = SUFFIX(go_qnorm) (p[i], mu, sigma, lower_tail, log_p);
+		return;
+	}
+
+	for (i0 = 0; i0 < n; i0 += R_BATCH_BLOCK) {
+		int m = MIN (R_BATCH_BLOCK, n - i0);
+
+		for (i = 0; i < m; i++) {
+			DOUBLE pp = p[i0 + i];
+			q[i] = (log_p
+				? (lower_tail ? SUFFIX(exp) (pp) : -SUFFIX(expm1) (pp))
+				: (lower_tail ? pp : (0.5 - pp + 0.5))) - 0.5;
+		}
+
+		for (i = 0; i < m; i++)
+			val[i] = SUFFIX(qnorm_central) (q[i]);
+
+		for (i = 0; i < m; i++) {
+			if (SUFFIX(fabs) (q[i]) <= .425)
+				out[i0 + i] = mu + sigma * val[i];
+			else
+				out[i0 + i] = SUFFIX(go_qnorm) (p[i0 + i], mu, sigma,
+								lower_tail, log_p);
+		}
+	}
+}
+
+/**
+ * go_plnorm_v:
+ * @x: (array length=n): values
+ * @out: (out) (array length=n): location for results
+ * @n: number of values
+ * @logmean: mean of the underlying normal distribution
+ * @logsd: standard deviation of the underlying normal distribution
+ * @lower_tail: if %TRUE, compute P(X &le; x)
+ * @log_p: if %TRUE, return the logarithm of the probability
+ *
+ * Stores go_plnorm (@x[i], @logmean, @logsd, @lower_tail, @log_p) in
+ * @out[i] for all i.  @x and @out may be the same array.
+ */
+void
+SUFFIX(go_plnorm_v) (DOUBLE const *x, DOUBLE *out, int n,
+		     DOUBLE logmean, DOUBLE logsd,
+		     gboolean lower_tail, gboolean log_p)
+{
+	DOUBLE lx[R_BATCH_BLOCK];
+	int i0, i;
+
+	if (DOUBLE_ISNAN (logmean) || DOUBLE_ISNAN (logsd) || !(logsd > 0)) {
+		for (i = 0; i < n; i++)
+			out[i] = SUFFIX(go_plnorm) (x[i], logmean, logsd, lower_tail, log_p);
+		return;
+	}
+
+	for (i0 = 0; i0 < n; i0 += R_BATCH_BLOCK) {
+		int m = MIN (R_BATCH_BLOCK, n - i0);
+
+		for (i = 0; i < m; i++)
+			lx[i] = x[i0 + i] > 0 ? SUFFIX(log) (x[i0 + i]) : 0;
+		SUFFIX(go_pnorm_v) (lx, lx, m, logmean, logsd, lower_tail, log_p);
+		for (i = 0; i < m; i++)
+			out[i0 + i] = x[i0 + i] > 0
+				? lx[i]
+				: SUFFIX(go_plnorm) (x[i0 + i], logmean, logsd,
+						     lower_tail, log_p);
+	}
+}
+
+/**
+ * go_qlnorm_v:
+ * @p: (array length=n): probabilities
+ * @out: (out) (array length=n): location for results
+ * @n: number of probabilities
+ * @logmean: mean of the underlying normal distribution
+ * @logsd: standard deviation of the underlying normal distribution
+ * @lower_tail: if %TRUE, @p are lower tail probabilities
+ * @log_p: if %TRUE, @p are logarithms of probabilities
+ *
+ * Stores go_qlnorm (@p[i], @logmean, @logsd, @lower_tail, @log_p) in
+ * @out[i] for all i.  @p and @out may be the same array.
+ */
+void
+SUFFIX(go_qlnorm_v) (DOUBLE const *p, DOUBLE *out, int n,
+		     DOUBLE logmean, DOUBLE logsd,
+		     gboolean lower_tail, gboolean log_p)
+{
+	int i;
+
+	if (DOUBLE_ISNAN (logmean) || DOUBLE_ISNAN (logsd) || !(logsd > 0)) {
+		for (i = 0; i < n; i++)
+			out[i] = SUFFIX(go_qlnorm) (p[i], logmean, logsd, lower_tail, log_p);
+		return;
+	}
+
+	/*
+	 * The boundary cases of go_qlnorm are exactly the images under exp
+	 * of those of go_qnorm, so no special treatment is needed.
+	 */
+	SUFFIX(go_qnorm_v) (p, out, n, logmean, logsd, lower_tail, log_p);
+	for (i = 0; i < n; i++)
+		out[i] = SUFFIX(exp) (out[i]);
+}
+
+/**
+ * go_pweibull_v:
+ * @x: (array length=n): values
+ * @out: (out) (array length=n): location for results
+ * @n: number of values
+ * @shape: shape parameter of the distribution
+ * @scale: scale parameter of the distribution
+ * @lower_tail: if %TRUE, compute P(X &le; x)
+ * @log_p: if %TRUE, return the logarithm of the probability
+ *
+ * Stores go_pweibull (@x[i], @shape, @scale, @lower_tail, @log_p) in
+ * @out[i] for all i.  @x and @out may be the same array.
+ */
+void
+SUFFIX(go_pweibull_v) (DOUBLE const *x, DOUBLE *out, int n,
+		       DOUBLE shape, DOUBLE scale,
+		       gboolean lower_tail, gboolean log_p)
+{
+	int i;
+
+	if (DOUBLE_ISNAN (shape) || DOUBLE_ISNAN (scale) ||
+	    !(shape > 0) || !(scale > 0)) {
+		for (i = 0; i < n; i++)
+			out[i] = SUFFIX(go_pweibull) (x[i], shape, scale, lower_tail, log_p);
+		return;
+	}
+
+	for (i = 0; i < n; i++) {
+		DOUBLE t;
+
+		if (!(x[i] > 0)) {
+			out[i] = SUFFIX(go_pweibull) (x[i], shape, scale, lower_tail, log_p);
+			continue;
+		}
+
+		t = -SUFFIX(pow) (x[i] / scale, shape);
+		if (lower_tail)
+			out[i] = log_p
+				? (t > -M_LN2goffice
+				   ? SUFFIX(log) (-SUFFIX(expm1) (t))
+				   : SUFFIX(log1p) (-SUFFIX(exp) (t)))
+				: -SUFFIX(expm1) (t);
+		else
+			out[i] = log_p ? t : SUFFIX(exp) (t);
+	}
+}
+
+/**
+ * go_qweibull_v:
+ * @p: (array length=n): probabilities
+ * @out: (out) (array length=n): location for results
+ * @n: number of probabilities
+ * @shape: shape parameter of the distribution
+ * @scale: scale parameter of the distribution
+ * @lower_tail: if %TRUE, @p are lower tail probabilities
+ * @log_p: if %TRUE, @p are logarithms of probabilities
+ *
+ * Stores go_qweibull (@p[i], @shape, @scale, @lower_tail, @log_p) in
+ * @out[i] for all i.  @p and @out may be the same array.
+ */
+void
+SUFFIX(go_qweibull_v) (DOUBLE const *p, DOUBLE *out, int n,
+		       DOUBLE shape, DOUBLE scale,
+		       gboolean lower_tail, gboolean log_p)
+{
+	DOUBLE ishape;
+	int i;
+
+	if (DOUBLE_ISNAN (shape) || DOUBLE_ISNAN (scale) ||
+	    !(shape > 0) || !(scale > 0)) {
+		for (i = 0; i < n; i++)
+			out[i] = SUFFIX(go_qweibull) (p[i], shape, scale, lower_tail, log_p);
+		return;
+	}
+
+	ishape = 1. / shape;
+	for (i = 0; i < n; i++) {
+		DOUBLE pp = p[i], l;
+
+		if (log_p ? !(pp < 0 && pp > SUFFIX(go_ninf)) : !(pp > 0 && pp < 1)) {
+			out[i] = SUFFIX(go_qweibull) (pp, shape, scale, lower_tail, log_p);
+			continue;
+		}
+
+		if (lower_tail)
+			l = log_p
+				? (pp > -M_LN2goffice
+				   ? SUFFIX(log) (-SUFFIX(expm1) (pp))
+				   : SUFFIX(log1p) (-SUFFIX(exp) (pp)))
+				: SUFFIX(log1p) (-pp);
+		else
+			l = log_p ? pp : SUFFIX(log) (pp);
+		out[i] = scale * SUFFIX(pow) (-l, ishape);
+	}
+}
+
+#undef R_BATCH_BLOCK
+
 /* ------------------------------------------------------------------------- */
 
 // See comments at top
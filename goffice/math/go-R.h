@@ -39,6 +39,13 @@ double go_dcauchy (double x, double location, double scale, gboolean give_log);
 double go_pcauchy (double x, double location, double scale, gboolean lower_tail, gboolean log_p);
 double go_qcauchy (double p, double location, double scale, gboolean lower_tail, gboolean log_p);
 
+void go_pnorm_v (double const *x, double *out, int n, double mu, double sigma, gboolean lower_tail, gboolean log_p);
+void go_qnorm_v (double const *p, double *out, int n, double mu, double sigma, gboolean lower_tail, gboolean log_p);
+void go_plnorm_v (double const *x, double *out, int n, double logmean, double logsd, gboolean lower_tail, gboolean log_p);
+void go_qlnorm_v (double const *p, double *out, int n, double logmean, double logsd, gboolean lower_tail, gboolean log_p);
+void go_pweibull_v (double const *x, double *out, int n, double shape, double scale, gboolean lower_tail, gboolean log_p);
+void go_qweibull_v (double const *p, double *out, int n, double shape, double scale, gboolean lower_tail, gboolean log_p);
+
 // ----------------------------------------------------------------------------
 
 #ifdef GOFFICE_WITH_LONG_DOUBLE
@@ -58,6 +65,13 @@ long double go_dcauchyl (long double x, long double location, long double scale,
 long double go_pcauchyl (long double x, long double location, long double scale, gboolean lower_tail, gboolean log_p);
 long double go_qcauchyl (long double p, long double location, long double scale, gboolean lower_tail, gboolean log_p);
 
+void go_pnorm_vl (long double const *x, long double *out, int n, long double mu, long double sigma, gboolean lower_tail, gboolean log_p);
+void go_qnorm_vl (long double const *p, long double *out, int n, long double mu, long double sigma, gboolean lower_tail, gboolean log_p);
+void go_plnorm_vl (long double const *x, long double *out, int n, long double logmean, long double logsd, gboolean lower_tail, gboolean log_p);
+void go_qlnorm_vl (long double const *p, long double *out, int n, long double logmean, long double logsd, gboolean lower_tail, gboolean log_p);
+void go_pweibull_vl (long double const *x, long double *out, int n, long double shape, long double scale, gboolean lower_tail, gboolean log_p);
+void go_qweibull_vl (long double const *p, long double *out, int n, long double shape, long double scale, gboolean lower_tail, gboolean log_p);
+
 #endif
 
 // ----------------------------------------------------------------------------
@@ -79,6 +93,13 @@ _Decimal64 go_dcauchyD (_Decimal64 x, _Decimal64 location, _Decimal64 scale, gbo
 _Decimal64 go_pcauchyD (_Decimal64 x, _Decimal64 location, _Decimal64 scale, gboolean lower_tail, gboolean log_p);
 _Decimal64 go_qcauchyD (_Decimal64 p, _Decimal64 location, _Decimal64 scale, gboolean lower_tail, gboolean log_p);
 
+void go_pnorm_vD (_Decimal64 const *x, _Decimal64 *out, int n, _Decimal64 mu, _Decimal64 sigma, gboolean lower_tail, gboolean log_p);
+void go_qnorm_vD (_Decimal64 const *p, _Decimal64 *out, int n, _Decimal64 mu, _Decimal64 sigma, gboolean lower_tail, gboolean log_p);
+void go_plnorm_vD (_Decimal64 const *x, _Decimal64 *out, int n, _Decimal64 logmean, _Decimal64 logsd, gboolean lower_tail, gboolean log_p);
+void go_qlnorm_vD (_Decimal64 const *p, _Decimal64 *out, int n, _Decimal64 logmean, _Decimal64 logsd, gboolean lower_tail, gboolean log_p);
+void go_pweibull_vD (_Decimal64 const *x, _Decimal64 *out, int n, _Decimal64 shape, _Decimal64 scale, gboolean lower_tail, gboolean log_p);
+void go_qweibull_vD (_Decimal64 const *p, _Decimal64 *out, int n, _Decimal64 shape, _Decimal64 scale, gboolean lower_tail, gboolean log_p);
+
 #endif
 
 // ----------------------------------------------------------------------------
@@ -0,0 +1,40 @@
+// There should be no include guard for this file
+
+// The algorithm of GOAccumulator.  This is included from within the
+// multipass files after goffice-multipass.h, i.e., once per number system,
+// so that go_range_sum and friends can keep their partials on the stack
+// and still add exactly the same way.
+//
+// As for go-accumulator.c itself, this must be used within
+// go_accumulator_start and go_accumulator_end.
+
+// Adds x exactly to the n non-overlapping partials, which are in order of
+// increasing magnitude.  There must be room for n + 1 partials.  Returns
+// the new number of partials.
+static inline unsigned
+SUFFIX(go_accumulator_add_partials) (DOUBLE *partials, unsigned n, DOUBLE x)
+{
+	unsigned ui = 0, uj;
+
+	for (uj = 0; uj < n; uj++) {
+		DOUBLE y = partials[uj];
+		DOUBLE hi, lo;
+		if (SUFFIX(fabs)(x) < SUFFIX(fabs)(y)) {
+			DOUBLE t = x;
+			x = y;
+			y = t;
+		}
+		hi = x + y;
+		if (!SUFFIX(go_finite)(hi)) {
+			x = hi;
+			ui = 0;
+			break;
+		}
+		lo = y - (hi - x);
+		if (lo != 0)
+			partials[ui++] = lo;
+		x = hi;
+	}
+	partials[ui] = x;
+	return ui + 1;
+}
@@ -39,12 +39,56 @@
 #include <goffice/goffice-multipass.h>
 #ifndef SKIP_THIS_PASS
 
+#include "go-accumulator-priv.h"
+
 struct INFIX(GOAccumulator,_) {
 	GArray *partials;
 };
 
 #define ACC SUFFIX(GOAccumulator)
 
+/**
+ * go_accumulator_round: (skip)
+ * @partials: non-overlapping partial sums in order of increasing magnitude
+ * @n: number of partials
+ *
+ * Returns: the correctly rounded sum of @partials.
+ **/
+DOUBLE
+SUFFIX(go_accumulator_round) (DOUBLE const *partials, unsigned n)
+{
+	DOUBLE hi, lo = 0;
+
+	if (n == 0)
+		return 0;
+
+	/* Add from the top until the result stops being exact.  */
+	hi = partials[--n];
+	while (n > 0) {
+		DOUBLE x = hi, y = partials[--n];
+		hi = x + y;
+		lo = y - (hi - x);
+		if (lo != 0)
+			break;
+	}
+
+#if DOUBLE_RADIX == 2
+	/*
+	 * If the remaining partials push lo past a half-way point, round
+	 * away from hi.  This makes round-half-even work across partials.
+	 */
+	if (n > 0 && ((lo < 0 && partials[n - 1] < 0) ||
+		      (lo > 0 && partials[n - 1] > 0))) {
+		DOUBLE y = lo * 2;
+		DOUBLE x = hi + y;
+		if (y == x - hi)
+			hi = x;
+	}
+#endif
+
+	return hi;
+}
+
 gboolean
 SUFFIX(go_accumulator_functional) (void)
 {
@@ -109,33 +153,15 @@ SUFFIX(go_accumulator_clear) (ACC *acc)
 void
 SUFFIX(go_accumulator_add) (ACC *acc, DOUBLE x)
 {
-	unsigned ui = 0, uj;
+	unsigned len;
 
 	g_return_if_fail (acc != NULL);
 
-	for (uj = 0; uj < acc->partials->len; uj++) {
-		DOUBLE y = g_array_index (acc->partials, DOUBLE, uj);
-		DOUBLE hi, lo;
-		if (SUFFIX(fabs)(x) < SUFFIX(fabs)(y)) {
-			DOUBLE t = x;
-			x = y;
-			y = t;
-		}
-		hi = x + y;
-		if (!SUFFIX(go_finite)(hi)) {
-			x = hi;
-			ui = 0;
-			break;
-		}
-		lo = y - (hi - x);
-		if (lo != 0) {
-			g_array_index (acc->partials, DOUBLE, ui) = lo;
-			ui++;
-		}
-		x = hi;
-	}
-	g_array_set_size (acc->partials, ui + 1);
-	g_array_index (acc->partials, DOUBLE, ui) = x;
+	len = acc->partials->len;
+	g_array_set_size (acc->partials, len + 1);
+	len = SUFFIX(go_accumulator_add_partials)
+		((DOUBLE *)acc->partials->data, len, x);
+	g_array_set_size (acc->partials, len);
 }
 
 /**
@@ -153,22 +179,42 @@ SUFFIX(go_accumulator_add_quad) (ACC *acc, const SUFFIX(GOQuad) *x)
 	SUFFIX(go_accumulator_add) (acc, x->l);
 }
 
+/**
+ * go_accumulator_merge: (skip)
+ * @acc: accumulator
+ * @other: accumulator to add to @acc
+ *
+ * Adds the exact sum held by @other to @acc.  Since go_accumulator_value
+ * rounds correctly, accumulators filled with the parts of a set of values
+ * and merged give the same value as one accumulator filled with all of
+ * them, barring intermediate overflow.
+ **/
+void
+SUFFIX(go_accumulator_merge) (ACC *acc, ACC const *other)
+{
+	unsigned ui;
+
+	g_return_if_fail (acc != NULL);
+	g_return_if_fail (other != NULL);
+
+	for (ui = 0; ui < other->partials->len; ui++)
+		SUFFIX(go_accumulator_add)
+			(acc, g_array_index (other->partials, DOUBLE, ui));
+}
+
 /**
  * go_accumulator_value: (skip)
  * @acc: accumulator
+ *
+ * Returns: the sum of the values added, correctly rounded.
  **/
 DOUBLE
 SUFFIX(go_accumulator_value) (ACC *acc)
 {
-	unsigned ui;
-	DOUBLE sum = 0;
-
 	g_return_val_if_fail (acc != NULL, 0);
 
-	for (ui = 0; ui < acc->partials->len; ui++)
-		sum += g_array_index (acc->partials, DOUBLE, ui);
-
-	return sum;
+	return SUFFIX(go_accumulator_round) ((DOUBLE const *)acc->partials->data,
+					     acc->partials->len);
 }
 
 /* ------------------------------------------------------------------------- */
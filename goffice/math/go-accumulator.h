@@ -14,7 +14,9 @@ void go_accumulator_free (GOAccumulator *acc);
 void go_accumulator_clear (GOAccumulator *acc);
 void go_accumulator_add (GOAccumulator *acc, double x);
 void go_accumulator_add_quad (GOAccumulator *acc, const GOQuad *x);
+void go_accumulator_merge (GOAccumulator *acc, GOAccumulator const *other);
 double go_accumulator_value (GOAccumulator *acc);
+double go_accumulator_round (double const *partials, unsigned n);
 
 
 #ifdef GOFFICE_WITH_LONG_DOUBLE
@@ -28,7 +30,9 @@ void go_accumulator_freel (GOAccumulatorl *acc);
 void go_accumulator_clearl (GOAccumulatorl *acc);
 void go_accumulator_addl (GOAccumulatorl *acc, long double x);
 void go_accumulator_add_quadl (GOAccumulatorl *acc, const GOQuadl *x);
+void go_accumulator_mergel (GOAccumulatorl *acc, GOAccumulatorl const *other);
 long double go_accumulator_valuel (GOAccumulatorl *acc);
+long double go_accumulator_roundl (long double const *partials, unsigned n);
 #endif
 
 #ifdef GOFFICE_WITH_DECIMAL64
@@ -42,7 +46,9 @@ void go_accumulator_freeD (GOAccumulatorD *acc);
 void go_accumulator_clearD (GOAccumulatorD *acc);
 void go_accumulator_addD (GOAccumulatorD *acc, _Decimal64 x);
 void go_accumulator_add_quadD (GOAccumulatorD *acc, const GOQuadD *x);
+void go_accumulator_mergeD (GOAccumulatorD *acc, GOAccumulatorD const *other);
 _Decimal64 go_accumulator_valueD (GOAccumulatorD *acc);
+_Decimal64 go_accumulator_roundD (_Decimal64 const *partials, unsigned n);
 #endif
 
 G_END_DECLS
@@ -25,6 +25,7 @@
 #include <goffice/goffice-config.h>
 #include "go-rangefunc.h"
 #include "go-cspline.h"
+#include <string.h>
 
 // We need multiple versions of this code.  We're going to include ourself
 // with different settings of various macros.  gdb will hate us.
@@ -45,55 +46,64 @@ GType INFIX(go_cspline,_get_type) (void) { return 0; }
  * @GO_CSPLINE_CLAMPED: clamped.
  **/
 
+struct INFIX(GOCSplineWorkspace,_) {
+	DOUBLE *d;
+	int size;
+};
+
 /**
- * go_cspline_init: (skip)
- * @x: the x values
- * @y: the y values
- * @n: the number of x and y values
- * @limits: how the limits must be treated, four values are allowed:
- *	GO_CSPLINE_NATURAL: first and least second derivatives are 0.
- *	GO_CSPLINE_PARABOLIC: the curve will be a parabolic arc outside of the limits.
- *	GO_CSPLINE_CUBIC: the curve will be cubic outside of the limits.
- *	GO_CSPLINE_CLAMPED: the first and last derivatives are imposed.
- * @c0: the first derivative when using clamped splines, not used in the
- *      other limit types.
- * @cn: the first derivative when using clamped splines, not used in the
- *      other limit types.
+ * go_cspline_workspace_new: (skip)
  *
- * Creates a spline structure, and computes the coefficients associated with the
- * polynomials. The ith polynomial (between x[i-1] and x[i] is:
- * y(x) = y[i-1] + (c[i-1] + (b[i-1] + a[i] * (x - x[i-1])) * (x - x[i-1])) * (x - x[i-1])
- * where a[i-1], b[i-1], c[i-1], x[i-1] and y[i-1] are the corresponding
- * members of the new structure.
+ * Creates a workspace for go_cspline_refit.  Keeping one around for
+ * repeated refits means the scratch space for solving the tridiagonal
+ * system is allocated only once.  A workspace must not be used by more
+ * than one thread at a time.
  *
- * Returns: a newly created GOCSpline instance which should be
- * destroyed by a call to go_cspline_destroy.
+ * Returns: a new workspace which should be freed by a call to
+ * go_cspline_workspace_free.
  */
-SUFFIX(GOCSpline) *
-SUFFIX(go_cspline_init) (DOUBLE const *x, DOUBLE const *y, int n,
-			 unsigned limits, DOUBLE c0, DOUBLE cn)
+SUFFIX(GOCSplineWorkspace) *
+SUFFIX(go_cspline_workspace_new) (void)
+{
+	return g_new0 (SUFFIX(GOCSplineWorkspace), 1);
+}
+
+/**
+ * go_cspline_workspace_free: (skip)
+ * @ws: a workspace returned by go_cspline_workspace_new.
+ *
+ * Frees the workspace.
+ */
+void
+SUFFIX(go_cspline_workspace_free) (SUFFIX(GOCSplineWorkspace) *ws)
 {
+	if (!ws)
+		return;
+	g_free (ws->d);
+	g_free (ws);
+}
+
+/*
+ * Compute the coefficients for the knots in sp.  The arrays in sp must
+ * already be allocated for sp->n knots and d must have room for 4n
+ * values.
+ */
+static void
+SUFFIX(go_cspline_compute) (SUFFIX(GOCSpline) *sp, unsigned limits,
+			    DOUBLE c0, DOUBLE cn, DOUBLE *d)
+{
+	DOUBLE const *x = sp->x, *y = sp->y;
+	int n = sp->n;
 	DOUBLE *d1, *d2, *d3, *d4, h;
-	SUFFIX(GOCSpline) *sp;
 	DOUBLE dx1 = 0., dy1 = 0., dx2 = 0., dy2 = 0., dxn1 = 0., dxn2 = 0.;
 	int nm1, nm2, i, j, first, last;
 
-	/* What is the minimum number of knots? Taking 3 at the moment */
-	if (limits >= GO_CSPLINE_MAX || !SUFFIX(go_range_increasing) (x, n) || n < 3)
-		return NULL;
 	nm1 = n - 1;
-	sp = g_new0 (SUFFIX(GOCSpline), 1);
-	sp->n = n;
-	sp->x = x;
-	sp->y = y;
-	sp->a = g_new0 (DOUBLE, nm1);
-	sp->b = g_new (DOUBLE, nm1);
-	sp->c = g_new (DOUBLE, nm1);
-	sp->ref_count = 1;
-	d1 =  g_new0 (DOUBLE, n);
-	d2 = g_new0 (DOUBLE, n);
-	d3 = g_new0 (DOUBLE, n);
-	d4 = g_new0 (DOUBLE, n);
+	memset (d, 0, 4 * n * sizeof (DOUBLE));
+	d1 = d;
+	d2 = d1 + n;
+	d3 = d2 + n;
+	d4 = d3 + n;
 
   /* --- COMPUTE FOR N-2 ROWS --- */
 	nm2 = n - 2;
@@ -185,11 +195,106 @@ SUFFIX(go_cspline_init) (DOUBLE const *x, DOUBLE const *y, int n,
 		sp->c[i] = ((y[i + 1] - y[i]) / h) -
 					((2 * d4[i] + d4[i + 1]) * h / 3);
 	}
+}
+
+/**
+ * go_cspline_refit: (skip)
+ * @sp: a spline structure returned by go_cspline_init.
+ * @x: the x values
+ * @y: the y values
+ * @n: the number of x and y values
+ * @limits: how the limits must be treated, see go_cspline_init.
+ * @c0: the first derivative when using clamped splines.
+ * @cn: the last derivative when using clamped splines.
+ * @ws: (nullable): a workspace returned by go_cspline_workspace_new.
+ *
+ * Recomputes @sp for new data, as if it had been created by
+ * go_cspline_init with the same arguments.  The coefficient arrays are
+ * reused when @n is unchanged, and with @ws no scratch space needs to be
+ * allocated either, so refitting a spline to data that changes but keeps
+ * its size does not allocate at all.
+ *
+ * As with go_cspline_init, @sp keeps pointers to @x and @y.  All
+ * references to @sp see the new spline.
+ *
+ * Returns: %TRUE on success.  On failure, @sp is left unchanged.
+ */
+gboolean
+SUFFIX(go_cspline_refit) (SUFFIX(GOCSpline) *sp,
+			  DOUBLE const *x, DOUBLE const *y, int n,
+			  unsigned limits, DOUBLE c0, DOUBLE cn,
+			  SUFFIX(GOCSplineWorkspace) *ws)
+{
+	DOUBLE *d;
+
+	g_return_val_if_fail (sp != NULL, FALSE);
+
+	/* What is the minimum number of knots? Taking 3 at the moment */
+	if (limits >= GO_CSPLINE_MAX || !SUFFIX(go_range_increasing) (x, n) || n < 3)
+		return FALSE;
+
+	if (n != sp->n) {
+		sp->a = g_renew (DOUBLE, sp->a, n - 1);
+		sp->b = g_renew (DOUBLE, sp->b, n - 1);
+		sp->c = g_renew (DOUBLE, sp->c, n - 1);
+		sp->n = n;
+	}
+	sp->x = x;
+	sp->y = y;
+
+	if (ws) {
+		if (ws->size < 4 * n) {
+			g_free (ws->d);
+			ws->size = 4 * n;
+			ws->d = g_new (DOUBLE, ws->size);
+		}
+		d = ws->d;
+	} else
+		d = g_new (DOUBLE, 4 * n);
 
-	g_free (d1);
-	g_free (d2);
-	g_free (d3);
-	g_free (d4);
+	SUFFIX(go_cspline_compute) (sp, limits, c0, cn, d);
+
+	if (!ws)
+		g_free (d);
+	return TRUE;
+}
+
+/**
+ * go_cspline_init: (skip)
+ * @x: the x values
+ * @y: the y values
+ * @n: the number of x and y values
+ * @limits: how the limits must be treated, four values are allowed:
+ *	GO_CSPLINE_NATURAL: first and least second derivatives are 0.
+ *	GO_CSPLINE_PARABOLIC: the curve will be a parabolic arc outside of the limits.
+ *	GO_CSPLINE_CUBIC: the curve will be cubic outside of the limits.
+ *	GO_CSPLINE_CLAMPED: the first and last derivatives are imposed.
+ * @c0: the first derivative when using clamped splines, not used in the
+ *      other limit types.
+ * @cn: the first derivative when using clamped splines, not used in the
+ *      other limit types.
+ *
+ * Creates a spline structure, and computes the coefficients associated with the
+ * polynomials. The ith polynomial (between x[i-1] and x[i] is:
+ * y(x) = y[i-1] + (c[i-1] + (b[i-1] + a[i] * (x - x[i-1])) * (x - x[i-1])) * (x - x[i-1])
+ * where a[i-1], b[i-1], c[i-1], x[i-1] and y[i-1] are the corresponding
+ * members of the new structure.
+ *
+ * Returns: a newly created GOCSpline instance which should be
+ * destroyed by a call to go_cspline_destroy.
+ */
+SUFFIX(GOCSpline) *
+SUFFIX(go_cspline_init) (DOUBLE const *x, DOUBLE const *y, int n,
+			 unsigned limits, DOUBLE c0, DOUBLE cn)
+{
+	SUFFIX(GOCSpline) *sp;
+
+	/* What is the minimum number of knots? Taking 3 at the moment */
+	if (limits >= GO_CSPLINE_MAX || !SUFFIX(go_range_increasing) (x, n) || n < 3)
+		return NULL;
+	sp = g_new0 (SUFFIX(GOCSpline), 1);
+	sp->ref_count = 1;
+	SUFFIX(go_cspline_refit) (sp, x, y, n, limits, c0, cn, NULL);
 	return sp;
 }
 
@@ -308,6 +413,95 @@ DOUBLE SUFFIX(go_cspline_get_deriv) (SUFFIX(GOCSpline) const *sp, DOUBLE x)
 	return sp->c[j] + dx * (2 * sp->b[j] + dx * 3 * sp->a[j]);
 }
 
+/*
+ * Find the polynomial for @x, i.e., the smallest j in [1,n-1] such that
+ * x <= sp->x[j], or n-1 if there is none.  The polynomial is then j-1.
+ * The search starts from @j, the answer for the previous value.
+ *
+ * For increasing values this is a merge-style walk through the knots.
+ * We step over a few knots and then gallop so that sparse values
+ * against many knots do not cost O(n) each.  Values that go backwards
+ * just bisect.
+ */
+static int
+SUFFIX(go_cspline_locate) (SUFFIX(GOCSpline) const *sp, DOUBLE x, int j)
+{
+	DOUBLE const *sx = sp->x;
+	int jmax = sp->n - 1, lo, hi, step;
+
+	if (x > sx[j]) {
+		int lim = MIN (j + 4, jmax);
+		while (j < lim && x > sx[j])
+			j++;
+		if (j < jmax && x > sx[j]) {
+			lo = j + 1;
+			hi = jmax;
+			for (step = 1; lo + step - 1 < jmax; step *= 2) {
+				int p = lo + step - 1;
+				if (x > sx[p])
+					lo = p + 1;
+				else {
+					hi = p;
+					break;
+				}
+			}
+		} else
+			return j;
+	} else if (j > 1 && !(x > sx[j - 1])) {
+		lo = 1;
+		hi = j - 1;
+	} else
+		return j;
+
+	while (lo < hi) {
+		int mid = (lo + hi) / 2;
+		if (x > sx[mid])
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+	return lo;
+}
+
+/*
+ * Evaluate the spline at the n values of x into res.  Locating the
+ * polynomial for each value starts from where the previous value was
+ * found, so the increasing x of go_cspline_get_values costs O(m + n) even
+ * when the values are sparse compared to the knots.
+ */
+static void
+SUFFIX(go_cspline_eval_values) (SUFFIX(GOCSpline) const *sp,
+				DOUBLE const *x, DOUBLE *res, int n)
+{
+	int i, j = 1;
+
+	for (i = 0; i < n; i++) {
+		DOUBLE dx = x[i];
+		int k;
+		j = SUFFIX(go_cspline_locate) (sp, dx, j);
+		k = j - 1;
+		dx -= sp->x[k];
+		res[i] = sp->y[k] + dx * (sp->c[k] + dx * (sp->b[k] + dx * sp->a[k]));
+	}
+}
+
+/* As go_cspline_eval_values, but for the derivatives.  */
+static void
+SUFFIX(go_cspline_eval_derivs) (SUFFIX(GOCSpline) const *sp,
+				DOUBLE const *x, DOUBLE *res, int n)
+{
+	int i, j = 1;
+
+	for (i = 0; i < n; i++) {
+		DOUBLE dx = x[i];
+		int k;
+		j = SUFFIX(go_cspline_locate) (sp, dx, j);
+		k = j - 1;
+		dx -= sp->x[k];
+		res[i] = sp->c[k] + dx * (2 * sp->b[k] + dx * 3 * sp->a[k]);
+	}
+}
+
 /**
  * go_cspline_get_values:
  * @sp: a spline structure returned by go_cspline_init.
@@ -323,22 +517,12 @@ DOUBLE SUFFIX(go_cspline_get_deriv) (SUFFIX(GOCSpline) const *sp, DOUBLE x)
  */
 DOUBLE *SUFFIX(go_cspline_get_values) (SUFFIX(GOCSpline) const *sp, DOUBLE const *x, int n)
 {
-	DOUBLE *res, dx;
-	int i, j, k, jmax;
+	DOUBLE *res;
 	g_return_val_if_fail (sp != NULL, NULL);
 	if (!x || n <= 0 || !SUFFIX(go_range_increasing) (x, n))
 		return NULL;
 	res = g_new (DOUBLE, n);
-	j = 1;
-	jmax = sp->n - 1;
-	for (i = 0; i < n; i++) {
-		dx = x[i];
-		while (dx > sp->x[j] && j < jmax)
-			j++;
-		k = j - 1;
-		dx -= sp->x[k];
-		res[i] = sp->y[k] + dx * (sp->c[k] + dx * (sp->b[k] + dx * sp->a[k]));
-	}
+	SUFFIX(go_cspline_eval_values) (sp, x, res, n);
 	return res;
 }
 
@@ -357,22 +541,12 @@ DOUBLE *SUFFIX(go_cspline_get_values) (SUFFIX(GOCSpline) const *sp, DOUBLE const
  */
 DOUBLE *SUFFIX(go_cspline_get_derivs) (SUFFIX(GOCSpline) const *sp, DOUBLE const *x, int n)
 {
-	DOUBLE *res, dx;
-	int i, j, k, jmax;
+	DOUBLE *res;
 	g_return_val_if_fail (sp != NULL, NULL);
 	if (!x || n <= 0 || !SUFFIX(go_range_increasing) (x, n))
 		return NULL;
 	res = g_new (DOUBLE, n);
-	j = 1;
-	jmax = sp->n - 1;
-	for (i = 0; i < n; i++) {
-		dx = x[i];
-		while (dx > sp->x[j] && j < jmax)
-			j++;
-		k = j - 1;
-		dx -= sp->x[k];
-		res[i] = sp->c[k] + dx * (2 * sp->b[k] + dx * 3 * sp->a[k]);
-	}
+	SUFFIX(go_cspline_eval_derivs) (sp, x, res, n);
 	return res;
 }
 
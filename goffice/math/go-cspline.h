@@ -44,9 +44,15 @@ typedef enum {
 } GOCSplineType;
 
 GType go_cspline_get_type (void);
+typedef struct GOCSplineWorkspace_ GOCSplineWorkspace;
 GOCSpline *go_cspline_init (double const *x, double const *y, int n,
 			    unsigned limits, double c0, double cn);
 void go_cspline_destroy (GOCSpline *sp);
+gboolean go_cspline_refit (GOCSpline *sp, double const *x, double const *y, int n,
+			   unsigned limits, double c0, double cn,
+			   GOCSplineWorkspace *ws);
+GOCSplineWorkspace *go_cspline_workspace_new (void);
+void go_cspline_workspace_free (GOCSplineWorkspace *ws);
 double go_cspline_get_value (GOCSpline const *sp, double x);
 double go_cspline_get_deriv (GOCSpline const *sp, double x);
 double *go_cspline_get_values (GOCSpline const *sp, double const *x, int n);
@@ -65,9 +71,15 @@ struct _GOCSplinel {
 };
 
 GType go_csplinel_get_type (void);
+typedef struct GOCSplineWorkspacel_ GOCSplineWorkspacel;
 GOCSplinel *go_cspline_initl (long double const *x, long double const *y, int n,
 			      unsigned limits, long double c0, long double cn);
 void go_cspline_destroyl (GOCSplinel *sp);
+gboolean go_cspline_refitl (GOCSplinel *sp, long double const *x, long double const *y, int n,
+			    unsigned limits, long double c0, long double cn,
+			    GOCSplineWorkspacel *ws);
+GOCSplineWorkspacel *go_cspline_workspace_newl (void);
+void go_cspline_workspace_freel (GOCSplineWorkspacel *ws);
 long double go_cspline_get_valuel (GOCSplinel const *sp, long double x);
 long double go_cspline_get_derivl (GOCSplinel const *sp, long double x);
 long double *go_cspline_get_valuesl (GOCSplinel const *sp, long double const *x, int n);
@@ -87,14 +99,22 @@ struct _GOCSplineD {
 };
 
 GType go_csplineD_get_type (void);
+typedef struct GOCSplineWorkspaceD_ GOCSplineWorkspaceD;
 GOCSplineD *go_cspline_initD (_Decimal64 const *x, _Decimal64 const *y, int n,
 			      unsigned limits, _Decimal64 c0, _Decimal64 cn);
 void go_cspline_destroyD (GOCSplineD *sp);
+gboolean go_cspline_refitD (GOCSplineD *sp, _Decimal64 const *x, _Decimal64 const *y, int n,
+			    unsigned limits, _Decimal64 c0, _Decimal64 cn,
+			    GOCSplineWorkspaceD *ws);
+GOCSplineWorkspaceD *go_cspline_workspace_newD (void);
+void go_cspline_workspace_freeD (GOCSplineWorkspaceD *ws);
 _Decimal64 go_cspline_get_valueD (GOCSplineD const *sp, _Decimal64 x);
 _Decimal64 go_cspline_get_derivD (GOCSplineD const *sp, _Decimal64 x);
 _Decimal64 *go_cspline_get_valuesD (GOCSplineD const *sp, _Decimal64 const *x, int n);
 _Decimal64 *go_cspline_get_derivsD (GOCSplineD const *sp, _Decimal64 const *x, int n);
 _Decimal64 *go_cspline_get_integralsD (GOCSplineD const *sp, _Decimal64 const *x, int n);
+void go_cspline_get_values_vD (GOCSplineD const *sp, _Decimal64 const *x, _Decimal64 *res, int n);
+void go_cspline_get_derivs_vD (GOCSplineD const *sp, _Decimal64 const *x, _Decimal64 *res, int n);
 #endif
 
 // -----------------------------------------------------------------------------
@@ -111,17 +111,20 @@ typedef struct {
 	double (*get_density) (GODistribution *dist, double x);
 	double (*get_cumulative) (GODistribution *dist, gboolean lower_tail, double x);
 	double (*get_ppf) (GODistribution *dist, double x);
+	void (*get_ppf_v) (GODistribution *dist, double const *x, double *out, int n);
 
 #ifdef GOFFICE_WITH_LONG_DOUBLE
 	long double (*get_densityl) (GODistribution *dist, long double x);
 	long double (*get_cumulativel) (GODistribution *dist, gboolean lower_tail, long double x);
 	long double (*get_ppfl) (GODistribution *dist, long double x);
+	void (*get_ppf_vl) (GODistribution *dist, long double const *x, long double *out, int n);
 #endif
 
 #ifdef GOFFICE_WITH_DECIMAL64
 	_Decimal64 (*get_densityD) (GODistribution *dist, _Decimal64 x);
 	_Decimal64 (*get_cumulativeD) (GODistribution *dist, gboolean lower_tail, _Decimal64 x);
 	_Decimal64 (*get_ppfD) (GODistribution *dist, _Decimal64 x);
+	void (*get_ppf_vD) (GODistribution *dist, _Decimal64 const *x, _Decimal64 *out, int n);
 #endif
 } GODistributionClass;
 
@@ -149,6 +152,19 @@ typedef struct {
 
 #define SET_HANDLERS(K,PRE) do { SET_HANDLERS_D(K,PRE); SET_HANDLERS_LD(K,PRE); SET_HANDLERS_D64(K,PRE); } while (0)
 
+/* Optional handlers for distributions with batch functions.  */
+#ifdef GOFFICE_WITH_LONG_DOUBLE
+#define SET_V_HANDLERS_LD(K,PRE) (K)->get_ppf_vl = PRE ## _get_ppf_vl;
+#else
+#define SET_V_HANDLERS_LD(K,PRE) (void)0
+#endif
+#ifdef GOFFICE_WITH_DECIMAL64
+#define SET_V_HANDLERS_D64(K,PRE) (K)->get_ppf_vD = PRE ## _get_ppf_vD;
+#else
+#define SET_V_HANDLERS_D64(K,PRE) (void)0
+#endif
+#define SET_V_HANDLERS(K,PRE) do { (K)->get_ppf_v = PRE ## _get_ppf_v; SET_V_HANDLERS_LD(K,PRE); SET_V_HANDLERS_D64(K,PRE); } while (0)
+
 
 static void
 go_distribution_set_property (GObject *obj, guint param_id,
@@ -388,6 +404,22 @@ SUFFIX(go_distribution_get_ppf) (GODistribution *dist, DOUBLE x)
 	return SUFFIX(go_nan);
 }
 
+void
+SUFFIX(go_distribution_get_ppf_v) (GODistribution *dist, DOUBLE const *x, DOUBLE *out, int n)
+{
+	GODistributionClass *go_dist_klass;
+	int i;
+
+	g_return_if_fail (GO_DISTRIBUTION (dist));
+
+	go_dist_klass = GO_DISTRIBUTION_GET_CLASS (dist);
+	if (go_dist_klass->SUFFIX(get_ppf_v) != NULL)
+		go_dist_klass->SUFFIX(get_ppf_v) (dist, x, out, n);
+	else
+		for (i = 0; i < n; i++)
+			out[i] = SUFFIX(go_distribution_get_ppf) (dist, x[i]);
+}
+
 DOUBLE
 SUFFIX(go_distribution_get_hazard) (GODistribution *dist, DOUBLE x)
 {
@@ -466,6 +498,12 @@ SUFFIX(go_normal_get_ppf) (GODistribution *dist, DOUBLE x)
 	return SUFFIX(go_qnorm) (x, DIST_LOCATION, DIST_SCALE, TRUE, FALSE);
 }
 
+static void
+SUFFIX(go_normal_get_ppf_v) (GODistribution *dist, DOUBLE const *x, DOUBLE *out, int n)
+{
+	SUFFIX(go_qnorm_v) (x, out, n, DIST_LOCATION, DIST_SCALE, TRUE, FALSE);
+}
+
 #if LAST_INCLUDE_PASS
 
 static void
@@ -479,6 +517,7 @@ go_dist_normal_class_init (GObjectClass *klass)
 	GODistributionClass *dist_klass = (GODistributionClass *) klass;
 	dist_klass->dist_type = GO_DISTRIBUTION_NORMAL;
 	SET_HANDLERS(dist_klass, go_normal);
+	SET_V_HANDLERS(dist_klass, go_normal);
 }
 
 GSF_CLASS (GODistNormal, go_dist_normal,
@@ -656,6 +695,16 @@ SUFFIX(go_weibull_get_ppf) (GODistribution *dist, DOUBLE x)
 	return SUFFIX(go_qweibull) (x, GO_DIST_WEIBULL (dist)->shape, DIST_SCALE, TRUE, FALSE) + DIST_LOCATION;
 }
 
+static void
+SUFFIX(go_weibull_get_ppf_v) (GODistribution *dist, DOUBLE const *x, DOUBLE *out, int n)
+{
+	int i;
+
+	SUFFIX(go_qweibull_v) (x, out, n, GO_DIST_WEIBULL (dist)->shape, DIST_SCALE, TRUE, FALSE);
+	for (i = 0; i < n; i++)
+		out[i] += DIST_LOCATION;
+}
+
 #if LAST_INCLUDE_PASS
 
 static void
@@ -694,6 +743,7 @@ go_dist_weibull_class_init (GObjectClass *klass)
 	GODistributionClass *dist_klass = (GODistributionClass *) klass;
 	dist_klass->dist_type = GO_DISTRIBUTION_WEIBULL;
 	SET_HANDLERS(dist_klass, go_weibull);
+	SET_V_HANDLERS(dist_klass, go_weibull);
 	klass->set_property = go_dist_weibull_set_property;
 	klass->get_property = go_dist_weibull_get_property;
 	g_object_class_install_property (klass, WEIBULL_PROP_SHAPE,
@@ -762,6 +812,16 @@ SUFFIX(go_log_normal_get_ppf) (GODistribution *dist, DOUBLE x)
 	return SUFFIX(go_qlnorm) (x, 0., GO_DIST_LOG_NORMAL (dist)->shape, TRUE, FALSE) * DIST_SCALE + DIST_LOCATION;
 }
 
+static void
+SUFFIX(go_log_normal_get_ppf_v) (GODistribution *dist, DOUBLE const *x, DOUBLE *out, int n)
+{
+	int i;
+
+	SUFFIX(go_qlnorm_v) (x, out, n, 0., GO_DIST_LOG_NORMAL (dist)->shape, TRUE, FALSE);
+	for (i = 0; i < n; i++)
+		out[i] = out[i] * DIST_SCALE + DIST_LOCATION;
+}
+
 #if LAST_INCLUDE_PASS
 
 static void
@@ -800,6 +860,7 @@ go_dist_log_normal_class_init (GObjectClass *klass)
 	GODistributionClass *dist_klass = (GODistributionClass *) klass;
 	dist_klass->dist_type = GO_DISTRIBUTION_LOGNORMAL;
 	SET_HANDLERS(dist_klass, go_log_normal);
+	SET_V_HANDLERS(dist_klass, go_log_normal);
 	klass->set_property = go_dist_log_normal_set_property;
 	klass->get_property = go_dist_log_normal_get_property;
 	g_object_class_install_property (klass, LNORM_PROP_SHAPE,
@@ -54,6 +54,7 @@ char const *go_distribution_get_distribution_name (GODistribution *dist);
 double go_distribution_get_density (GODistribution *dist, double x);
 double go_distribution_get_cumulative (GODistribution *dist, double x);
 double go_distribution_get_ppf (GODistribution *dist, double x);
+void go_distribution_get_ppf_v (GODistribution *dist, double const *x, double *out, int n);
 double go_distribution_get_hazard (GODistribution *dist, double x);
 double go_distribution_get_cumulative_hazard (GODistribution *dist, double x);
 double go_distribution_get_survival (GODistribution *dist, double x);
@@ -65,6 +66,7 @@ double go_distribution_get_inverse_survival (GODistribution *dist, double x);
 long double go_distribution_get_densityl (GODistribution *dist, long double x);
 long double go_distribution_get_cumulativel (GODistribution *dist, long double x);
 long double go_distribution_get_ppfl (GODistribution *dist, long double x);
+void go_distribution_get_ppf_vl (GODistribution *dist, long double const *x, long double *out, int n);
 long double go_distribution_get_hazardl (GODistribution *dist, long double x);
 long double go_distribution_get_cumulative_hazardl (GODistribution *dist, long double x);
 long double go_distribution_get_survivall (GODistribution *dist, long double x);
@@ -77,6 +79,7 @@ long double go_distribution_get_inverse_survivall (GODistribution *dist, long do
 _Decimal64 go_distribution_get_densityD (GODistribution *dist, _Decimal64 x);
 _Decimal64 go_distribution_get_cumulativeD (GODistribution *dist, _Decimal64 x);
 _Decimal64 go_distribution_get_ppfD (GODistribution *dist, _Decimal64 x);
+void go_distribution_get_ppf_vD (GODistribution *dist, _Decimal64 const *x, _Decimal64 *out, int n);
 _Decimal64 go_distribution_get_hazardD (GODistribution *dist, _Decimal64 x);
 _Decimal64 go_distribution_get_cumulative_hazardD (GODistribution *dist, _Decimal64 x);
 _Decimal64 go_distribution_get_survivalD (GODistribution *dist, _Decimal64 x);
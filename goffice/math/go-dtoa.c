@@ -706,3 +706,124 @@ go_dtoa (GString *dst, const char *fmt, ...)
 
 	if (debug) g_printerr ("  --> %s\n", dst->str);
 }
+
+/**
+ * go_dtoa_shortest:
+ * @d: value to format
+ * @dst: (out caller-allocates): buffer of at least
+ * %GO_DTOA_SHORTEST_BUF_SIZE bytes
+ *
+ * Formats @d in C locale using the shortest string that reads back as
+ * exactly @d.  The layout follows "%.17g", i.e., f-notation is used
+ * for decimal exponents from -4 to 16 and e-notation, with a sign and at
+ * least two exponent digits, otherwise.  Non-finite values are written as
+ * "nan" and "inf", with a sign when negative.
+ *
+ * This is a lot faster than g_ascii_dtostr and go_dtoa and meant for
+ * text serialization of numeric data.
+ *
+ * Returns: the length of the result, not counting the terminating NUL.
+ */
+int
+go_dtoa_shortest (double d, char *dst)
+{
+	char buf[GO_DTOA_SHORTEST_BUF_SIZE];
+	char digs[20];
+	const char *p;
+	char *q = dst;
+	int n, i, k, e;
+
+	n = go_ryu_d2s_buffered_n (d, buf);
+	buf[n] = 0;
+	p = buf;
+
+	if (*p == '-')
+		*q++ = *p++;
+	if (!g_ascii_isdigit (*p)) {
+		// "nan" or "inf", possibly with sign
+		memcpy (dst, buf, n + 1);
+		return n;
+	}
+
+	// Ryu gives d[.ddd]E[-]n
+	k = 0;
+	for (; *p != 'E'; p++)
+		if (*p != '.')
+			digs[k++] = *p;
+	e = atoi (p + 1);
+
+	if (e >= -4 && e < 17) {
+		if (e < 0) {
+			*q++ = '0';
+			*q++ = '.';
+			for (i = -1; i > e; i--)
+				*q++ = '0';
+			memcpy (q, digs, k);
+			q += k;
+		} else if (k <= e + 1) {
+			memcpy (q, digs, k);
+			q += k;
+			for (i = k; i <= e; i++)
+				*q++ = '0';
+		} else {
+			memcpy (q, digs, e + 1);
+			q += e + 1;
+			*q++ = '.';
+			memcpy (q, digs + e + 1, k - (e + 1));
+			q += k - (e + 1);
+		}
+	} else {
+		*q++ = digs[0];
+		if (k > 1) {
+			*q++ = '.';
+			memcpy (q, digs + 1, k - 1);
+			q += k - 1;
+		}
+		*q++ = 'e';
+		*q++ = e < 0 ? '-' : '+';
+		e = ABS (e);
+		if (e >= 100)
+			*q++ = '0' + e / 100;
+		*q++ = '0' + e / 10 % 10;
+		*q++ = '0' + e % 10;
+	}
+
+	*q = 0;
+	return q - dst;
+}
+
+/**
+ * go_dtoa_shortest_v:
+ * @dst: destination
+ * @xs: (array length=n): values to format
+ * @n: number of values
+ * @sep: separator
+ *
+ * Appends the values of @xs to @dst, each formatted as by
+ * go_dtoa_shortest and separated by @sep.
+ */
+void
+go_dtoa_shortest_v (GString *dst, double const *xs, size_t n, char sep)
+{
+	size_t i, len;
+
+	if (n == 0)
+		return;
+
+	// Reserve room for typical short values up front; the string is
+	// extended further below only when needed.
+	len = dst->len;
+	g_string_set_size (dst, len + n * 8 + GO_DTOA_SHORTEST_BUF_SIZE);
+	g_string_truncate (dst, len);
+
+	for (i = 0; i < n; i++) {
+		if (dst->allocated_len <= len + GO_DTOA_SHORTEST_BUF_SIZE + 1) {
+			g_string_set_size (dst, len + len / 2 + GO_DTOA_SHORTEST_BUF_SIZE + 1);
+			g_string_truncate (dst, len);
+		}
+		if (i)
+			dst->str[len++] = sep;
+		len += go_dtoa_shortest (xs[i], dst->str + len);
+		dst->len = len;
+	}
+}
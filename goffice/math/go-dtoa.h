@@ -10,6 +10,11 @@ G_BEGIN_DECLS
 
 void go_dtoa (GString *dst, const char *fmt, ...);
 
+#define GO_DTOA_SHORTEST_BUF_SIZE 32
+
+int go_dtoa_shortest (double d, char *dst);
+void go_dtoa_shortest_v (GString *dst, double const *xs, size_t n, char sep);
+
 /* ------------------------------------------------------------------------- */
 
 G_END_DECLS
@@ -17,50 +17,371 @@
 
 #include <goffice-config.h>
 #include <goffice/math/go-fft.h>
+#include <string.h>
 
 // We need multiple versions of this code.  We're going to include ourself
 // with different settings of various macros.  gdb will hate us.
 #include <goffice/goffice-multipass.h>
 #ifndef SKIP_THIS_PASS
 
-void
-SUFFIX(go_fourier_fft) (SUFFIX(go_complex) const *in, int n, int skip, SUFFIX(go_complex) **fourier, gboolean inverse)
-{
-	SUFFIX(go_complex)  *fourier_1, *fourier_2;
-	int        i;
-	int        nhalf = n / 2;
-	DOUBLE argstep;
+#define COMPLEX SUFFIX(go_complex)
+#define PLAN SUFFIX(GOFFTPlan)
+
+/*
+ * A plan holds what is needed to transform n values: the twiddle factors
+ * for a power of two, or the chirp and the transformed convolution kernel
+ * for Bluestein's algorithm otherwise.  Plans are cached per size and
+ * reference counted so a plan in use survives cache eviction.
+ */
+typedef struct INFIX(GOFFTPlan,_) PLAN;
+struct INFIX(GOFFTPlan,_) {
+	int ref_count;
+	int n;
+
+	/* Power of two: exp(-2 pi i k / n) for k < n/2.  */
+	COMPLEX *twiddles;
 
-	*fourier = g_new (SUFFIX(go_complex), n);
+	/* Bluestein.  */
+	int m;
+	COMPLEX *chirp;
+	COMPLEX *kernel;
+	PLAN *sub;
+};
 
-	if (n == 1) {
-		(*fourier)[0] = in[0];
+#define FFT_MAX_PLANS 16
+
+static GHashTable *SUFFIX(fft_plans);
+static GMutex SUFFIX(fft_plans_lock);
+
+static void
+SUFFIX(fft_plan_unref) (PLAN *plan)
+{
+	if (!plan || !g_atomic_int_dec_and_test (&plan->ref_count))
 		return;
+
+	g_free (plan->twiddles);
+	g_free (plan->chirp);
+	g_free (plan->kernel);
+	SUFFIX(fft_plan_unref) (plan->sub);
+	g_free (plan);
+}
+
+/*
+ * Unnormalized in-place transform of data[0..n-1] with sign -1 in the
+ * exponent, or +1 if inverse.
+ */
+static void SUFFIX(fft_execute) (PLAN const *plan, COMPLEX *data,
+				 gboolean inverse);
+
+static void
+SUFFIX(fft_execute_pow2) (PLAN const *plan, COMPLEX *data, gboolean inverse)
+{
+	int n = plan->n;
+	int i, j, len;
+
+	/* Bit-reversal permutation.  */
+	for (i = 1, j = 0; i < n; i++) {
+		int bit = n >> 1;
+		for (; j & bit; bit >>= 1)
+			j ^= bit;
+		j ^= bit;
+		if (i < j) {
+			COMPLEX t = data[i];
+			data[i] = data[j];
+			data[j] = t;
+		}
 	}
 
-	SUFFIX(go_fourier_fft) (in, nhalf, skip * 2, &fourier_1, inverse);
-	SUFFIX(go_fourier_fft) (in + skip, nhalf, skip * 2, &fourier_2, inverse);
+	for (len = 2; len <= n; len <<= 1) {
+		int half = len / 2, step = n / len;
+		for (i = 0; i < n; i += len) {
+			COMPLEX *a = data + i, *b = a + half;
+			for (j = 0; j < half; j++) {
+				COMPLEX const *w = plan->twiddles + j * step;
+				DOUBLE wi = inverse ? -w->im : w->im;
+				DOUBLE tre = b[j].re * w->re - b[j].im * wi;
+				DOUBLE tim = b[j].re * wi + b[j].im * w->re;
+				b[j].re = a[j].re - tre;
+				b[j].im = a[j].im - tim;
+				a[j].re += tre;
+				a[j].im += tim;
+			}
+		}
+	}
+}
 
-	argstep = (inverse ? DOUBLE_PI : -DOUBLE_PI) / nhalf;
-	for (i = 0; i < nhalf; i++) {
-		SUFFIX(go_complex) dir, tmp;
+static void
+SUFFIX(fft_execute_bluestein) (PLAN const *plan, COMPLEX *data,
+			       gboolean inverse)
+{
+	int n = plan->n, m = plan->m;
+	COMPLEX *a = g_new0 (COMPLEX, m);
+	DOUBLE sign = inverse ? -1 : 1;
+	int k;
 
-		SUFFIX(go_complex_from_polar) (&dir, 1, argstep * i);
-		SUFFIX(go_complex_mul) (&tmp, &fourier_2[i], &dir);
+	/*
+	 * An inverse transform is a forward transform of the conjugates,
+	 * conjugated.  The conjugation is folded into the loops below.
+	 */
+	for (k = 0; k < n; k++) {
+		COMPLEX const *w = plan->chirp + k;
+		DOUBLE xre = data[k].re, xim = sign * data[k].im;
+		a[k].re = xre * w->re - xim * w->im;
+		a[k].im = xre * w->im + xim * w->re;
+	}
 
-		SUFFIX(go_complex_add) (&((*fourier)[i]), &fourier_1[i], &tmp);
-		SUFFIX(go_complex_scale_real) (&((*fourier)[i]), 0.5);
+	SUFFIX(fft_execute) (plan->sub, a, FALSE);
+	for (k = 0; k < m; k++) {
+		COMPLEX const *b = plan->kernel + k;
+		DOUBLE re = a[k].re * b->re - a[k].im * b->im;
+		DOUBLE im = a[k].re * b->im + a[k].im * b->re;
+		a[k].re = re;
+		a[k].im = im;
+	}
+	SUFFIX(fft_execute) (plan->sub, a, TRUE);
 
-		SUFFIX(go_complex_sub) (&((*fourier)[i + nhalf]), &fourier_1[i], &tmp);
-		SUFFIX(go_complex_scale_real) (&((*fourier)[i + nhalf]), 0.5);
+	for (k = 0; k < n; k++) {
+		COMPLEX const *w = plan->chirp + k;
+		DOUBLE re = (a[k].re * w->re - a[k].im * w->im) / m;
+		DOUBLE im = (a[k].re * w->im + a[k].im * w->re) / m;
+		data[k].re = re;
+		data[k].im = sign * im;
 	}
 
-	g_free (fourier_1);
-	g_free (fourier_2);
+	g_free (a);
 }
 
+static void
+SUFFIX(fft_execute) (PLAN const *plan, COMPLEX *data, gboolean inverse)
+{
+	if (plan->twiddles)
+		SUFFIX(fft_execute_pow2) (plan, data, inverse);
+	else if (plan->chirp)
+		SUFFIX(fft_execute_bluestein) (plan, data, inverse);
+	/* else n == 1: nothing to do.  */
+}
+
+static PLAN *SUFFIX(fft_plan_get) (int n);
+
+static PLAN *
+SUFFIX(fft_plan_new) (int n)
+{
+	PLAN *plan = g_new0 (PLAN, 1);
+	int k;
+
+	plan->ref_count = 1;
+	plan->n = n;
+
+	if (n == 1)
+		return plan;
+
+	if ((n & (n - 1)) == 0) {
+		plan->twiddles = g_new (COMPLEX, n / 2);
+		for (k = 0; k < n / 2; k++)
+			SUFFIX(go_complex_from_polar_pi)
+				(plan->twiddles + k, 1, CONST(-2.) * k / n);
+		return plan;
+	}
+
+	/*
+	 * Bluestein: with w_k = exp(-pi i k^2 / n) the transform is
+	 * w_j * sum_k (x_k w_k) conj(w_{j-k}), a convolution we can do with
+	 * power-of-two transforms of size m >= 2n-1.
+	 */
+	for (plan->m = 1; plan->m < 2 * n - 1; plan->m <<= 1)
+		;
+	plan->sub = SUFFIX(fft_plan_get) (plan->m);
+	plan->chirp = g_new (COMPLEX, n);
+	plan->kernel = g_new0 (COMPLEX, plan->m);
+	for (k = 0; k < n; k++) {
+		/* Reduce k^2 mod 2n to keep the angle exact.  */
+		gint64 k2 = ((gint64)k * k) % (2 * n);
+		SUFFIX(go_complex_from_polar_pi)
+			(plan->chirp + k, 1, -(DOUBLE)k2 / n);
+		plan->kernel[k].re = plan->chirp[k].re;
+		plan->kernel[k].im = -plan->chirp[k].im;
+		if (k > 0)
+			plan->kernel[plan->m - k] = plan->kernel[k];
+	}
+	SUFFIX(fft_execute) (plan->sub, plan->kernel, FALSE);
+
+	return plan;
+}
+
+/* Returns a reference to the plan for n values.  */
+static PLAN *
+SUFFIX(fft_plan_get) (int n)
+{
+	PLAN *plan;
+
+	g_mutex_lock (&SUFFIX(fft_plans_lock));
+	if (!SUFFIX(fft_plans))
+		SUFFIX(fft_plans) = g_hash_table_new_full
+			(NULL, NULL, NULL,
+			 (GDestroyNotify)SUFFIX(fft_plan_unref));
+	plan = g_hash_table_lookup (SUFFIX(fft_plans), GINT_TO_POINTER (n));
+	if (plan)
+		g_atomic_int_inc (&plan->ref_count);
+	g_mutex_unlock (&SUFFIX(fft_plans_lock));
+
+	if (plan)
+		return plan;
+
+	/* Build outside the lock; a Bluestein plan needs a sub-plan.  */
+	plan = SUFFIX(fft_plan_new) (n);
+
+	g_mutex_lock (&SUFFIX(fft_plans_lock));
+	if (g_hash_table_size (SUFFIX(fft_plans)) >= FFT_MAX_PLANS)
+		g_hash_table_remove_all (SUFFIX(fft_plans));
+	g_atomic_int_inc (&plan->ref_count);
+	g_hash_table_replace (SUFFIX(fft_plans), GINT_TO_POINTER (n), plan);
+	g_mutex_unlock (&SUFFIX(fft_plans_lock));
+
+	return plan;
+}
+
+/* Scaled in-place transform of n values.  */
+static void
+SUFFIX(fft_transform) (COMPLEX *data, int n, gboolean inverse)
+{
+	PLAN *plan = SUFFIX(fft_plan_get) (n);
+	int i;
+
+	SUFFIX(fft_execute) (plan, data, inverse);
+	SUFFIX(fft_plan_unref) (plan);
+
+	if (n > 1)
+		for (i = 0; i < n; i++) {
+			data[i].re /= n;
+			data[i].im /= n;
+		}
+}
+
+/**
+ * go_fourier_fft:
+ * @in: (array): input data.
+ * @n: number of values to transform.
+ * @skip: distance between consecutive values in @in.
+ * @fourier: (out) (transfer full) (array length=n): location for the
+ * transformed values.
+ * @inverse: whether to perform the inverse transform.
+ *
+ * Computes the discrete Fourier transform of @n values taken from @in,
+ * scaled by 1/@n.  Any @n works, but powers of two are fastest.  The
+ * twiddle factors are cached per size, so repeated transforms of the
+ * same size are cheap.
+ */
+void
+SUFFIX(go_fourier_fft) (COMPLEX const *in, int n, int skip, COMPLEX **fourier, gboolean inverse)
+{
+	COMPLEX *res;
+	int i;
+
+	g_return_if_fail (n > 0);
+
+	res = *fourier = g_new (COMPLEX, n);
+	for (i = 0; i < n; i++)
+		res[i] = in[i * skip];
+
+	SUFFIX(fft_transform) (res, n, inverse);
+}
+
+/**
+ * go_fourier_fft_real:
+ * @in: (array): input data.
+ * @n: number of values to transform.
+ * @skip: distance between consecutive values in @in.
+ * @fourier: (out) (transfer full) (array length=n): location for the
+ * transformed values.
+ *
+ * Computes the discrete Fourier transform of @n real values taken from
+ * @in, scaled by 1/@n, like go_fourier_fft.  For even @n this packs the
+ * values into a complex transform of half the size.
+ */
+void
+SUFFIX(go_fourier_fft_real) (DOUBLE const *in, int n, int skip, COMPLEX **fourier)
+{
+	PLAN *wplan = NULL;
+	COMPLEX *res, *z, z0;
+	int h = n / 2, k;
+
+	g_return_if_fail (n > 0);
+
+	res = *fourier = g_new (COMPLEX, n);
+
+	if (n & 1) {
+		for (k = 0; k < n; k++) {
+			res[k].re = in[k * skip];
+			res[k].im = 0;
+		}
+		SUFFIX(fft_transform) (res, n, FALSE);
+		return;
+	}
+
+	/* z_k = x_2k + i x_2k+1, transformed in the upper half of res.  */
+	z = res + h;
+	for (k = 0; k < h; k++) {
+		z[k].re = in[2 * k * skip];
+		z[k].im = in[(2 * k + 1) * skip];
+	}
+	SUFFIX(fft_transform) (z, h, FALSE);
+
+	/*
+	 * Untangle: with E and O the transforms of the even and odd values,
+	 * E_k = (z_k + conj z_{h-k}) / 2, O_k = (z_k - conj z_{h-k}) / 2i and
+	 * X_k = E_k + exp(-2 pi i k / n) O_k.  The scaling by 1/h is already
+	 * done, so halve once more.  Only the lower half of res is written
+	 * until all of z has been read.
+	 */
+	if ((n & (n - 1)) == 0)
+		wplan = SUFFIX(fft_plan_get) (n);
+	z0 = z[0];
+	for (k = 1; k < h; k++) {
+		COMPLEX a = z[k], b = z[h - k], w;
+		DOUBLE ere = (a.re + b.re) / 2, eim = (a.im - b.im) / 2;
+		DOUBLE ore = (a.im + b.im) / 2, oim = (b.re - a.re) / 2;
+
+		if (wplan)
+			w = wplan->twiddles[k];
+		else
+			SUFFIX(go_complex_from_polar_pi) (&w, 1, CONST(-2.) * k / n);
+		res[k].re = (ere + ore * w.re - oim * w.im) / 2;
+		res[k].im = (eim + ore * w.im + oim * w.re) / 2;
+	}
+	SUFFIX(fft_plan_unref) (wplan);
+
+	res[0].re = (z0.re + z0.im) / 2;
+	res[0].im = 0;
+	res[h].re = (z0.re - z0.im) / 2;
+	res[h].im = 0;
+	for (k = 1; k < h; k++) {
+		res[n - k].re = res[k].re;
+		res[n - k].im = -res[k].im;
+	}
+}
+
+#undef PLAN
+#undef COMPLEX
+
 /* ------------------------------------------------------------------------- */
 
+#if LAST_INCLUDE_PASS
+/**
+ * _go_fft_shutdown: (skip)
+ */
+void
+_go_fft_shutdown (void)
+{
+	g_clear_pointer (&fft_plans, g_hash_table_destroy);
+#ifdef GOFFICE_WITH_LONG_DOUBLE
+	g_clear_pointer (&fft_plansl, g_hash_table_destroy);
+#endif
+#ifdef GOFFICE_WITH_DECIMAL64
+	g_clear_pointer (&fft_plansD, g_hash_table_destroy);
+#endif
+}
+#endif
+
 // See comments at top
 #endif // SKIP_THIS_PASS
 #if INCLUDE_PASS < INCLUDE_PASS_LAST
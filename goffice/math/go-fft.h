@@ -7,11 +7,15 @@ G_BEGIN_DECLS
 
 void go_fourier_fft (go_complex const *in, int n, int skip,
 		     go_complex **fourier, gboolean inverse);
+void go_fourier_fft_real (double const *in, int n, int skip,
+			  go_complex **fourier);
 
 #ifdef GOFFICE_WITH_LONG_DOUBLE
 
 void go_fourier_fftl (go_complexl const *in, int n, int skip,
 		      go_complexl **fourier, gboolean inverse);
+void go_fourier_fft_reall (long double const *in, int n, int skip,
+			   go_complexl **fourier);
 
 #endif
 
@@ -19,9 +23,14 @@ void go_fourier_fftl (go_complexl const *in, int n, int skip,
 
 void go_fourier_fftD (go_complexD const *in, int n, int skip,
 		      go_complexD **fourier, gboolean inverse);
+void go_fourier_fft_realD (_Decimal64 const *in, int n, int skip,
+			   go_complexD **fourier);
 
 #endif
 
+/* private */
+void _go_fft_shutdown (void);
+
 G_END_DECLS
 
 #endif	/* GOFFICE_FFT_H */
@@ -30,6 +30,7 @@
 #include <signal.h>
 #include <errno.h>
 #include <string.h>
+#include <float.h>
 
 // We need multiple versions of this code.  We're going to include ourself
 // with different settings of various macros.  gdb will hate us.
@@ -670,6 +671,93 @@ STRTO (const char *s, char **end)
 }
 
 #if INCLUDE_PASS == INCLUDE_PASS_DOUBLE
+/*
+ * Clinger's fast path: when the decimal significand fits in 53 bits and
+ * the power of ten is exact as a double, a single correctly rounded
+ * multiplication or division gives the correctly rounded result.  That
+ * covers the bulk of numbers seen in practice, in particular short
+ * data values.  Anything else -- long significands, large exponents,
+ * whitespace, "inf", hex -- is left to the general code.
+ */
+static gboolean
+ascii_strtod_fast (const char *s, char **end, double *res)
+{
+#if defined(FLT_EVAL_METHOD) && FLT_EVAL_METHOD == 0
+	static const double pow10[] = {
+		1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10,
+		1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20,
+		1e21, 1e22
+	};
+	const char *p = s;
+	gboolean neg = FALSE;
+	guint64 m = 0;
+	int ndigits = 0, e = 0, nd;
+	double d;
+
+	if (*p == '-' || *p == '+')
+		neg = (*p++ == '-');
+
+	nd = 0;
+	while (g_ascii_isdigit (*p)) {
+		if (m || *p != '0')
+			ndigits++;
+		m = m * 10 + (*p++ - '0');
+		nd++;
+		if (ndigits > 19)
+			return FALSE;
+	}
+	if (*p == '.') {
+		p++;
+		while (g_ascii_isdigit (*p)) {
+			if (m || *p != '0')
+				ndigits++;
+			m = m * 10 + (*p++ - '0');
+			nd++;
+			e--;
+			if (ndigits > 19)
+				return FALSE;
+		}
+	}
+	if (nd == 0)
+		return FALSE;
+
+	if (*p == 'e' || *p == 'E') {
+		int ee = 0, esign = 1;
+		const char *q = p + 1;
+		if (*q == '-' || *q == '+')
+			esign = (*q++ == '-') ? -1 : 1;
+		if (!g_ascii_isdigit (*q))
+			return FALSE;
+		while (g_ascii_isdigit (*q)) {
+			ee = ee * 10 + (*q++ - '0');
+			if (ee > 1000)
+				return FALSE;
+		}
+		e += esign * ee;
+		p = q;
+	}
+
+	// Leave MS extensions and hex prefixes to the general code.
+	if (*p == 'd' || *p == 'D' || *p == 'x' || *p == 'X')
+		return FALSE;
+
+	if (m > ((guint64)1 << 53) || e < -22 || e > 22)
+		return FALSE;
+
+	d = (double)m;
+	d = e < 0 ? d / pow10[-e] : d * pow10[e];
+
+	errno = 0;
+	if (end)
+		*end = (char *)p;
+	*res = neg ? -d : d;
+	return TRUE;
+#else
+	// Extended-precision intermediates would double round.
+	return FALSE;
+#endif
+}
+
 /**
  * go_ascii_strtod:
  * @s: string to convert
@@ -683,11 +771,15 @@ STRTO (const char *s, char **end)
 double
 go_ascii_strtod (const char *s, char **end)
 {
-	int maxlen = strtod_helper (s);
+	int maxlen;
 	int save_errno;
 	char *tmp;
 	double res;
 
+	if (ascii_strtod_fast (s, end, &res))
+		return res;
+
+	maxlen = strtod_helper (s);
 	if (maxlen == INT_MAX)
 		return g_ascii_strtod (s, end);
 	else if (maxlen < 0) {
@@ -1561,6 +1653,103 @@ SUFFIX(go_reduce_pi) (DOUBLE x, int e, int *k)
 }
 
 
+/* ------------------------------------------------------------------------- */
+
+#define POLYNOMIAL_BLOCK 64
+
+/**
+ * go_polynomial_eval_v:
+ * @a: (array): coefficients, constant term first
+ * @deg: degree of the polynomial, i.e., @a has @deg+1 elements
+ * @x: (array length=n): points
+ * @y: (out) (array length=n): result locations
+ * @n: number of points
+ *
+ * Evaluates the polynomial at @n points using compensated Horner: the
+ * rounding errors of each step are captured with error-free
+ * transformations and added back at the end, so the result is about as
+ * accurate as plain Horner in twice the precision.  That matters for
+ * large x, dates for example, where the terms cancel badly.
+ *
+ * The result for each point does not depend on the other points, so this
+ * is identical to evaluating the points one by one.
+ **/
+void
+SUFFIX(go_polynomial_eval_v) (DOUBLE const *a, int deg,
+			      DOUBLE const *x, DOUBLE *y, int n)
+{
+	DOUBLE r[POLYNOMIAL_BLOCK], e[POLYNOMIAL_BLOCK];
+#if DOUBLE_RADIX == 2
+	DOUBLE cst = 1 + SUFFIX(scalbn) (1, (DOUBLE_MANT_DIG + 1) / 2);
+#endif
+	int i, j, k;
+
+	g_return_if_fail (deg >= 0);
+
+	/*
+	 * The points are done in blocks with the loop over points innermost
+	 * and free of branches so that it can be vectorized.
+	 */
+	for (i = 0; i < n; i += POLYNOMIAL_BLOCK) {
+		int m = MIN (n - i, POLYNOMIAL_BLOCK);
+		DOUBLE const *xb = x + i;
+
+		for (j = 0; j < m; j++) {
+			r[j] = a[deg];
+			e[j] = 0;
+		}
+
+		for (k = deg - 1; k >= 0; k--) {
+			DOUBLE ak = a[k];
+			for (j = 0; j < m; j++) {
+				DOUBLE xj = xb[j], rj = r[j];
+				DOUBLE p, pl, s, sl, bb;
+
+				/* p + pl = rj * xj exactly */
+				p = rj * xj;
+#if INCLUDE_PASS == INCLUDE_PASS_DOUBLE && defined(FP_FAST_FMA)
+				pl = fma (rj, xj, -p);
+#elif DOUBLE_RADIX == 2
+				{
+					/*
+					 * Dekker.  This relies on the compiler
+					 * not contracting into fma.
+					 */
+					DOUBLE c, rh, rl, xh, xl;
+					c = cst * rj;
+					rh = c - (c - rj);
+					rl = rj - rh;
+					c = cst * xj;
+					xh = c - (c - xj);
+					xl = xj - xh;
+					pl = ((rh * xh - p) + rh * xl + rl * xh) + rl * xl;
+				}
+#else
+				/* Dekker needs binary; just compensate the sums.  */
+				pl = 0;
+#endif
+
+				/* s + sl = p + ak exactly (Knuth) */
+				s = p + ak;
+				bb = s - p;
+				sl = (p - (s - bb)) + (ak - bb);
+
+				r[j] = s;
+				e[j] = e[j] * xj + (pl + sl);
+			}
+		}
+
+		for (j = 0; j < m; j++) {
+			DOUBLE res = r[j] + e[j];
+			/* The error terms can overflow before the result does. */
+			y[i + j] = SUFFIX(go_finite) (res) ? res : r[j];
+		}
+	}
+}
+
+#undef POLYNOMIAL_BLOCK
+
+
 /* ------------------------------------------------------------------------- */
 
 
@@ -73,6 +73,9 @@ double expm1 (double x);
 
 double go_reduce_pi (double x, int e, int *k);
 
+void go_polynomial_eval_v (double const *a, int deg,
+			   double const *x, double *y, int n);
+
 /* ------------------------------------------------------------------------- */
 
 #ifdef GOFFICE_WITH_LONG_DOUBLE
@@ -123,6 +126,9 @@ long double modfl (long double x, long double *iptr);
 
 long double go_reduce_pil (long double x, int e, int *k);
 
+void go_polynomial_eval_vl (long double const *a, int deg,
+			    long double const *x, long double *y, int n);
+
 #endif
 
 /* ------------------------------------------------------------------------- */
@@ -159,6 +165,9 @@ _Decimal64 go_atanpiD (_Decimal64 x);
 
 _Decimal64 go_reduce_piD (_Decimal64 x, int e, int *k);
 
+void go_polynomial_eval_vD (_Decimal64 const *a, int deg,
+			    _Decimal64 const *x, _Decimal64 *y, int n);
+
 #endif
 
 /* ------------------------------------------------------------------------- */
@@ -30,16 +30,154 @@
 #include <goffice/goffice-multipass.h>
 #ifndef SKIP_THIS_PASS
 
+#include "go-quad-priv.h"
+
 #define QUAD SUFFIX(GOQuad)
 #define QQR SUFFIX(GOQuadQR)
 #define QMATRIX SUFFIX(GOQuadMatrix)
 
+/*
+ * Column tile width for the kernels below.  A tile of a matrix is stored
+ * as separate planes of high and low parts, row by row.  Every element goes
+ * through the same sequence of quad operations as with the straightforward
+ * loops, so results are bit-identical, but the inner loops run over the
+ * independent columns of a tile.
+ */
+#define QUAD_TILE 32
+
 struct INFIX(GOQuadQR,_) {
-	QMATRIX *V;
+	QMATRIX *VT;	/* The Householder vectors, as rows.  */
 	QMATRIX *R;
 	int qdet;
 };
 
+static void
+SUFFIX(tile_load) (DOUBLE *h, DOUBLE *l, const QMATRIX *A, int j0, int w)
+{
+	int i, r;
+
+	for (i = 0; i < A->m; i++) {
+		const QUAD *Ai = A->data[i] + j0;
+		for (r = 0; r < w; r++) {
+			h[i * w + r] = Ai[r].h;
+			l[i * w + r] = Ai[r].l;
+		}
+	}
+}
+
+static void
+SUFFIX(tile_store) (QMATRIX *A, int j0, int w, const DOUBLE *h, const DOUBLE *l)
+{
+	int i, r;
+
+	for (i = 0; i < A->m; i++) {
+		QUAD *Ai = A->data[i] + j0;
+		for (r = 0; r < w; r++) {
+			Ai[r].h = h[i * w + r];
+			Ai[r].l = l[i * w + r];
+		}
+	}
+}
+
+/*
+ * Solve RT*X=B for a tile of w columns.  B is overwritten by X.  This is
+ * column oriented so we walk R by rows.
+ */
+static gboolean
+SUFFIX(tile_fwd_solve) (const QMATRIX *R, DOUBLE *h, DOUBLE *l, int w,
+			gboolean allow_degenerate)
+{
+	int i, j, r, n = R->n;
+	DOUBLE cst = SUFFIX(go_quad_split_cst) ();
+
+	for (j = 0; j < n; j++) {
+		const QUAD *Rj = R->data[j];
+		DOUBLE *xh = h + j * w, *xl = l + j * w;
+
+		if (SUFFIX(go_quad_value) (&Rj[j]) == 0) {
+			if (!allow_degenerate) {
+				for (i = j * w; i < n * w; i++)
+					h[i] = l[i] = 0;
+				return TRUE;
+			}
+			for (r = 0; r < w; r++)
+				xh[r] = xl[r] = 0;
+		} else {
+			for (r = 0; r < w; r++) {
+				QUAD d, x;
+				d.h = xh[r];
+				d.l = xl[r];
+				SUFFIX(go_quad_div) (&x, &d, &Rj[j]);
+				xh[r] = x.h;
+				xl[r] = x.l;
+			}
+		}
+
+		/* Eliminate x[j] from the remaining equations.  */
+		for (i = j + 1; i < n; i++) {
+			DOUBLE Rh = Rj[i].h, Rl = Rj[i].l;
+			DOUBLE *dh = h + i * w, *dl = l + i * w;
+			for (r = 0; r < w; r++) {
+				DOUBLE ph, pl;
+				SUFFIX(go_quad_mul_hl) (&ph, &pl, Rh, Rl,
+							xh[r], xl[r], cst);
+				SUFFIX(go_quad_sub_hl) (&dh[r], &dl[r],
+							dh[r], dl[r], ph, pl);
+			}
+		}
+	}
+
+	return FALSE;
+}
+
+/* Solve R*X=B for a tile of w columns.  B is overwritten by X.  */
+static gboolean
+SUFFIX(tile_back_solve) (const QMATRIX *R, DOUBLE *h, DOUBLE *l, int w,
+			 gboolean allow_degenerate)
+{
+	int i, j, r, n = R->n;
+	DOUBLE cst = SUFFIX(go_quad_split_cst) ();
+
+	for (i = n - 1; i >= 0; i--) {
+		const QUAD *Ri = R->data[i];
+		DOUBLE *dh = h + i * w, *dl = l + i * w;
+
+		if (SUFFIX(go_quad_value) (&Ri[i]) == 0) {
+			if (!allow_degenerate) {
+				for (j = 0; j < (i + 1) * w; j++)
+					h[j] = l[j] = 0;
+				return TRUE;
+			}
+			for (r = 0; r < w; r++)
+				dh[r] = dl[r] = 0;
+			continue;
+		}
+
+		for (j = i + 1; j < n; j++) {
+			DOUBLE Rh = Ri[j].h, Rl = Ri[j].l;
+			const DOUBLE *xh = h + j * w, *xl = l + j * w;
+			for (r = 0; r < w; r++) {
+				DOUBLE ph, pl;
+				SUFFIX(go_quad_mul_hl) (&ph, &pl, Rh, Rl,
+							xh[r], xl[r], cst);
+				SUFFIX(go_quad_sub_hl) (&dh[r], &dl[r],
+							dh[r], dl[r], ph, pl);
+			}
+		}
+
+		for (r = 0; r < w; r++) {
+			QUAD d, x;
+			d.h = dh[r];
+			d.l = dl[r];
+			SUFFIX(go_quad_div) (&x, &d, &Ri[i]);
+			dh[r] = x.h;
+			dl[r] = x.l;
+		}
+	}
+
+	return FALSE;
+}
+
 
 /**
  * go_quad_matrix_new: (skip)
@@ -62,8 +200,10 @@ SUFFIX(go_quad_matrix_new) (int m, int n)
 	res->n = n;
 	res->data = g_new (QUAD *, m);
 
-	for (i = 0; i < m; i++)
-		res->data[i] = g_new0 (QUAD, n);
+	/* One contiguous block, row by row.  */
+	res->data[0] = g_new0 (QUAD, (gsize)m * n);
+	for (i = 1; i < m; i++)
+		res->data[i] = res->data[0] + (gsize)i * n;
 
 	return res;
 }
@@ -77,10 +217,7 @@ SUFFIX(go_quad_matrix_new) (int m, int n)
 void
 SUFFIX(go_quad_matrix_free) (QMATRIX *A)
 {
-	int i;
-
-	for (i = 0; i < A->m; i++)
-		g_free (A->data[i]);
+	g_free (A->data[0]);
 	g_free (A->data);
 	g_free (A);
 }
@@ -165,7 +302,9 @@ SUFFIX(go_quad_matrix_multiply) (QMATRIX *C,
 				 const QMATRIX *A,
 				 const QMATRIX *B)
 {
-	int i, j, k;
+	int i, j0, k, r, p;
+	DOUBLE *bh, *bl, *ch, *cl;
+	DOUBLE cst;
 
 	g_return_if_fail (C != NULL);
 	g_return_if_fail (A != NULL);
@@ -173,18 +312,49 @@ SUFFIX(go_quad_matrix_multiply) (QMATRIX *C,
 	g_return_if_fail (C->m == A->m && A->n == B->m && B->n == C->n);
 	g_return_if_fail (C != A && C != B);
 
-	for (i = 0; i < C->m; i++) {
-		for (j = 0; j < C->n; j++) {
-			QUAD p, acc = SUFFIX(go_quad_zero);
-			for (k = 0; k < A->n; k++) {
-				SUFFIX(go_quad_mul) (&p,
-						     &A->data[i][k],
-						     &B->data[k][j]);
-				SUFFIX(go_quad_add) (&acc, &acc, &p);
+	p = A->n;
+	cst = SUFFIX(go_quad_split_cst) ();
+	bh = g_new (DOUBLE, 2 * (gsize)p * QUAD_TILE);
+	bl = bh + (gsize)p * QUAD_TILE;
+	ch = g_new (DOUBLE, 2 * QUAD_TILE);
+	cl = ch + QUAD_TILE;
+
+	/*
+	 * For each tile of columns of B, run all rows of A against it.  Each
+	 * row of the tile is a contiguous run of independent products.
+	 */
+	for (j0 = 0; j0 < C->n; j0 += QUAD_TILE) {
+		int w = MIN (QUAD_TILE, C->n - j0);
+
+		SUFFIX(tile_load) (bh, bl, B, j0, w);
+
+		for (i = 0; i < C->m; i++) {
+			const QUAD *Ai = A->data[i];
+
+			for (r = 0; r < w; r++)
+				ch[r] = cl[r] = 0;
+
+			for (k = 0; k < p; k++) {
+				DOUBLE ah = Ai[k].h, al = Ai[k].l;
+				const DOUBLE *bkh = bh + k * w, *bkl = bl + k * w;
+				for (r = 0; r < w; r++) {
+					DOUBLE ph, pl;
+					SUFFIX(go_quad_mul_hl) (&ph, &pl, ah, al,
+								bkh[r], bkl[r], cst);
+					SUFFIX(go_quad_add_hl) (&ch[r], &cl[r],
+								ch[r], cl[r], ph, pl);
+				}
+			}
+
+			for (r = 0; r < w; r++) {
+				C->data[i][j0 + r].h = ch[r];
+				C->data[i][j0 + r].l = cl[r];
 			}
-			C->data[i][j] = acc;
 		}
 	}
+
+	g_free (ch);
+	g_free (bh);
 }
 
 /**
@@ -451,7 +621,9 @@ gboolean
 SUFFIX(go_quad_matrix_fwd_solve) (const QMATRIX *R, QUAD *x, const QUAD *b,
 				  gboolean allow_degenerate)
 {
-	int i, j, n;
+	int i, n;
+	DOUBLE *h, *l;
+	gboolean res;
 
 	g_return_val_if_fail (R != NULL, TRUE);
 	g_return_val_if_fail (R->m == R->n, TRUE);
@@ -459,32 +631,23 @@ SUFFIX(go_quad_matrix_fwd_solve) (const QMATRIX *R, QUAD *x, const QUAD *b,
 	g_return_val_if_fail (b != NULL, TRUE);
 
 	n = R->m;
+	h = g_new (DOUBLE, 2 * n);
+	l = h + n;
 
 	for (i = 0; i < n; i++) {
-		QUAD d = b[i];
-		QUAD Rii = R->data[i][i];
-
-		if (SUFFIX(go_quad_value)(&Rii) == 0) {
-			if (allow_degenerate) {
-				x[i] = SUFFIX(go_quad_zero);
-				continue;
-			} else {
-				while (i < n)
-					x[i++] = SUFFIX(go_quad_zero);
-				return TRUE;
-			}
-		}
+		h[i] = b[i].h;
+		l[i] = b[i].l;
+	}
 
-		for (j = 0; j < i; j++) {
-			QUAD p;
-			SUFFIX(go_quad_mul) (&p, &R->data[j][i], &x[j]);
-			SUFFIX(go_quad_sub) (&d, &d, &p);
-		}
+	res = SUFFIX(tile_fwd_solve) (R, h, l, 1, allow_degenerate);
 
-		SUFFIX(go_quad_div) (&x[i], &d, &Rii);
+	for (i = 0; i < n; i++) {
+		x[i].h = h[i];
+		x[i].l = l[i];
 	}
 
-	return FALSE;
+	g_free (h);
+	return res;
 }
 
 /**
@@ -504,7 +667,9 @@ gboolean
 SUFFIX(go_quad_matrix_back_solve) (const QMATRIX *R, QUAD *x, const QUAD *b,
 				   gboolean allow_degenerate)
 {
-	int i, j, n;
+	int i, n;
+	DOUBLE *h, *l;
+	gboolean res;
 
 	g_return_val_if_fail (R != NULL, TRUE);
 	g_return_val_if_fail (R->m == R->n, TRUE);
@@ -512,32 +677,113 @@ SUFFIX(go_quad_matrix_back_solve) (const QMATRIX *R, QUAD *x, const QUAD *b,
 	g_return_val_if_fail (b != NULL, TRUE);
 
 	n = R->m;
+	h = g_new (DOUBLE, 2 * n);
+	l = h + n;
 
-	for (i = n - 1; i >= 0; i--) {
-		QUAD d = b[i];
-		QUAD Rii = R->data[i][i];
-
-		if (SUFFIX(go_quad_value)(&Rii) == 0) {
-			if (allow_degenerate) {
-				x[i] = SUFFIX(go_quad_zero);
-				continue;
-			} else {
-				while (i >= 0)
-					x[i--] = SUFFIX(go_quad_zero);
-				return TRUE;
-			}
-		}
+	for (i = 0; i < n; i++) {
+		h[i] = b[i].h;
+		l[i] = b[i].l;
+	}
 
-		for (j = i + 1; j < n; j++) {
-			QUAD p;
-			SUFFIX(go_quad_mul) (&p, &R->data[i][j], &x[j]);
-			SUFFIX(go_quad_sub) (&d, &d, &p);
-		}
+	res = SUFFIX(tile_back_solve) (R, h, l, 1, allow_degenerate);
 
-		SUFFIX(go_quad_div) (&x[i], &d, &Rii);
+	for (i = 0; i < n; i++) {
+		x[i].h = h[i];
+		x[i].l = l[i];
 	}
 
-	return FALSE;
+	g_free (h);
+	return res;
+}
+
+static gboolean
+SUFFIX(go_quad_matrix_solve_multi) (const QMATRIX *R, QMATRIX *X,
+				    const QMATRIX *B,
+				    gboolean allow_degenerate,
+				    gboolean fwd)
+{
+	int j0, n = R->m;
+	DOUBLE *h, *l;
+	gboolean res = FALSE;
+
+	h = g_new (DOUBLE, 2 * (gsize)n * QUAD_TILE);
+	l = h + (gsize)n * QUAD_TILE;
+
+	for (j0 = 0; j0 < B->n; j0 += QUAD_TILE) {
+		int w = MIN (QUAD_TILE, B->n - j0);
+
+		SUFFIX(tile_load) (h, l, B, j0, w);
+		if (fwd
+		    ? SUFFIX(tile_fwd_solve) (R, h, l, w, allow_degenerate)
+		    : SUFFIX(tile_back_solve) (R, h, l, w, allow_degenerate))
+			res = TRUE;
+		SUFFIX(tile_store) (X, j0, w, h, l);
+	}
+
+	g_free (h);
+	return res;
+}
+
+/**
+ * go_quad_matrix_fwd_solve_multi:
+ * @R: An upper triangular matrix.
+ * @X: (out): Result matrix.
+ * @B: Input matrix.
+ * @allow_degenerate: If %TRUE, then degenerate dimensions are ignored other
+ * than being given a zero result.  A degenerate dimension is one whose
+ * diagonal entry is zero.
+ *
+ * Returns: %TRUE on error.
+ *
+ * This function solves the triangular system RT*X=B, i.e., it does
+ * go_quad_matrix_fwd_solve for all columns of @B at once, and much faster
+ * than column by column.  @X may be the same matrix as @B.
+ **/
+gboolean
+SUFFIX(go_quad_matrix_fwd_solve_multi) (const QMATRIX *R, QMATRIX *X,
+					const QMATRIX *B,
+					gboolean allow_degenerate)
+{
+	g_return_val_if_fail (R != NULL, TRUE);
+	g_return_val_if_fail (R->m == R->n, TRUE);
+	g_return_val_if_fail (X != NULL, TRUE);
+	g_return_val_if_fail (B != NULL, TRUE);
+	g_return_val_if_fail (B->m == R->m, TRUE);
+	g_return_val_if_fail (X->m == B->m && X->n == B->n, TRUE);
+
+	return SUFFIX(go_quad_matrix_solve_multi) (R, X, B,
+						   allow_degenerate, TRUE);
+}
+
+/**
+ * go_quad_matrix_back_solve_multi:
+ * @R: An upper triangular matrix.
+ * @X: (out): Result matrix.
+ * @B: Input matrix.
+ * @allow_degenerate: If %TRUE, then degenerate dimensions are ignored other
+ * than being given a zero result.  A degenerate dimension is one whose
+ * diagonal entry is zero.
+ *
+ * Returns: %TRUE on error.
+ *
+ * This function solves the triangular system R*X=B, i.e., it does
+ * go_quad_matrix_back_solve for all columns of @B at once, and much faster
+ * than column by column.  @X may be the same matrix as @B.
+ **/
+gboolean
+SUFFIX(go_quad_matrix_back_solve_multi) (const QMATRIX *R, QMATRIX *X,
+					 const QMATRIX *B,
+					 gboolean allow_degenerate)
+{
+	g_return_val_if_fail (R != NULL, TRUE);
+	g_return_val_if_fail (R->m == R->n, TRUE);
+	g_return_val_if_fail (X != NULL, TRUE);
+	g_return_val_if_fail (B != NULL, TRUE);
+	g_return_val_if_fail (B->m == R->m, TRUE);
+	g_return_val_if_fail (X->m == B->m && X->n == B->n, TRUE);
+
+	return SUFFIX(go_quad_matrix_solve_multi) (R, X, B,
+						   allow_degenerate, FALSE);
 }
 
 /**
@@ -614,18 +860,20 @@ SUFFIX(go_quad_qr_new) (const QMATRIX *A)
 	QQR *qr;
 	int qdet = 1;
 	QMATRIX *R;
-	QMATRIX *V;
+	QMATRIX *VT;
 	int i, j, k, m, n;
 	QUAD *tmp;
+	DOUBLE cst;
 
 	g_return_val_if_fail (A != NULL, NULL);
 	g_return_val_if_fail (A->m >= A->n, NULL);
 
 	m = A->m;
 	n = A->n;
+	cst = SUFFIX(go_quad_split_cst) ();
 
 	qr = g_new (QQR, 1);
-	V = qr->V = SUFFIX(go_quad_matrix_new) (m, n);
+	VT = qr->VT = SUFFIX(go_quad_matrix_new) (n, m);
 	qr->R = SUFFIX(go_quad_matrix_new) (n, n);
 
 	/* Temporary m-by-n version of R.  */
@@ -635,21 +883,22 @@ SUFFIX(go_quad_qr_new) (const QMATRIX *A)
 
 	for (k = 0; k < n; k++) {
 		QUAD L, L2 = SUFFIX(go_quad_zero), L2p = L2, s;
+		QUAD *v = VT->data[k];
 
 		for (i = m - 1; i >= k; i--) {
-			V->data[i][k] = R->data[i][k];
-			SUFFIX(go_quad_mul)(&s, &V->data[i][k], &V->data[i][k]);
+			v[i] = R->data[i][k];
+			SUFFIX(go_quad_mul)(&s, &v[i], &v[i]);
 			L2p = L2;
 			SUFFIX(go_quad_add)(&L2, &L2, &s);
 		}
 		SUFFIX(go_quad_sqrt)(&L, &L2);
 
-		(SUFFIX(go_quad_value)(&V->data[k][k]) < 0
+		(SUFFIX(go_quad_value)(&v[k]) < 0
 		 ? SUFFIX(go_quad_sub)
-		 : SUFFIX(go_quad_add)) (&V->data[k][k], &V->data[k][k], &L);
+		 : SUFFIX(go_quad_add)) (&v[k], &v[k], &L);
 
 		/* Normalize v[k] to length 1.  */
-		SUFFIX(go_quad_mul)(&s, &V->data[k][k], &V->data[k][k]);
+		SUFFIX(go_quad_mul)(&s, &v[k], &v[k]);
 		SUFFIX(go_quad_add)(&L2p, &L2p, &s);
 		SUFFIX(go_quad_sqrt)(&L, &L2p);
 		if (SUFFIX(go_quad_value)(&L) == 0) {
@@ -657,28 +906,39 @@ SUFFIX(go_quad_qr_new) (const QMATRIX *A)
 			continue;
 		}
 		for (i = k; i < m; i++)
-			SUFFIX(go_quad_div)(&V->data[i][k], &V->data[i][k], &L);
+			SUFFIX(go_quad_div)(&v[i], &v[i], &L);
 
 		/* Householder matrices have determinant -1.  */
 		qdet = -qdet;
 
-		/* Calculate tmp = v[k]^t * R[k:m,k:n] */
-		for (j = k; j < n; j++) {
+		/*
+		 * Calculate tmp = v[k]^t * R[k:m,k:n]
+		 *
+		 * We go through R by rows; each tmp[j] still sums in order.
+		 */
+		for (j = k; j < n; j++)
 			tmp[j] = SUFFIX(go_quad_zero);
-			for (i = k ; i < m; i++) {
-				QUAD p;
-				SUFFIX(go_quad_mul) (&p, &V->data[i][k], &R->data[i][j]);
-				SUFFIX(go_quad_add) (&tmp[j], &tmp[j], &p);
+		for (i = k ; i < m; i++) {
+			const QUAD *Ri = R->data[i];
+			for (j = k; j < n; j++) {
+				DOUBLE ph, pl;
+				SUFFIX(go_quad_mul_hl) (&ph, &pl, v[i].h, v[i].l,
+							Ri[j].h, Ri[j].l, cst);
+				SUFFIX(go_quad_add_hl) (&tmp[j].h, &tmp[j].l,
+							tmp[j].h, tmp[j].l, ph, pl);
 			}
 		}
 
 		/* R[k:m,k:n] -= v[k] * tmp */
-		for (j = k; j < n; j++) {
-			for (i = k; i < m; i++) {
-				QUAD p;
-				SUFFIX(go_quad_mul) (&p, &V->data[i][k], &tmp[j]);
-				SUFFIX(go_quad_add) (&p, &p, &p);
-				SUFFIX(go_quad_sub) (&R->data[i][j], &R->data[i][j], &p);
+		for (i = k; i < m; i++) {
+			QUAD *Ri = R->data[i];
+			for (j = k; j < n; j++) {
+				DOUBLE ph, pl;
+				SUFFIX(go_quad_mul_hl) (&ph, &pl, v[i].h, v[i].l,
+							tmp[j].h, tmp[j].l, cst);
+				SUFFIX(go_quad_add_hl) (&ph, &pl, ph, pl, ph, pl);
+				SUFFIX(go_quad_sub_hl) (&Ri[j].h, &Ri[j].l,
+							Ri[j].h, Ri[j].l, ph, pl);
 			}
 		}
 
@@ -711,7 +971,7 @@ SUFFIX(go_quad_qr_free) (QQR *qr)
 {
 	g_return_if_fail (qr != NULL);
 
-	SUFFIX(go_quad_matrix_free) (qr->V);
+	SUFFIX(go_quad_matrix_free) (qr->VT);
 	SUFFIX(go_quad_matrix_free) (qr->R);
 	g_free (qr);
 }
@@ -763,20 +1023,25 @@ void
 SUFFIX(go_quad_qr_multiply_qt) (const QQR *qr, QUAD *x)
 {
 	int i, k;
-	QMATRIX *V = qr->V;
+	const QMATRIX *VT = qr->VT;
+	DOUBLE cst = SUFFIX(go_quad_split_cst) ();
 
-	for (k = 0; k < V->n; k++) {
+	for (k = 0; k < VT->m; k++) {
+		const QUAD *v = VT->data[k];
 		QUAD s = SUFFIX(go_quad_zero);
-		for (i = k; i < V->m; i++) {
-			QUAD p;
-			SUFFIX(go_quad_mul) (&p, &x[i], &V->data[i][k]);
-			SUFFIX(go_quad_add) (&s, &s, &p);
+		for (i = k; i < VT->n; i++) {
+			DOUBLE ph, pl;
+			SUFFIX(go_quad_mul_hl) (&ph, &pl, x[i].h, x[i].l,
+						v[i].h, v[i].l, cst);
+			SUFFIX(go_quad_add_hl) (&s.h, &s.l, s.h, s.l, ph, pl);
 		}
 		SUFFIX(go_quad_add) (&s, &s, &s);
-		for (i = k; i < V->m; i++) {
-			QUAD p;
-			SUFFIX(go_quad_mul) (&p, &s, &V->data[i][k]);
-			SUFFIX(go_quad_sub) (&x[i], &x[i], &p);
+		for (i = k; i < VT->n; i++) {
+			DOUBLE ph, pl;
+			SUFFIX(go_quad_mul_hl) (&ph, &pl, s.h, s.l,
+						v[i].h, v[i].l, cst);
+			SUFFIX(go_quad_sub_hl) (&x[i].h, &x[i].l,
+						x[i].h, x[i].l, ph, pl);
 		}
 	}
 }
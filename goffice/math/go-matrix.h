@@ -35,6 +35,12 @@ gboolean go_quad_matrix_back_solve (const GOQuadMatrix *R, GOQuad *x,
 gboolean go_quad_matrix_fwd_solve (const GOQuadMatrix *R, GOQuad *x,
 				   const GOQuad *b,
 				   gboolean allow_degenerate);
+gboolean go_quad_matrix_back_solve_multi (const GOQuadMatrix *R, GOQuadMatrix *X,
+					  const GOQuadMatrix *B,
+					  gboolean allow_degenerate);
+gboolean go_quad_matrix_fwd_solve_multi (const GOQuadMatrix *R, GOQuadMatrix *X,
+					 const GOQuadMatrix *B,
+					 gboolean allow_degenerate);
 
 void go_quad_matrix_eigen_range (const GOQuadMatrix *A,
 				 double *emin, double *emax);
@@ -83,6 +89,12 @@ gboolean go_quad_matrix_back_solvel (const GOQuadMatrixl *R, GOQuadl *x,
 gboolean go_quad_matrix_fwd_solvel (const GOQuadMatrixl *R, GOQuadl *x,
 				    const GOQuadl *b,
 				    gboolean allow_degenerate);
+gboolean go_quad_matrix_back_solve_multil (const GOQuadMatrixl *R, GOQuadMatrixl *X,
+					   const GOQuadMatrixl *B,
+					   gboolean allow_degenerate);
+gboolean go_quad_matrix_fwd_solve_multil (const GOQuadMatrixl *R, GOQuadMatrixl *X,
+					  const GOQuadMatrixl *B,
+					  gboolean allow_degenerate);
 
 void go_quad_matrix_eigen_rangel (const GOQuadMatrixl *A,
 				  long double *emin, long double *emax);
@@ -133,6 +145,12 @@ gboolean go_quad_matrix_back_solveD (const GOQuadMatrixD *R, GOQuadD *x,
 gboolean go_quad_matrix_fwd_solveD (const GOQuadMatrixD *R, GOQuadD *x,
 				    const GOQuadD *b,
 				    gboolean allow_degenerate);
+gboolean go_quad_matrix_back_solve_multiD (const GOQuadMatrixD *R, GOQuadMatrixD *X,
+					   const GOQuadMatrixD *B,
+					   gboolean allow_degenerate);
+gboolean go_quad_matrix_fwd_solve_multiD (const GOQuadMatrixD *R, GOQuadMatrixD *X,
+					  const GOQuadMatrixD *B,
+					  gboolean allow_degenerate);
 
 void go_quad_matrix_eigen_rangeD (const GOQuadMatrixD *A,
 				  _Decimal64 *emin, _Decimal64 *emax);
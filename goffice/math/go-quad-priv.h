@@ -0,0 +1,99 @@
+// There should be no include guard for this file
+
+// Inline versions of the basic GOQuad operations.  This is included from
+// within the multipass files after goffice-multipass.h, i.e., once per
+// number system.
+//
+// The operations take the high and low parts as separate values so array
+// code can keep them in separate planes; with everything visible to the
+// compiler, loops of them over independent elements can be vectorized.
+// go_quad_add, go_quad_mul, etc., are defined in terms of these, so such
+// code gives bit-identical results to the scalar functions.
+//
+// Both arms of every choice are computed up front and only then selected.
+// That costs a few extra flops, but it lets a compiler that may ignore fp
+// traps, e.g., with -fno-trapping-math, turn the choice into a blend and
+// vectorize loops over these operations.
+//
+// As for go-quad.c itself, these must be used within go_quad_start and
+// go_quad_end.
+
+// The splitting constant for go_quad_mul12_hl.
+static inline DOUBLE
+SUFFIX(go_quad_split_cst) (void)
+{
+	return 1 + SUFFIX(scalbn) (1, (DOUBLE_MANT_DIG + 1) / 2);
+}
+
+static inline void
+SUFFIX(go_quad_add_hl) (DOUBLE *rh, DOUBLE *rl,
+			DOUBLE ah, DOUBLE al, DOUBLE bh, DOUBLE bl)
+{
+	DOUBLE r = ah + bh;
+	DOUBLE s1 = ah - r + bh + bl + al;
+	DOUBLE s2 = bh - r + ah + al + bl;
+	DOUBLE s = SUFFIX(fabs) (ah) > SUFFIX(fabs) (bh) ? s1 : s2;
+	DOUBLE h = r + s;
+	*rh = h;
+	*rl = r - h + s;
+}
+
+static inline void
+SUFFIX(go_quad_sub_hl) (DOUBLE *rh, DOUBLE *rl,
+			DOUBLE ah, DOUBLE al, DOUBLE bh, DOUBLE bl)
+{
+	DOUBLE r = ah - bh;
+	DOUBLE s1 = +ah - r - bh - bl + al;
+	DOUBLE s2 = -bh - r + ah + al - bl;
+	DOUBLE s = SUFFIX(fabs) (ah) > SUFFIX(fabs) (bh) ? s1 : s2;
+	DOUBLE h = r + s;
+	*rh = h;
+	*rl = r - h + s;
+}
+
+static inline void
+SUFFIX(go_quad_split_hl) (DOUBLE *h, DOUBLE *t, DOUBLE x, DOUBLE cst)
+{
+	DOUBLE p = x * cst, xh, s, si;
+	// Scale down to avoid overflow in the split.  Scaling by 1 when
+	// that is not needed changes nothing.
+	gboolean big = !(SUFFIX(fabs) (p) <= DOUBLE_MAX) &&
+		SUFFIX(fabs) (x) <= DOUBLE_MAX;
+	s = big ? DOUBLE_EPSILON : 1;
+	si = big ? 1 / DOUBLE_EPSILON : 1;
+	x *= s;
+	p = x * cst;
+	xh = x - p + p;
+	*h = xh * si;
+	*t = (x - xh) * si;
+}
+
+static inline void
+SUFFIX(go_quad_mul12_hl) (DOUBLE *rh, DOUBLE *rl, DOUBLE x, DOUBLE y,
+			  DOUBLE cst)
+{
+	DOUBLE hx, tx, hy, ty, p, q, h;
+
+	SUFFIX(go_quad_split_hl) (&hx, &tx, x, cst);
+	SUFFIX(go_quad_split_hl) (&hy, &ty, y, cst);
+
+	p = hx * hy;
+	q = hx * ty + tx * hy;
+	h = p + q;
+	*rh = h;
+	*rl = p - h + q + tx * ty;
+}
+
+static inline void
+SUFFIX(go_quad_mul_hl) (DOUBLE *rh, DOUBLE *rl,
+			DOUBLE ah, DOUBLE al, DOUBLE bh, DOUBLE bl,
+			DOUBLE cst)
+{
+	DOUBLE ch, cl, h;
+
+	SUFFIX(go_quad_mul12_hl) (&ch, &cl, ah, bh, cst);
+	cl = ah * bl + al * bh + cl;
+	h = ch + cl;
+	*rh = h;
+	*rl = ch - h + cl;
+}
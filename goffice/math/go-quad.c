@@ -55,6 +55,8 @@
 #include <goffice/goffice-multipass.h>
 #ifndef SKIP_THIS_PASS
 
+#include "go-quad-priv.h"
+
 /*
  * Not SUFFIX(isnan): that pastes to isnanl, a glibc extension.  C99's
  * isnan() covers float, double and long double alike, but has no decimal
@@ -249,7 +251,7 @@ SUFFIX(go_quad_start) (void)
 	if (first) {
 		DOUBLE base = (DOUBLE_RADIX == 2 ? 256 : 100);
 		first = FALSE;
-		SUFFIX(CST) = 1 + SUFFIX(scalbn) (1, (DOUBLE_MANT_DIG + 1) / 2);
+		SUFFIX(CST) = SUFFIX(go_quad_split_cst) ();
 		SUFFIX(go_quad_constant8) (&SUFFIX(go_quad_pi),
 					   SUFFIX(pi_digits),
 					   G_N_ELEMENTS (SUFFIX(pi_digits)),
@@ -392,12 +394,7 @@ SUFFIX(go_quad_value) (const QUAD *a)
 void
 SUFFIX(go_quad_add) (QUAD *res, const QUAD *a, const QUAD *b)
 {
-	DOUBLE r = a->h + b->h;
-	DOUBLE s = SUFFIX(fabs) (a->h) > SUFFIX(fabs) (b->h)
-		? a->h - r + b->h + b->l + a->l
-		: b->h - r + a->h + a->l + b->l;
-	res->h = r + s;
-	res->l = r - res->h + s;
+	SUFFIX(go_quad_add_hl) (&res->h, &res->l, a->h, a->l, b->h, b->l);
 
 #ifdef MIGHT_NEED_FPU_SETUP
 	g_return_if_fail (SUFFIX(go_quad_depth) > 0);
@@ -415,30 +412,9 @@ SUFFIX(go_quad_add) (QUAD *res, const QUAD *a, const QUAD *b)
 void
 SUFFIX(go_quad_sub) (QUAD *res, const QUAD *a, const QUAD *b)
 {
-	DOUBLE r = a->h - b->h;
-	DOUBLE s = SUFFIX(fabs) (a->h) > SUFFIX(fabs) (b->h)
-		? +a->h - r - b->h - b->l + a->l
-		: -b->h - r + a->h + a->l - b->l;
-	res->h = r + s;
-	res->l = r - res->h + s;
+	SUFFIX(go_quad_sub_hl) (&res->h, &res->l, a->h, a->l, b->h, b->l);
 }
 
-
-#define SPLIT1(x,h,t) do {				\
-  DOUBLE p = x * SUFFIX(CST);				\
-  if (!SUFFIX(go_finite) (p) && SUFFIX(go_finite)(x)) {	\
-     x *= DOUBLE_EPSILON;				\
-     p = x * SUFFIX(CST);				\
-     h = x - p + p;					\
-     t = x - h;						\
-     h *= (1 / DOUBLE_EPSILON);				\
-     t *= (1 / DOUBLE_EPSILON);				\
-  } else {						\
-     h = x - p + p;					\
-     t = x - h;						\
-  }							\
-} while (0)
-
 /**
  * go_quad_mul12:
  * @res: (out): result location
@@ -451,20 +427,9 @@ SUFFIX(go_quad_sub) (QUAD *res, const QUAD *a, const QUAD *b)
 void
 SUFFIX(go_quad_mul12) (QUAD *res, DOUBLE x, DOUBLE y)
 {
-	DOUBLE hx, tx, hy, ty, p, q;
-
-	SPLIT1 (x, hx, tx);
-	SPLIT1 (y, hy, ty);
-
-	p = hx * hy;
-	q = hx * ty + tx * hy;
-	res->h = p + q;
-	res->l = p - res->h + q + tx * ty;
+	SUFFIX(go_quad_mul12_hl) (&res->h, &res->l, x, y, SUFFIX(CST));
 }
 
-#undef SPLIT1
-
-
 /**
  * go_quad_mul:
  * @res: (out): result location
@@ -476,11 +441,8 @@ SUFFIX(go_quad_mul12) (QUAD *res, DOUBLE x, DOUBLE y)
 void
 SUFFIX(go_quad_mul) (QUAD *res, const QUAD *a, const QUAD *b)
 {
-	QUAD c;
-	SUFFIX(go_quad_mul12) (&c, a->h, b->h);
-	c.l = a->h * b->l + a->l * b->h + c.l;
-	res->h = c.h + c.l;
-	res->l = c.h - res->h + c.l;
+	SUFFIX(go_quad_mul_hl) (&res->h, &res->l, a->h, a->l, b->h, b->l,
+				SUFFIX(CST));
 }
 
 /**
@@ -615,11 +577,96 @@ void
 SUFFIX(go_quad_dot_product) (QUAD *res, const QUAD *a, const QUAD *b, int n)
 {
 	int i;
-	SUFFIX(go_quad_init) (res, 0);
+	DOUBLE rh = 0, rl = 0;
 	for (i = 0; i < n; i++) {
-		QUAD d;
-		SUFFIX(go_quad_mul) (&d, &a[i], &b[i]);
-		SUFFIX(go_quad_add) (res, res, &d);
+		DOUBLE dh, dl;
+		SUFFIX(go_quad_mul_hl) (&dh, &dl, a[i].h, a[i].l, b[i].h, b[i].l,
+					SUFFIX(CST));
+		SUFFIX(go_quad_add_hl) (&rh, &rl, rh, rl, dh, dl);
+	}
+	res->h = rh;
+	res->l = rl;
+}
+
+#define QUAD_LANES 32
+
+/**
+ * go_quad_dot_product_v:
+ * @res: (out) (array length=m): result locations
+ * @a: (array length=n): vector of quad-precision values
+ * @b: (array): n-by-m matrix of quad-precision values stored by rows
+ * @n: length of @a.
+ * @m: number of columns of @b.
+ *
+ * This function computes the dot products of @a with each of the columns
+ * of @b, storing them in @res.  The results are identical to calling
+ * go_quad_dot_product for each column, but the columns are handled side
+ * by side which is a good deal faster.
+ **/
+void
+SUFFIX(go_quad_dot_product_v) (QUAD *res, const QUAD *a, const QUAD *b,
+			       int n, int m)
+{
+	DOUBLE rh[QUAD_LANES], rl[QUAD_LANES];
+	DOUBLE cst = SUFFIX(CST);
+	int i, j, j0;
+
+#ifdef MIGHT_NEED_FPU_SETUP
+	g_return_if_fail (SUFFIX(go_quad_depth) > 0);
+#endif
+
+	for (j0 = 0; j0 < m; j0 += QUAD_LANES) {
+		int w = MIN (QUAD_LANES, m - j0);
+
+		for (j = 0; j < w; j++)
+			rh[j] = rl[j] = 0;
+
+		for (i = 0; i < n; i++) {
+			DOUBLE ah = a[i].h, al = a[i].l;
+			const QUAD *bi = b + (gsize)i * m + j0;
+			for (j = 0; j < w; j++) {
+				DOUBLE dh, dl;
+				SUFFIX(go_quad_mul_hl) (&dh, &dl, ah, al,
+							bi[j].h, bi[j].l, cst);
+				SUFFIX(go_quad_add_hl) (&rh[j], &rl[j],
+							rh[j], rl[j], dh, dl);
+			}
+		}
+
+		for (j = 0; j < w; j++) {
+			res[j0 + j].h = rh[j];
+			res[j0 + j].l = rl[j];
+		}
+	}
+}
+
+#undef QUAD_LANES
+
+/**
+ * go_quad_axpy_v:
+ * @y: (array length=n) (inout): vector of quad-precision values
+ * @a: quad-precision value
+ * @x: (array length=n): vector of quad-precision values
+ * @n: length of vectors.
+ *
+ * This function adds @a times @x to @y.  The results are identical to
+ * using go_quad_mul and go_quad_add for each element.
+ **/
+void
+SUFFIX(go_quad_axpy_v) (QUAD *y, const QUAD *a, const QUAD *x, int n)
+{
+	DOUBLE ah = a->h, al = a->l;
+	DOUBLE cst = SUFFIX(CST);
+	int i;
+
+#ifdef MIGHT_NEED_FPU_SETUP
+	g_return_if_fail (SUFFIX(go_quad_depth) > 0);
+#endif
+
+	for (i = 0; i < n; i++) {
+		DOUBLE dh, dl;
+		SUFFIX(go_quad_mul_hl) (&dh, &dl, ah, al, x[i].h, x[i].l, cst);
+		SUFFIX(go_quad_add_hl) (&y[i].h, &y[i].l, y[i].h, y[i].l, dh, dl);
 	}
 }
 
@@ -44,6 +44,9 @@ void go_quad_atan2pi (GOQuad *res, const GOQuad *y, const GOQuad *x);
 void go_quad_mul12 (GOQuad *res, double x, double y);
 
 void go_quad_dot_product (GOQuad *res, const GOQuad *a, const GOQuad *b, int n);
+void go_quad_dot_product_v (GOQuad *res, const GOQuad *a, const GOQuad *b,
+			    int n, int m);
+void go_quad_axpy_v (GOQuad *y, const GOQuad *a, const GOQuad *x, int n);
 
 void go_quad_constant8 (GOQuad *res, const guint8 *data, gsize n, double base, double scale);
 
@@ -104,6 +107,9 @@ void go_quad_mul12l (GOQuadl *res, long double x, long double y);
 
 void go_quad_dot_productl (GOQuadl *res,
 			   const GOQuadl *a, const GOQuadl *b, int n);
+void go_quad_dot_product_vl (GOQuadl *res, const GOQuadl *a, const GOQuadl *b,
+			     int n, int m);
+void go_quad_axpy_vl (GOQuadl *y, const GOQuadl *a, const GOQuadl *x, int n);
 
 void go_quad_constant8l (GOQuadl *res, const guint8 *data, gsize n, long double base, long double scale);
 
@@ -162,6 +168,9 @@ void go_quad_mul12D (GOQuadD *res, _Decimal64 x, _Decimal64 y);
 
 void go_quad_dot_productD (GOQuadD *res,
 			   const GOQuadD *a, const GOQuadD *b, int n);
+void go_quad_dot_product_vD (GOQuadD *res, const GOQuadD *a, const GOQuadD *b,
+			     int n, int m);
+void go_quad_axpy_vD (GOQuadD *y, const GOQuadD *a, const GOQuadD *x, int n);
 
 void go_quad_constant8D (GOQuadD *res, const guint8 *data, gsize n, _Decimal64 base, _Decimal64 scale);
 
@@ -25,6 +25,7 @@
 #include <goffice/goffice.h>
 
 #include <math.h>
+#include <float.h>
 #include <stdlib.h>
 #include <string.h>
 
@@ -35,17 +36,97 @@
 
 /* ------------------------------------------------------------------------- */
 
-static SUFFIX(GOAccumulator)*
-SUFFIX(sum_helper) (DOUBLE const *xs, int n)
+#include "go-accumulator-priv.h"
+
+/*
+ * Exact summation with the partials on the stack.  This is GOAccumulator
+ * without the GArray.  Ordinary data need only a few partials, but values
+ * with widely spread exponents can need more than fit here.  The partials
+ * then move to a real GOAccumulator, so the sum is still exact.
+ */
+#define SUM_STACK_PARTIALS 16
+
+typedef struct {
+	unsigned len;
+	DOUBLE partials[SUM_STACK_PARTIALS];
+	SUFFIX(GOAccumulator) *acc;	/* used once the partials overflow */
+} SUFFIX(GORangeSum);
+
+static void
+SUFFIX(range_sum_init) (SUFFIX(GORangeSum) *s)
+{
+	s->len = 0;
+	s->acc = NULL;
+}
+
+static void
+SUFFIX(range_sum_clear) (SUFFIX(GORangeSum) *s)
+{
+	if (s->acc)
+		SUFFIX(go_accumulator_free) (s->acc);
+	SUFFIX(range_sum_init) (s);
+}
+
+static void
+SUFFIX(range_sum_spill) (SUFFIX(GORangeSum) *s)
 {
-	SUFFIX(GOAccumulator) *acc = SUFFIX(go_accumulator_new) ();
+	unsigned ui;
+
+	s->acc = SUFFIX(go_accumulator_new) ();
+	for (ui = 0; ui < s->len; ui++)
+		SUFFIX(go_accumulator_add) (s->acc, s->partials[ui]);
+	s->len = 0;
+}
+
+static inline void
+SUFFIX(range_sum_add) (SUFFIX(GORangeSum) *s, DOUBLE x)
+{
+	if (G_UNLIKELY (s->len == SUM_STACK_PARTIALS))
+		SUFFIX(range_sum_spill) (s);
+	if (G_UNLIKELY (s->acc != NULL))
+		SUFFIX(go_accumulator_add) (s->acc, x);
+	else
+		s->len = SUFFIX(go_accumulator_add_partials)
+			(s->partials, s->len, x);
+}
+
+/* Adds other to s and clears other.  */
+static void
+SUFFIX(range_sum_merge) (SUFFIX(GORangeSum) *s, SUFFIX(GORangeSum) *other)
+{
+	unsigned ui;
+
+	if (other->acc) {
+		if (!s->acc)
+			SUFFIX(range_sum_spill) (s);
+		SUFFIX(go_accumulator_merge) (s->acc, other->acc);
+	} else {
+		for (ui = 0; ui < other->len; ui++)
+			SUFFIX(range_sum_add) (s, other->partials[ui]);
+	}
+	SUFFIX(range_sum_clear) (other);
+}
+
+static DOUBLE
+SUFFIX(range_sum_value) (SUFFIX(GORangeSum) const *s)
+{
+	return s->acc
+		? SUFFIX(go_accumulator_value) (s->acc)
+		: SUFFIX(go_accumulator_round) (s->partials, s->len);
+}
+
+static void
+SUFFIX(range_sum_helper) (SUFFIX(GORangeSum) *s, DOUBLE const *xs, int n)
+{
+	SUFFIX(range_sum_init) (s);
 	while (n > 0) {
 		n--;
-		SUFFIX(go_accumulator_add) (acc, xs[n]);
+		SUFFIX(range_sum_add) (s, xs[n]);
 	}
-	return acc;
 }
 
+#undef SUM_STACK_PARTIALS
+
 /**
  * go_range_sum:
  * @xs: (array length=n): values.
@@ -60,13 +141,90 @@ int
 SUFFIX(go_range_sum) (DOUBLE const *xs, int n, DOUBLE *res)
 {
 	void *state = SUFFIX(go_accumulator_start) ();
-	SUFFIX(GOAccumulator) *acc = SUFFIX(sum_helper) (xs, n);
-	*res = SUFFIX(go_accumulator_value) (acc);
-	SUFFIX(go_accumulator_free) (acc);
+	SUFFIX(GORangeSum) s;
+	SUFFIX(range_sum_helper) (&s, xs, n);
+	*res = SUFFIX(range_sum_value) (&s);
+	SUFFIX(range_sum_clear) (&s);
+	SUFFIX(go_accumulator_end) (state);
+	return 0;
+}
+
+/*
+ * Below this many values per thread it is not worth the trouble of
+ * going parallel.
+ */
+#define SUM_PARALLEL_CHUNK 65536
+
+typedef struct {
+	DOUBLE const *xs;
+	int n;
+	SUFFIX(GORangeSum) s;
+} SUFFIX(GORangeSumJob);
+
+static void
+SUFFIX(range_sum_job) (SUFFIX(GORangeSumJob) *job, G_GNUC_UNUSED gpointer user)
+{
+	void *state = SUFFIX(go_accumulator_start) ();
+	SUFFIX(range_sum_helper) (&job->s, job->xs, job->n);
+	SUFFIX(go_accumulator_end) (state);
+}
+
+/**
+ * go_range_sum_parallel:
+ * @xs: (array length=n): values.
+ * @n: number of values
+ * @res: (out): result.
+ *
+ * The arithmetic sum of the input values will be stored in @res.  Large
+ * ranges are split across threads whose partial sums are merged exactly,
+ * so the result is the same as that of go_range_sum.
+ *
+ * Returns: 0 unless an error occurred.
+ */
+int
+SUFFIX(go_range_sum_parallel) (DOUBLE const *xs, int n, DOUBLE *res)
+{
+	int nthreads = MIN ((int)g_get_num_processors (),
+			    n / SUM_PARALLEL_CHUNK);
+	SUFFIX(GORangeSumJob) *jobs;
+	GThreadPool *pool;
+	void *state;
+	int i;
+
+	if (nthreads <= 1)
+		return SUFFIX(go_range_sum) (xs, n, res);
+
+	/*
+	 * A non-exclusive pool borrows glib's shared threads.  Freeing it
+	 * with wait_ set is how we wait for the jobs to finish.
+	 */
+	jobs = g_new (SUFFIX(GORangeSumJob), nthreads);
+	pool = g_thread_pool_new ((GFunc)SUFFIX(range_sum_job), NULL,
+				  nthreads - 1, FALSE, NULL);
+	for (i = 0; i < nthreads; i++) {
+		int start = (gint64)n * i / nthreads;
+		int end = (gint64)n * (i + 1) / nthreads;
+		jobs[i].xs = xs + start;
+		jobs[i].n = end - start;
+		if (i > 0)
+			g_thread_pool_push (pool, jobs + i, NULL);
+	}
+	SUFFIX(range_sum_job) (jobs, NULL);
+	g_thread_pool_free (pool, FALSE, TRUE);
+
+	state = SUFFIX(go_accumulator_start) ();
+	for (i = 1; i < nthreads; i++)
+		SUFFIX(range_sum_merge) (&jobs[0].s, &jobs[i].s);
+	*res = SUFFIX(range_sum_value) (&jobs[0].s);
+	SUFFIX(range_sum_clear) (&jobs[0].s);
 	SUFFIX(go_accumulator_end) (state);
+
+	g_free (jobs);
 	return 0;
 }
 
+#undef SUM_PARALLEL_CHUNK
+
 /**
  * go_range_sumsq:
  * @xs: (array length=n): values.
@@ -82,15 +240,17 @@ int
 SUFFIX(go_range_sumsq) (DOUBLE const *xs, int n, DOUBLE *res)
 {
 	void *state = SUFFIX(go_accumulator_start) ();
-	SUFFIX(GOAccumulator) *acc = SUFFIX(go_accumulator_new) ();
+	SUFFIX(GORangeSum) s;
+	SUFFIX(range_sum_init) (&s);
 	while (n > 0) {
 		DOUBLE x = xs[--n];
 		SUFFIX(GOQuad) q;
 		SUFFIX(go_quad_mul12) (&q, x, x);
-		SUFFIX(go_accumulator_add_quad) (acc, &q);
+		SUFFIX(range_sum_add) (&s, q.h);
+		SUFFIX(range_sum_add) (&s, q.l);
 	}
-	*res = SUFFIX(go_accumulator_value) (acc);
-	SUFFIX(go_accumulator_free) (acc);
+	*res = SUFFIX(range_sum_value) (&s);
+	SUFFIX(range_sum_clear) (&s);
 	SUFFIX(go_accumulator_end) (state);
 	return 0;
 }
@@ -220,20 +380,19 @@ SUFFIX(go_range_devsq) (DOUBLE const *xs, int n, DOUBLE *res)
 		*res = 0;
 	else {
 		void *state;
-		SUFFIX(GOAccumulator) *acc;
-		DOUBLE sum, sumh, suml;
+		SUFFIX(GORangeSum) s;
+		DOUBLE sumh, suml;
 		SUFFIX(GOQuad) qavg, qtmp, qn;
 
 		state = SUFFIX(go_accumulator_start) ();
-		acc = SUFFIX(sum_helper) (xs, n);
-		sumh = SUFFIX(go_accumulator_value) (acc);
-		SUFFIX(go_accumulator_add) (acc, -sumh);
-		suml = SUFFIX(go_accumulator_value) (acc);
+		SUFFIX(range_sum_helper) (&s, xs, n);
+		sumh = SUFFIX(range_sum_value) (&s);
+		SUFFIX(range_sum_add) (&s, -sumh);
+		suml = SUFFIX(range_sum_value) (&s);
 
 		SUFFIX(go_quad_init) (&qavg, sumh);
 		SUFFIX(go_quad_init) (&qtmp, suml);
 		SUFFIX(go_quad_add) (&qavg, &qavg, &qtmp);
-		SUFFIX(go_range_sum) (xs, n, &sum);
 		SUFFIX(go_quad_init) (&qn, n);
 		SUFFIX(go_quad_div) (&qavg, &qavg, &qn);
 		/*
@@ -242,17 +401,18 @@ SUFFIX(go_range_devsq) (DOUBLE const *xs, int n, DOUBLE *res)
 		 * enough.
 		 */
 
-		SUFFIX(go_accumulator_clear) (acc);
+		SUFFIX(range_sum_clear) (&s);
 		while (n > 0) {
 			SUFFIX(GOQuad) q;
 			n--;
 			SUFFIX(go_quad_init) (&q, xs[n]);
 			SUFFIX(go_quad_sub) (&q, &q, &qavg);
 			SUFFIX(go_quad_mul) (&q, &q, &q);
-			SUFFIX(go_accumulator_add_quad) (acc, &q);
+			SUFFIX(range_sum_add) (&s, q.h);
+			SUFFIX(range_sum_add) (&s, q.l);
 		}
-		*res = SUFFIX(go_accumulator_value) (acc);
-		SUFFIX(go_accumulator_free) (acc);
+		*res = SUFFIX(range_sum_value) (&s);
+		SUFFIX(range_sum_clear) (&s);
 		SUFFIX(go_accumulator_end) (state);
 	}
 	return 0;
@@ -334,6 +494,154 @@ SUFFIX(go_range_fractile_inter_sorted) (DOUBLE const *xs, int n, DOUBLE *res, DO
 	return 0;
 }
 
+/*
+ * Rearrange xs[lo..hi] such that xs[k] is in its sorted position for each
+ * of the ranks ks[0..nk-1], which must be increasing and within [lo,hi].
+ * Everything before such xs[k] is <= xs[k] and everything after is >=.
+ * This is quickselect with median-of-three pivots that only recurses into
+ * the parts that contain wanted ranks, falling back to qsort if the
+ * pivots turn out badly too often.
+ */
+static void
+SUFFIX(range_select) (DOUBLE *xs, int lo, int hi,
+		      int const *ks, int nk, int depth)
+{
+	while (nk > 0) {
+		DOUBLE pivot;
+		int i, j, mid, nleft, first;
+
+		if (hi - lo < 16 || depth-- <= 0) {
+			qsort (xs + lo, hi - lo + 1, sizeof (xs[0]),
+			       (int (*) (const void *, const void *))&SUFFIX(float_compare));
+			return;
+		}
+
+		mid = lo + (hi - lo) / 2;
+		if (xs[mid] < xs[lo]) { DOUBLE t = xs[mid]; xs[mid] = xs[lo]; xs[lo] = t; }
+		if (xs[hi] < xs[lo]) { DOUBLE t = xs[hi]; xs[hi] = xs[lo]; xs[lo] = t; }
+		if (xs[hi] < xs[mid]) { DOUBLE t = xs[hi]; xs[hi] = xs[mid]; xs[mid] = t; }
+		pivot = xs[mid];
+
+		i = lo;
+		j = hi;
+		while (i <= j) {
+			while (xs[i] < pivot)
+				i++;
+			while (xs[j] > pivot)
+				j--;
+			if (i <= j) {
+				DOUBLE t = xs[i];
+				xs[i] = xs[j];
+				xs[j] = t;
+				i++;
+				j--;
+			}
+		}
+
+		/*
+		 * Now xs[lo..j] <= pivot <= xs[i..hi] and anything in between
+		 * equals pivot and is therefore in place.
+		 */
+		for (nleft = 0; nleft < nk && ks[nleft] <= j; nleft++)
+			;
+		for (first = nleft; first < nk && ks[first] < i; first++)
+			;
+
+		SUFFIX(range_select) (xs, lo, j, ks, nleft, depth);
+		ks += first;
+		nk -= first;
+		lo = i;
+	}
+}
+
+/**
+ * go_range_fractiles_nonconst:
+ * @xs: (array length=n): values.
+ * @n: number of values
+ * @res: (out) (array length=nf): results.
+ * @fs: (array length=nf): fractiles
+ * @nf: number of fractiles
+ *
+ * This function computes the interpolated fractiles given by @fs and
+ * stores them in @res.  This takes time proportional to @n rather than
+ * sorting @xs.
+ * This function reorders the elements of @xs: the order statistics
+ * used end up in their sorted positions with smaller values before and
+ * larger values after each of them.
+ *
+ * Returns: 0 unless an error occurred.
+ */
+int
+SUFFIX(go_range_fractiles_nonconst) (DOUBLE *xs, int n, DOUBLE *res,
+				     DOUBLE const *fs, int nf)
+{
+	int *ks, nk = 0, i, depth;
+
+	if (n <= 0)
+		return 1;
+	for (i = 0; i < nf; i++)
+		if (!(fs[i] >= 0 && fs[i] <= 1))
+			return 1;
+
+	/* The ranks needed, sorted and without duplicates.  */
+	ks = g_new (int, 2 * nf);
+	for (i = 0; i < nf; i++) {
+		DOUBLE fpos = (n - 1) * fs[i];
+		int pos = (int)fpos, r;
+		for (r = pos; r <= pos + 1 && r < n; r++) {
+			int l = nk;
+			while (l > 0 && ks[l - 1] > r)
+				l--;
+			if (l == 0 || ks[l - 1] != r) {
+				memmove (ks + l + 1, ks + l, (nk - l) * sizeof (int));
+				ks[l] = r;
+				nk++;
+			}
+			if (fpos == pos)
+				break;
+		}
+	}
+
+	for (depth = 0, i = n; i > 0; i >>= 1)
+		depth += 2;
+	SUFFIX(range_select) (xs, 0, n - 1, ks, nk, depth);
+	g_free (ks);
+
+	for (i = 0; i < nf; i++)
+		SUFFIX(go_range_fractile_inter_sorted) (xs, n, res + i, fs[i]);
+
+	return 0;
+}
+
+/**
+ * go_range_fractiles:
+ * @xs: (array length=n): values.
+ * @n: number of values
+ * @res: (out) (array length=nf): results.
+ * @fs: (array length=nf): fractiles
+ * @nf: number of fractiles
+ *
+ * This function computes the interpolated fractiles given by @fs and
+ * stores them in @res.
+ *
+ * Returns: 0 unless an error occurred.
+ */
+int
+SUFFIX(go_range_fractiles) (DOUBLE const *xs, int n, DOUBLE *res,
+			    DOUBLE const *fs, int nf)
+{
+	DOUBLE *ys;
+	int error;
+
+	if (n <= 0)
+		return 1;
+
+	ys = go_memdup_n (xs, n, sizeof (DOUBLE));
+	error = SUFFIX(go_range_fractiles_nonconst) (ys, n, res, fs, nf);
+	g_free (ys);
+	return error;
+}
+
 /**
  * go_range_fractile_inter:
  * @xs: (array length=n): values.
@@ -349,10 +657,7 @@ SUFFIX(go_range_fractile_inter_sorted) (DOUBLE const *xs, int n, DOUBLE *res, DO
 int
 SUFFIX(go_range_fractile_inter) (DOUBLE const *xs, int n, DOUBLE *res, DOUBLE f)
 {
-	DOUBLE *ys = SUFFIX(go_range_sort) (xs, n);
-	int error = SUFFIX(go_range_fractile_inter_sorted) (ys, n, res, f);
-	g_free (ys);
-	return error;
+	return SUFFIX(go_range_fractiles) (xs, n, res, &f, 1);
 }
 
 /**
@@ -372,8 +677,7 @@ SUFFIX(go_range_fractile_inter) (DOUBLE const *xs, int n, DOUBLE *res, DOUBLE f)
 int
 SUFFIX(go_range_fractile_inter_nonconst) (DOUBLE *xs, int n, DOUBLE *res, DOUBLE f)
 {
-	qsort (xs, n, sizeof (xs[0]), (int (*) (const void *, const void *))&SUFFIX(float_compare));
-	return SUFFIX(go_range_fractile_inter_sorted) (xs, n, res, f);
+	return SUFFIX(go_range_fractiles_nonconst) (xs, n, res, &f, 1);
 }
 
 /**
@@ -5,6 +5,7 @@
 G_BEGIN_DECLS
 
 int go_range_sum (double const *xs, int n, double *res);
+int go_range_sum_parallel (double const *xs, int n, double *res);
 int go_range_sumsq (double const *xs, int n, double *res);
 int go_range_average (double const *xs, int n, double *res);
 int go_range_min (double const *xs, int n, double *res);
@@ -14,6 +15,8 @@ int go_range_devsq (double const *xs, int n, double *res);
 int go_range_fractile_inter (double const *xs, int n, double *res, double f);
 int go_range_fractile_inter_nonconst (double *xs, int n, double *res, double f);
 int go_range_fractile_inter_sorted (double const *xs, int n, double *res, double f);
+int go_range_fractiles (double const *xs, int n, double *res, double const *fs, int nf);
+int go_range_fractiles_nonconst (double *xs, int n, double *res, double const *fs, int nf);
 int go_range_median_inter (double const *xs, int n, double *res);
 int go_range_median_inter_nonconst (double *xs, int n, double *res);
 int go_range_median_inter_sorted (double const *xs, int n, double *res);
@@ -25,6 +28,7 @@ double *go_range_sort (double const *xs, int n);
 
 #ifdef GOFFICE_WITH_LONG_DOUBLE
 int go_range_suml (long double const *xs, int n, long double *res);
+int go_range_sum_parallell (long double const *xs, int n, long double *res);
 int go_range_sumsql (long double const *xs, int n, long double *res);
 int go_range_averagel (long double const *xs, int n, long double *res);
 int go_range_minl (long double const *xs, int n, long double *res);
@@ -34,6 +38,8 @@ int go_range_devsql (long double const *xs, int n, long double *res);
 int go_range_fractile_interl (long double const *xs, int n, long double *res, long double f);
 int go_range_fractile_inter_nonconstl (long double *xs, int n, long double *res, long double f);
 int go_range_fractile_inter_sortedl (long double const *xs, int n, long double *res, long double f);
+int go_range_fractilesl (long double const *xs, int n, long double *res, long double const *fs, int nf);
+int go_range_fractiles_nonconstl (long double *xs, int n, long double *res, long double const *fs, int nf);
 int go_range_median_interl (long double const *xs, int n, long double *res);
 int go_range_median_inter_nonconstl (long double *xs, int n, long double *res);
 int go_range_median_inter_sortedl (long double const *xs, int n, long double *res);
@@ -46,6 +52,7 @@ long double *go_range_sortl (long double const *xs, int n);
 
 #ifdef GOFFICE_WITH_DECIMAL64
 int go_range_sumD (_Decimal64 const *xs, int n, _Decimal64 *res);
+int go_range_sum_parallelD (_Decimal64 const *xs, int n, _Decimal64 *res);
 int go_range_sumsqD (_Decimal64 const *xs, int n, _Decimal64 *res);
 int go_range_averageD (_Decimal64 const *xs, int n, _Decimal64 *res);
 int go_range_minD (_Decimal64 const *xs, int n, _Decimal64 *res);
@@ -55,6 +62,8 @@ int go_range_devsqD (_Decimal64 const *xs, int n, _Decimal64 *res);
 int go_range_fractile_interD (_Decimal64 const *xs, int n, _Decimal64 *res, _Decimal64 f);
 int go_range_fractile_inter_nonconstD (_Decimal64 *xs, int n, _Decimal64 *res, _Decimal64 f);
 int go_range_fractile_inter_sortedD (_Decimal64 const *xs, int n, _Decimal64 *res, _Decimal64 f);
+int go_range_fractilesD (_Decimal64 const *xs, int n, _Decimal64 *res, _Decimal64 const *fs, int nf);
+int go_range_fractiles_nonconstD (_Decimal64 *xs, int n, _Decimal64 *res, _Decimal64 const *fs, int nf);
 int go_range_median_interD (_Decimal64 const *xs, int n, _Decimal64 *res);
 int go_range_median_inter_nonconstD (_Decimal64 *xs, int n, _Decimal64 *res);
 int go_range_median_inter_sortedD (_Decimal64 const *xs, int n, _Decimal64 *res);
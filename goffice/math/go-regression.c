@@ -483,6 +483,282 @@ SUFFIX(calc_scale) (const DOUBLE *xs, int m)
 
 /* ------------------------------------------------------------------------- */
 
+/*
+ * Below this many matrix elements the GOQuad factorization is cheap
+ * enough that the fast path below is not worth it.
+ */
+#define FAST_QR_MIN_SIZE 1024
+
+/*
+ * Apply the reflectors of fast_qr_solve to v (of length m): Q^T v if
+ * transpose, otherwise Q v.  Reflector k is I - tau[k] u u^T, with
+ * u = (0,...,0,1,a[k*m+k+1],...,a[k*m+m-1]).
+ */
+static void
+SUFFIX(fast_qr_apply) (const DOUBLE *a, const DOUBLE *tau, int m, int n,
+		       DOUBLE *v, gboolean transpose)
+{
+	int i, k;
+
+	for (k = 0; k < n; k++) {
+		int kk = transpose ? k : n - 1 - k;
+		const DOUBLE *u = a + (gsize)kk * m;
+		DOUBLE s = v[kk];
+
+		for (i = kk + 1; i < m; i++)
+			s += u[i] * v[i];
+		s *= tau[kk];
+		v[kk] -= s;
+		for (i = kk + 1; i < m; i++)
+			v[i] -= s * u[i];
+	}
+}
+
+/*
+ * Least squares solution of xss * x = ys, where xss is given transposed
+ * and is to be scaled by xscale.  The matrix is factored by Householder
+ * QR in plain DOUBLE and the solution is then refined by Bjorck's
+ * method on the augmented system
+ *
+ *     [ I  X ] [ r ]   [ y ]
+ *     [ X' 0 ] [ x ] = [ 0 ]
+ *
+ * with the residuals of both equations computed in GOQuad.  The refined
+ * solution is as accurate as that of the all-GOQuad factorization as
+ * long as the problem is not close to degenerate.
+ *
+ * Returns R as a GOQuadMatrix for the benefit of the statistics, or NULL
+ * if the matrix is too badly conditioned for this to work.  In that case
+ * the caller must do things the slow way.
+ */
+static SUFFIX(GOQuadMatrix) *
+SUFFIX(fast_qr_solve) (CONSTMATRIX xssT, const DOUBLE *xscale,
+		       const DOUBLE *ys, int m, int n, QUAD *qresult)
+{
+	SUFFIX(GOQuadMatrix) *R = NULL;
+	DOUBLE *a = g_new (DOUBLE, (gsize)m * n);
+	DOUBLE *tau = g_new (DOUBLE, n);
+	DOUBLE *f = g_new (DOUBLE, m);
+	DOUBLE *g = g_new (DOUBLE, n);
+	QUAD *rr = g_new (QUAD, m);
+	DOUBLE emin = SUFFIX(go_pinf), emax = 0;
+	int i, j, k, step;
+
+	/* Columns are contiguous.  */
+	for (j = 0; j < n; j++)
+		for (i = 0; i < m; i++)
+			a[(gsize)j * m + i] = xssT[j][i] / xscale[j];
+
+	for (k = 0; k < n; k++) {
+		DOUBLE *ak = a + (gsize)k * m;
+		DOUBLE norm2 = 0, beta, d;
+
+		for (i = k; i < m; i++)
+			norm2 += ak[i] * ak[i];
+		if (!(norm2 > 0))
+			goto out;
+		beta = SUFFIX(sqrt) (norm2);
+		if (ak[k] > 0)
+			beta = -beta;
+
+		tau[k] = (beta - ak[k]) / beta;
+		d = 1 / (ak[k] - beta);
+		for (i = k + 1; i < m; i++)
+			ak[i] *= d;
+		ak[k] = beta;
+
+		for (j = k + 1; j < n; j++) {
+			DOUBLE *aj = a + (gsize)j * m;
+			DOUBLE s = aj[k];
+			for (i = k + 1; i < m; i++)
+				s += ak[i] * aj[i];
+			s *= tau[k];
+			aj[k] -= s;
+			for (i = k + 1; i < m; i++)
+				aj[i] -= s * ak[i];
+		}
+
+		emin = MIN (emin, SUFFIX(fabs) (beta));
+		emax = MAX (emax, SUFFIX(fabs) (beta));
+	}
+
+	/*
+	 * Refinement converges roughly like cond(X) * epsilon per step, so
+	 * leave anything close to degenerate to the GOQuad code.  The ratio
+	 * of the diagonal elements of R is only an estimate of cond(X),
+	 * hence the safety margin.
+	 */
+	if (!(emin >= emax * SUFFIX(sqrt) (DOUBLE_EPSILON)))
+		goto out;
+
+	for (j = 0; j < n; j++)
+		qresult[j] = SUFFIX(go_quad_zero);
+	for (i = 0; i < m; i++)
+		rr[i] = SUFFIX(go_quad_zero);
+
+	/*
+	 * The first step, starting from r = x = 0, yields the plain DOUBLE
+	 * solution.  The following two refine it.
+	 */
+	for (step = 0; step < 3; step++) {
+		/* f = y - r - X x  and  g = -X' r, in GOQuad.  */
+		for (i = 0; i < m; i++) {
+			QUAD acc, p, xij;
+			SUFFIX(go_quad_init) (&acc, ys[i]);
+			SUFFIX(go_quad_sub) (&acc, &acc, &rr[i]);
+			for (j = 0; j < n; j++) {
+				SUFFIX(go_quad_init) (&xij, xssT[j][i] / xscale[j]);
+				SUFFIX(go_quad_mul) (&p, &xij, &qresult[j]);
+				SUFFIX(go_quad_sub) (&acc, &acc, &p);
+			}
+			f[i] = SUFFIX(go_quad_value) (&acc);
+		}
+		for (j = 0; j < n; j++) {
+			QUAD acc = SUFFIX(go_quad_zero), p, xij;
+			for (i = 0; i < m; i++) {
+				SUFFIX(go_quad_init) (&xij, xssT[j][i] / xscale[j]);
+				SUFFIX(go_quad_mul) (&p, &xij, &rr[i]);
+				SUFFIX(go_quad_sub) (&acc, &acc, &p);
+			}
+			g[j] = SUFFIX(go_quad_value) (&acc);
+		}
+
+		/* h = R'^-1 g, stored in g.  */
+		for (j = 0; j < n; j++) {
+			DOUBLE s = g[j];
+			for (k = 0; k < j; k++)
+				s -= a[(gsize)j * m + k] * g[k];
+			g[j] = s / a[(gsize)j * m + j];
+		}
+
+		/* d = Q' f;  dx = R^-1 (d1 - h);  dr = Q (h, d2).  */
+		SUFFIX(fast_qr_apply) (a, tau, m, n, f, TRUE);
+		for (j = n - 1; j >= 0; j--) {
+			DOUBLE s = f[j] - g[j];
+			QUAD q;
+			for (k = j + 1; k < n; k++)
+				s -= a[(gsize)k * m + j] * f[k];
+			f[j] = s / a[(gsize)j * m + j];
+			SUFFIX(go_quad_init) (&q, f[j]);
+			SUFFIX(go_quad_add) (&qresult[j], &qresult[j], &q);
+		}
+		for (j = 0; j < n; j++)
+			f[j] = g[j];
+		SUFFIX(fast_qr_apply) (a, tau, m, n, f, FALSE);
+		for (i = 0; i < m; i++) {
+			QUAD q;
+			SUFFIX(go_quad_init) (&q, f[i]);
+			SUFFIX(go_quad_add) (&rr[i], &rr[i], &q);
+		}
+	}
+
+	R = SUFFIX(go_quad_matrix_new) (n, n);
+	for (i = 0; i < n; i++)
+		for (j = 0; j < n; j++)
+			SUFFIX(go_quad_init) (&R->data[i][j],
+					      j < i ? 0 : a[(gsize)j * m + i]);
+
+out:
+	g_free (a);
+	g_free (tau);
+	g_free (f);
+	g_free (g);
+	g_free (rr);
+	return R;
+}
+
+/* ------------------------------------------------------------------------- */
+
+/*
+ * Fill in the remaining statistics from ss_total and ss_resid.  R is the
+ * triangular factor for the x-vectors scaled by xscale with degenerate
+ * dimensions marked.
+ */
+static GORegressionResult
+SUFFIX(linear_regression_stats) (const SUFFIX(GOQuadMatrix) *R,
+				 const DOUBLE *xscale, const DOUBLE *result,
+				 int n, int m, int df_resid, int df_reg,
+				 SUFFIX(go_regression_stat_t) *stat_)
+{
+	GORegressionResult regerr = GO_REG_ok;
+	QUAD *inv = g_new (QUAD, n);
+	QUAD N2;
+	int i, k;
+
+	stat_->sqr_r = (stat_->ss_total == 0)
+		? 1
+		: 1 - stat_->ss_resid / stat_->ss_total;
+	if (stat_->sqr_r < 0) {
+		/*
+		 * This is an indication that something has gone wrong
+		 * numerically.
+		 */
+		regerr = GO_REG_near_singular_bad;
+	}
+
+	/* FIXME: we want to guard against division by zero.  */
+	stat_->adj_sqr_r = 1 - stat_->ss_resid * (m - 1) /
+		(df_resid * stat_->ss_total);
+	if (df_resid == 0)
+		N2 = SUFFIX(go_quad_zero);
+	else {
+		QUAD d;
+		SUFFIX(go_quad_init) (&d, df_resid);
+		SUFFIX(go_quad_init) (&N2, stat_->ss_resid);
+		SUFFIX(go_quad_div) (&N2, &N2, &d);
+	}
+	stat_->var = SUFFIX(go_quad_value) (&N2);
+
+	stat_->se = g_new0 (DOUBLE, n);
+	for (k = 0; k < n; k++) {
+		QUAD p, N;
+
+		/* inv = e_k */
+		for (i = 0; i < n; i++)
+			SUFFIX(go_quad_init) (&inv[i], i == k ? 1 : 0);
+
+		/* Solve R^T inv = e_k */
+		if (SUFFIX(go_quad_matrix_fwd_solve) (R, inv, inv, TRUE)) {
+			regerr = GO_REG_singular;
+			break;
+		}
+
+		SUFFIX(go_quad_dot_product) (&N, inv, inv, n);
+		SUFFIX(go_quad_mul) (&p, &N2, &N);
+		SUFFIX(go_quad_sqrt) (&p, &p);
+		stat_->se[k] = SUFFIX(go_quad_value) (&p) / xscale[k];
+	}
+
+	stat_->t = g_new (DOUBLE, n);
+
+	for (i = 0; i < n; i++)
+		stat_->t[i] = (stat_->se[i] == 0)
+			? SUFFIX(go_pinf)
+			: result[i] / stat_->se[i];
+
+	stat_->df_resid = df_resid;
+	stat_->df_reg = df_reg;
+	stat_->df_total = stat_->df_resid + df_reg;
+
+	stat_->F = (stat_->sqr_r == 1)
+		? SUFFIX(go_pinf)
+		: ((stat_->sqr_r / df_reg) /
+		   (1 - stat_->sqr_r) * stat_->df_resid);
+
+	stat_->ss_reg =  stat_->ss_total - stat_->ss_resid;
+	stat_->se_y = SUFFIX(sqrt) (stat_->ss_total / m);
+	stat_->ms_reg = (df_reg == 0)
+		? 0
+		: stat_->ss_reg / stat_->df_reg;
+	stat_->ms_resid = (df_resid == 0)
+		? 0
+		: stat_->ss_resid / df_resid;
+
+	g_free (inv);
+
+	return regerr;
+}
+
 /* Note, that this function takes a transposed matrix xssT.  */
 static GORegressionResult
 SUFFIX(general_linear_regression) (CONSTMATRIX xssT, int n,
@@ -493,14 +769,15 @@ SUFFIX(general_linear_regression) (CONSTMATRIX xssT, int n,
 				   DOUBLE threshold)
 {
 	GORegressionResult regerr;
-	SUFFIX(GOQuadMatrix) *xss;
+	SUFFIX(GOQuadMatrix) *xss, *fastR;
+	const SUFFIX(GOQuadMatrix) *R;
 	SUFFIX(GOQuadQR) *qr;
-	int i, j, k;
+	QUAD *qresult;
+	int i, j;
 	gboolean has_result;
 	void *state;
 	gboolean has_stat;
 	int err;
-	QUAD N2;
 	DOUBLE *xscale;
 	gboolean debug_scale = FALSE;
 
@@ -518,53 +795,67 @@ SUFFIX(general_linear_regression) (CONSTMATRIX xssT, int n,
 	state = SUFFIX(go_quad_start) ();
 
 	xscale = g_new (DOUBLE, n);
-	xss = SUFFIX(go_quad_matrix_new) (m, n);
 	for (j = 0; j < n; j++) {
 		xscale[j] = SUFFIX(calc_scale) (xssT[j], m);
 		if (debug_scale)
 			g_printerr ("Scale %d: %" FORMAT_g "\n", j, xscale[j]);
-		for (i = 0; i < m; i++)
-			SUFFIX(go_quad_init) (&xss->data[i][j], xssT[j][i] / xscale[j]);
 	}
-	qr = SUFFIX(go_quad_qr_new) (xss);
-	SUFFIX(go_quad_matrix_free) (xss);
 
-	has_result = (qr != NULL);
+	qresult = g_new0 (QUAD, n);
+	qr = NULL;
+	R = fastR = ((gint64)m * n >= FAST_QR_MIN_SIZE)
+		? SUFFIX(fast_qr_solve) (xssT, xscale, ys, m, n, qresult)
+		: NULL;
+
+	if (fastR == NULL) {
+		xss = SUFFIX(go_quad_matrix_new) (m, n);
+		for (j = 0; j < n; j++)
+			for (i = 0; i < m; i++)
+				SUFFIX(go_quad_init) (&xss->data[i][j], xssT[j][i] / xscale[j]);
+		qr = SUFFIX(go_quad_qr_new) (xss);
+		SUFFIX(go_quad_matrix_free) (xss);
+		if (qr)
+			R = SUFFIX(go_quad_qr_r) (qr);
+	}
+
+	has_result = (R != NULL);
 
 	if (has_result) {
-		const SUFFIX(GOQuadMatrix) *R = SUFFIX(go_quad_qr_r) (qr);
-		QUAD *qresult = g_new0 (QUAD, n);
-		QUAD *QTy = g_new (QUAD, m);
-		QUAD *inv = g_new (QUAD, n);
 		DOUBLE emax;
 		int df_resid = m - n;
 		int df_reg = n - (affine ? 1 : 0);
 
 		regerr = GO_REG_ok;
 
-		SUFFIX(go_quad_matrix_eigen_range) (R, NULL, &emax);
-		for (i = 0; i < n; i++) {
-			DOUBLE ei = SUFFIX(go_quad_value)(&R->data[i][i]);
-			gboolean degenerate =
-				!(SUFFIX(fabs)(ei) >= emax * threshold);
-			if (degenerate) {
-				SUFFIX(go_quad_qr_mark_degenerate) (qr, i);
-				df_resid++;
-				df_reg--;
+		if (qr) {
+			QUAD *QTy = g_new (QUAD, m);
+
+			SUFFIX(go_quad_matrix_eigen_range) (R, NULL, &emax);
+			for (i = 0; i < n; i++) {
+				DOUBLE ei = SUFFIX(go_quad_value)(&R->data[i][i]);
+				gboolean degenerate =
+					!(SUFFIX(fabs)(ei) >= emax * threshold);
+				if (degenerate) {
+					SUFFIX(go_quad_qr_mark_degenerate) (qr, i);
+					df_resid++;
+					df_reg--;
+				}
 			}
-		}
 
-		/* Compute Q^T ys.  */
-		for (i = 0; i < m; i++)
-			SUFFIX(go_quad_init)(&QTy[i], ys[i]);
-		SUFFIX(go_quad_qr_multiply_qt)(qr, QTy);
+			/* Compute Q^T ys.  */
+			for (i = 0; i < m; i++)
+				SUFFIX(go_quad_init)(&QTy[i], ys[i]);
+			SUFFIX(go_quad_qr_multiply_qt)(qr, QTy);
 
-		if (0)
-			SUFFIX(go_quad_matrix_dump) (R, "%10.5" FORMAT_g);
+			if (0)
+				SUFFIX(go_quad_matrix_dump) (R, "%10.5" FORMAT_g);
 
-		/* Solve R res = Q^T ys */
-		if (SUFFIX(go_quad_matrix_back_solve) (R, qresult, QTy, TRUE))
-			has_result = FALSE;
+			/* Solve R res = Q^T ys */
+			if (SUFFIX(go_quad_matrix_back_solve) (R, qresult, QTy, TRUE))
+				has_result = FALSE;
+
+			g_free (QTy);
+		}
 
 		for (i = 0; i < n; i++)
 			result[i] = SUFFIX(go_quad_value) (&qresult[i]) / xscale[i];
@@ -591,84 +882,16 @@ SUFFIX(general_linear_regression) (CONSTMATRIX xssT, int n,
 		stat_->ss_resid =
 			SUFFIX(calc_residual) (xssT, ys, m, n, result);
 
-		stat_->sqr_r = (stat_->ss_total == 0)
-			? 1
-			: 1 - stat_->ss_resid / stat_->ss_total;
-		if (stat_->sqr_r < 0) {
-			/*
-			 * This is an indication that something has gone wrong
-			 * numerically.
-			 */
-			regerr = GO_REG_near_singular_bad;
-		}
-
-		/* FIXME: we want to guard against division by zero.  */
-		stat_->adj_sqr_r = 1 - stat_->ss_resid * (m - 1) /
-			(df_resid * stat_->ss_total);
-		if (df_resid == 0)
-			N2 = SUFFIX(go_quad_zero);
-		else {
-			QUAD d;
-			SUFFIX(go_quad_init) (&d, df_resid);
-			SUFFIX(go_quad_init) (&N2, stat_->ss_resid);
-			SUFFIX(go_quad_div) (&N2, &N2, &d);
-		}
-		stat_->var = SUFFIX(go_quad_value) (&N2);
-
-		stat_->se = g_new0 (DOUBLE, n);
-		for (k = 0; k < n; k++) {
-			QUAD p, N;
-
-			/* inv = e_k */
-			for (i = 0; i < n; i++)
-				SUFFIX(go_quad_init) (&inv[i], i == k ? 1 : 0);
-
-			/* Solve R^T inv = e_k */
-			if (SUFFIX(go_quad_matrix_fwd_solve) (R, inv, inv, TRUE)) {
-				regerr = GO_REG_singular;
-				break;
-			}
-
-			SUFFIX(go_quad_dot_product) (&N, inv, inv, n);
-			SUFFIX(go_quad_mul) (&p, &N2, &N);
-			SUFFIX(go_quad_sqrt) (&p, &p);
-			stat_->se[k] = SUFFIX(go_quad_value) (&p) / xscale[k];
-		}
-
-		stat_->t = g_new (DOUBLE, n);
-
-		for (i = 0; i < n; i++)
-			stat_->t[i] = (stat_->se[i] == 0)
-				? SUFFIX(go_pinf)
-				: result[i] / stat_->se[i];
-
-		stat_->df_resid = df_resid;
-		stat_->df_reg = df_reg;
-		stat_->df_total = stat_->df_resid + df_reg;
-
-		stat_->F = (stat_->sqr_r == 1)
-			? SUFFIX(go_pinf)
-			: ((stat_->sqr_r / df_reg) /
-			   (1 - stat_->sqr_r) * stat_->df_resid);
-
-		stat_->ss_reg =  stat_->ss_total - stat_->ss_resid;
-		stat_->se_y = SUFFIX(sqrt) (stat_->ss_total / m);
-		stat_->ms_reg = (df_reg == 0)
-			? 0
-			: stat_->ss_reg / stat_->df_reg;
-		stat_->ms_resid = (df_resid == 0)
-			? 0
-			: stat_->ss_resid / df_resid;
-
-		g_free (QTy);
-		g_free (qresult);
-		g_free (inv);
+		regerr = SUFFIX(linear_regression_stats)
+			(R, xscale, result, n, m, df_resid, df_reg, stat_);
 	} else
 		regerr = GO_REG_invalid_data;
 
 	SUFFIX(go_quad_end) (state);
 
 	if (qr) SUFFIX(go_quad_qr_free) (qr);
+	if (fastR) SUFFIX(go_quad_matrix_free) (fastR);
+	g_free (qresult);
 	g_free (xscale);
 out:
 	if (!has_stat)
@@ -1471,35 +1694,41 @@ SUFFIX(coefficient_matrix) (MATRIX A, /* Output matrix. */
 			    DOUBLE r)
 {
 	int i, j, k;
-	GORegressionResult result;
-	DOUBLE df_i, df_j;
-	DOUBLE sum, sigma;
-
-	/* Notice that the matrix is symmetric.  */
-	for (i = 0; i < p_dim; i++) {
-		for (j = 0; j <= i; j++) {
-			sum = 0;
-			for (k = 0; k < x_dim; k++) {
-				result = SUFFIX(derivative) (f, &df_i, xvals[k],
-						     par, i);
-				if (result != GO_REG_ok)
-					return result;
-
-				result = SUFFIX(derivative) (f, &df_j, xvals[k],
-						     par, j);
-				if (result != GO_REG_ok)
-					return result;
+	GORegressionResult result = GO_REG_ok;
+	DOUBLE *df = g_new (DOUBLE, p_dim);
+	DOUBLE sigma;
 
-				sigma = (sigmas ? sigmas[k] : 1);
+	for (i = 0; i < p_dim; i++)
+		for (j = 0; j <= i; j++)
+			A[i][j] = 0;
 
-				sum += (df_i * df_j) / (sigma * sigma) *
-					(i == j ? 1 + r : 1) ;
-			}
-			A[i][j] = A[j][i] = sum;
+	/*
+	 * The derivatives at a point are computed once and used for the
+	 * whole row.  Notice that the matrix is symmetric.
+	 */
+	for (k = 0; k < x_dim; k++) {
+		for (i = 0; i < p_dim; i++) {
+			result = SUFFIX(derivative) (f, &df[i], xvals[k],
+						     par, i);
+			if (result != GO_REG_ok)
+				goto out;
 		}
+
+		sigma = (sigmas ? sigmas[k] : 1);
+
+		for (i = 0; i < p_dim; i++)
+			for (j = 0; j <= i; j++)
+				A[i][j] += (df[i] * df[j]) / (sigma * sigma) *
+					(i == j ? 1 + r : 1);
 	}
 
-	return GO_REG_ok;
+	for (i = 0; i < p_dim; i++)
+		for (j = 0; j < i; j++)
+			A[j][i] = A[i][j];
+
+ out:
+	g_free (df);
+	return result;
 }
 
 
@@ -1564,7 +1793,11 @@ SUFFIX(parameter_errors) (SUFFIX(GORegressionFunction) f,
  * @chi: Chi Squared of the final result.  This value is not very
  * meaningful without the sigmas.
  * @errors: MUST ALREADY BE ALLOCATED.  These are the approximated standard
- * deviation for each parameter.
+ * deviation for each parameter, 1/sqrt(A[i][i]) where A = J J^T is the
+ * normal matrix and J the Jacobian of the model divided by @sigmas.  This
+ * ignores the correlation between parameters, so it is smaller than the
+ * standard error sqrt((A^-1)[i][i]) reported by
+ * go_non_linear_regression_batch unless the parameters are uncorrelated.
  *
  * SYNOPSIS:
  *   result = non_linear_regression (f, xvals, par, yvals, sigmas,
@@ -1675,6 +1908,595 @@ SUFFIX(go_non_linear_regression) (SUFFIX(GORegressionFunction) f,
 	return result;
 }
 
+/*
+ * What the Levenberg-Marquardt driver needs to know about the model.
+ * Either batch_f is set and the model is evaluated for all points in one
+ * call, or f is set and the points are split into nthreads jobs.
+ */
+typedef struct SUFFIX(NLRModel_) SUFFIX(NLRModel);
+
+typedef struct {
+	SUFFIX(NLRModel) *m;
+	int start, end;
+	DOUBLE *tpar;	/* Private copy of the parameters.  */
+	SUFFIX(GOAccumulator) *acc;
+	GORegressionResult result;
+} SUFFIX(NLRJob);
+
+struct SUFFIX(NLRModel_) {
+	SUFFIX(GORegressionBatchFunction) batch_f;
+	SUFFIX(GORegressionJacobianFunction) jac;
+	gpointer user;
+	SUFFIX(GORegressionFunction) f;
+
+	MATRIX xvals;
+	DOUBLE const *yvals;
+	DOUBLE const *sigmas;
+	int x_dim, p_dim;
+
+	/* Scratch space for finite differences in batch mode.  */
+	DOUBLE *work, *tpar;
+
+	/* The current request to the jobs: r is set for residuals, J for
+	   the Jacobian.  */
+	DOUBLE const *par;
+	DOUBLE *r;
+	MATRIX J;
+
+	int nthreads;
+	SUFFIX(NLRJob) *jobs;
+	GThreadPool *pool;
+	GMutex lock;
+	GCond cond;
+	int pending;
+};
+
+/*
+ * Evaluate the model at the points of one job.  For the Jacobian this
+ * uses the same central differences as batch_jacobian below.
+ */
+static void
+SUFFIX(nlr_job_run) (SUFFIX(NLRJob) *job)
+{
+	SUFFIX(NLRModel) *m = job->m;
+	void *state = SUFFIX(go_accumulator_start) ();
+	DOUBLE h0 = SUFFIX(cbrt) (DOUBLE_EPSILON);
+	int j, k;
+
+	job->result = GO_REG_ok;
+	SUFFIX(go_accumulator_clear) (job->acc);
+	memcpy (job->tpar, m->par, m->p_dim * sizeof (DOUBLE));
+
+	for (k = job->start; k < job->end; k++) {
+		DOUBLE sigma = m->sigmas ? m->sigmas[k] : 1;
+		DOUBLE y1, y2;
+
+		if (m->r) {
+			job->result = m->f (m->xvals[k], job->tpar, &y1);
+			if (job->result != GO_REG_ok)
+				goto out;
+			y1 = (m->yvals[k] - y1) / sigma;
+			m->r[k] = y1;
+			SUFFIX(go_accumulator_add) (job->acc, y1 * y1);
+			continue;
+		}
+
+		for (j = 0; j < m->p_dim; j++) {
+			DOUBLE hp, hm;
+
+			hp = job->tpar[j] = m->par[j] + h0 * (SUFFIX(fabs) (m->par[j]) + 1);
+			job->result = m->f (m->xvals[k], job->tpar, &y1);
+			if (job->result == GO_REG_ok) {
+				hm = job->tpar[j] = m->par[j] - h0 * (SUFFIX(fabs) (m->par[j]) + 1);
+				job->result = m->f (m->xvals[k], job->tpar, &y2);
+			}
+			job->tpar[j] = m->par[j];
+			if (job->result != GO_REG_ok)
+				goto out;
+			m->J[j][k] = (y1 - y2) / (hp - hm) / sigma;
+		}
+	}
+
+ out:
+	SUFFIX(go_accumulator_end) (state);
+}
+
+static void
+SUFFIX(nlr_job_pooled) (SUFFIX(NLRJob) *job, SUFFIX(NLRModel) *m)
+{
+	SUFFIX(nlr_job_run) (job);
+
+	g_mutex_lock (&m->lock);
+	if (--m->pending == 0)
+		g_cond_signal (&m->cond);
+	g_mutex_unlock (&m->lock);
+}
+
+/*
+ * Run all jobs for the current request, the first one in this thread,
+ * and wait for them to finish.  Returns the first failure in job order
+ * so the outcome does not depend on scheduling.
+ */
+static GORegressionResult
+SUFFIX(nlr_dispatch) (SUFFIX(NLRModel) *m)
+{
+	int i;
+
+	m->pending = m->nthreads - 1;
+	for (i = 1; i < m->nthreads; i++)
+		g_thread_pool_push (m->pool, m->jobs + i, NULL);
+	SUFFIX(nlr_job_run) (m->jobs);
+
+	g_mutex_lock (&m->lock);
+	while (m->pending > 0)
+		g_cond_wait (&m->cond, &m->lock);
+	g_mutex_unlock (&m->lock);
+
+	for (i = 0; i < m->nthreads; i++)
+		if (m->jobs[i].result != GO_REG_ok)
+			return m->jobs[i].result;
+	return GO_REG_ok;
+}
+
+/*
+ * Evaluate the model at all points and turn the values into weighted
+ * residuals, r[k] = (y[k] - f(x[k])) / sigma[k].
+ */
+static GORegressionResult
+SUFFIX(nlr_residuals) (SUFFIX(NLRModel) *m, DOUBLE const *par,
+		       DOUBLE *r, DOUBLE *chisq)
+{
+	GORegressionResult result;
+	DOUBLE sum = 0;
+	int k;
+
+	if (m->f) {
+		m->par = par;
+		m->r = r;
+		m->J = NULL;
+		result = SUFFIX(nlr_dispatch) (m);
+		if (result != GO_REG_ok)
+			return result;
+
+		/* Merging in job order keeps the result reproducible.  */
+		for (k = 1; k < m->nthreads; k++)
+			SUFFIX(go_accumulator_merge) (m->jobs[0].acc,
+						      m->jobs[k].acc);
+		*chisq = SUFFIX(go_accumulator_value) (m->jobs[0].acc);
+		return GO_REG_ok;
+	}
+
+	result = m->batch_f (m->xvals, m->x_dim, par, r, m->user);
+	if (result != GO_REG_ok)
+		return result;
+
+	for (k = 0; k < m->x_dim; k++) {
+		DOUBLE t = (m->yvals[k] - r[k]) / (m->sigmas ? m->sigmas[k] : 1);
+		r[k] = t;
+		sum += t * t;
+	}
+
+	*chisq = sum;
+	return GO_REG_ok;
+}
+
+/*
+ * Compute the weighted Jacobian, J[j][k] = (d f(x[k]) / d par[j]) / sigma[k],
+ * with the analytic callback if there is one and otherwise by central
+ * differences.
+ */
+static GORegressionResult
+SUFFIX(nlr_jacobian) (SUFFIX(NLRModel) *m, DOUBLE const *par, MATRIX J)
+{
+	GORegressionResult result;
+	int j, k;
+
+	if (m->f) {
+		m->par = par;
+		m->r = NULL;
+		m->J = J;
+		return SUFFIX(nlr_dispatch) (m);
+	}
+
+	if (m->jac) {
+		result = m->jac (m->xvals, m->x_dim, par, J, m->user);
+		if (result != GO_REG_ok)
+			return result;
+	} else {
+		DOUBLE h0 = SUFFIX(cbrt) (DOUBLE_EPSILON);
+		DOUBLE *tpar = m->tpar;
+
+		memcpy (tpar, par, m->p_dim * sizeof (DOUBLE));
+		for (j = 0; j < m->p_dim; j++) {
+			DOUBLE hp, hm;
+
+			hp = tpar[j] = par[j] + h0 * (SUFFIX(fabs) (par[j]) + 1);
+			result = m->batch_f (m->xvals, m->x_dim, tpar, J[j], m->user);
+			if (result != GO_REG_ok)
+				return result;
+
+			hm = tpar[j] = par[j] - h0 * (SUFFIX(fabs) (par[j]) + 1);
+			result = m->batch_f (m->xvals, m->x_dim, tpar, m->work, m->user);
+			if (result != GO_REG_ok)
+				return result;
+
+			tpar[j] = par[j];
+			for (k = 0; k < m->x_dim; k++)
+				J[j][k] = (J[j][k] - m->work[k]) / (hp - hm);
+		}
+	}
+
+	if (m->sigmas)
+		for (j = 0; j < m->p_dim; j++)
+			for (k = 0; k < m->x_dim; k++)
+				J[j][k] /= m->sigmas[k];
+
+	return GO_REG_ok;
+}
+
+/*
+ * Cholesky factorization, A = L L^T, done in place in the lower triangle
+ * of A.  The upper triangle is not referenced.  Returns FALSE if A is not
+ * (numerically) positive definite.
+ */
+static gboolean
+SUFFIX(cholesky_decompose) (MATRIX A, int n)
+{
+	int i, j, k;
+
+	for (j = 0; j < n; j++) {
+		DOUBLE d = A[j][j];
+		for (k = 0; k < j; k++)
+			d -= A[j][k] * A[j][k];
+		if (!(d > 0))
+			return FALSE;
+		d = A[j][j] = SUFFIX(sqrt) (d);
+
+		for (i = j + 1; i < n; i++) {
+			DOUBLE s = A[i][j];
+			for (k = 0; k < j; k++)
+				s -= A[i][k] * A[j][k];
+			A[i][j] = s / d;
+		}
+	}
+
+	return TRUE;
+}
+
+/* Solve L L^T x = b in place, L as produced by cholesky_decompose.  */
+static void
+SUFFIX(cholesky_solve) (CONSTMATRIX L, DOUBLE *x, int n)
+{
+	int i, k;
+
+	for (i = 0; i < n; i++) {
+		DOUBLE s = x[i];
+		for (k = 0; k < i; k++)
+			s -= L[i][k] * x[k];
+		x[i] = s / L[i][i];
+	}
+	for (i = n - 1; i >= 0; i--) {
+		DOUBLE s = x[i];
+		for (k = i + 1; k < n; k++)
+			s -= L[k][i] * x[k];
+		x[i] = s / L[i][i];
+	}
+}
+
+/* Levenberg-Marquardt on top of nlr_residuals and nlr_jacobian.  */
+static GORegressionResult
+SUFFIX(nlr_fit) (SUFFIX(NLRModel) *m, DOUBLE *par, DOUBLE *chi, DOUBLE *errors)
+{
+	int x_dim = m->x_dim, p_dim = m->p_dim;
+	DOUBLE lambda = CONST(0.001);
+	DOUBLE tol = SUFFIX(sqrt) (DOUBLE_EPSILON);
+	DOUBLE *r, *rnew, *g, *dpar, *tmp_par;
+	MATRIX J;
+	MATRIX A;
+	MATRIX L;
+	DOUBLE chi_pre, chi_pos;
+	GORegressionResult result;
+	gboolean fresh = FALSE;
+	int i, j, k, count;
+
+	r       = g_new (DOUBLE, x_dim);
+	rnew    = g_new (DOUBLE, x_dim);
+	g       = g_new (DOUBLE, p_dim);
+	dpar    = g_new (DOUBLE, p_dim);
+	tmp_par = g_new (DOUBLE, p_dim);
+	ALLOC_MATRIX (J, p_dim, x_dim);
+	ALLOC_MATRIX (A, p_dim, p_dim);
+	ALLOC_MATRIX (L, p_dim, p_dim);
+
+	result = SUFFIX(nlr_residuals) (m, par, r, &chi_pre);
+	if (result != GO_REG_ok)
+		goto out;
+	if (!SUFFIX(go_finite) (chi_pre)) {
+		result = GO_REG_invalid_data;
+		goto out;
+	}
+
+	for (count = 0; count < MAX_STEPS && chi_pre > 0; count++) {
+		if (!fresh) {
+			result = SUFFIX(nlr_jacobian) (m, par, J);
+			if (result != GO_REG_ok)
+				goto out;
+
+			/* A = J J^T and g = J r.  */
+			for (i = 0; i < p_dim; i++) {
+				DOUBLE s = 0;
+				for (k = 0; k < x_dim; k++)
+					s += J[i][k] * r[k];
+				g[i] = s;
+				for (j = 0; j <= i; j++) {
+					s = 0;
+					for (k = 0; k < x_dim; k++)
+						s += J[i][k] * J[j][k];
+					A[i][j] = s;
+				}
+			}
+			fresh = TRUE;
+		}
+
+		/* Factor the damped normal matrix, A + lambda diag(A).  */
+		for (i = 0; i < p_dim; i++) {
+			for (j = 0; j < i; j++)
+				L[i][j] = A[i][j];
+			L[i][i] = A[i][i] + lambda * (A[i][i] > 0 ? A[i][i] : 1);
+		}
+		if (!SUFFIX(cholesky_decompose) (L, p_dim)) {
+			lambda *= 10;
+			continue;
+		}
+		memcpy (dpar, g, p_dim * sizeof (DOUBLE));
+		SUFFIX(cholesky_solve) (L, dpar, p_dim);
+
+		for (i = 0; i < p_dim; i++)
+			tmp_par[i] = par[i] + dpar[i];
+
+		result = SUFFIX(nlr_residuals) (m, tmp_par, rnew, &chi_pos);
+		if (result != GO_REG_ok)
+			goto out;
+
+		if (chi_pos <= chi_pre) {
+			/* There is improvement */
+			DOUBLE *t = r;
+			gboolean small_step = TRUE;
+
+			r = rnew;
+			rnew = t;
+			for (i = 0; i < p_dim; i++) {
+				if (SUFFIX(fabs) (dpar[i]) > tol * (SUFFIX(fabs) (par[i]) + tol))
+					small_step = FALSE;
+				par[i] = tmp_par[i];
+			}
+			lambda /= 10;
+			fresh = FALSE;
+
+			if (small_step || chi_pre - chi_pos <= tol * chi_pre) {
+				chi_pre = chi_pos;
+				break;
+			}
+			chi_pre = chi_pos;
+		} else {
+			lambda *= 10;
+			/* No step direction helps any more.  */
+			if (lambda > 1 / DOUBLE_EPSILON)
+				break;
+		}
+	}
+
+	/* Errors from the diagonal of the inverse of the normal matrix.  */
+	if (!fresh) {
+		result = SUFFIX(nlr_jacobian) (m, par, J);
+		if (result != GO_REG_ok)
+			goto out;
+		for (i = 0; i < p_dim; i++)
+			for (j = 0; j <= i; j++) {
+				DOUBLE s = 0;
+				for (k = 0; k < x_dim; k++)
+					s += J[i][k] * J[j][k];
+				A[i][j] = s;
+			}
+	}
+	for (i = 0; i < p_dim; i++)
+		for (j = 0; j <= i; j++)
+			L[i][j] = A[i][j];
+	if (SUFFIX(cholesky_decompose) (L, p_dim)) {
+		for (i = 0; i < p_dim; i++) {
+			memset (dpar, 0, p_dim * sizeof (DOUBLE));
+			dpar[i] = 1;
+			SUFFIX(cholesky_solve) (L, dpar, p_dim);
+			errors[i] = SUFFIX(sqrt) (dpar[i]);
+		}
+	} else {
+		for (i = 0; i < p_dim; i++)
+			errors[i] = -1;
+	}
+
+	*chi = chi_pre;
+
+ out:
+	g_free (r);
+	g_free (rnew);
+	g_free (g);
+	g_free (dpar);
+	g_free (tmp_par);
+	FREE_MATRIX (J, p_dim, x_dim);
+	FREE_MATRIX (A, p_dim, p_dim);
+	FREE_MATRIX (L, p_dim, p_dim);
+
+	return result;
+}
+
+/**
+ * go_non_linear_regression_batch:
+ * @f: (scope call): the model function, evaluated at all points at once
+ * @jac: (scope call) (nullable): the Jacobian of the model, or %NULL to
+ * approximate it by finite differences of @f.  It must store the derivative
+ * of the model at xvals[k] with respect to params[j] in jac[j][k].
+ * @user: user data for @f and @jac
+ * @xvals: independent values.
+ * @par: model parameters.
+ * @yvals: dependent values.
+ * @sigmas: (nullable): standard deviations for the dependent values.
+ * @x_dim: Number of data points.
+ * @p_dim: Number of parameters.
+ * @chi: (out): Chi Squared of the final result.
+ * @errors: (out): MUST ALREADY BE ALLOCATED.  The standard error of each
+ * parameter, sqrt((A^-1)[i][i]) where A = J J^T is the normal matrix and J
+ * the Jacobian of the model divided by @sigmas, or -1 if A is singular.
+ * Unlike the errors of go_non_linear_regression, which are
+ * 1/sqrt(A[i][i]), these account for correlation between parameters and
+ * are never smaller.
+ *
+ * Non linear regression by the Levenberg-Marquardt method.  Unlike
+ * go_non_linear_regression, the model is evaluated once per point per
+ * function call and the residuals and Jacobian computed in an iteration
+ * are used for both the gradient and the normal matrix.  When a step is
+ * rejected only the damping changes, so the normal matrix is factored
+ * again but the model is not re-evaluated.
+ *
+ * Returns: the result of the non-linear regression from the given initial
+ * values.  The resulting parameters are placed back into @par.
+ **/
+GORegressionResult
+SUFFIX(go_non_linear_regression_batch) (SUFFIX(GORegressionBatchFunction) f,
+					SUFFIX(GORegressionJacobianFunction) jac,
+					gpointer user,
+					MATRIX xvals,
+					DOUBLE *par,
+					DOUBLE *yvals,
+					DOUBLE *sigmas,
+					int x_dim,
+					int p_dim,
+					DOUBLE *chi,
+					DOUBLE *errors)
+{
+	SUFFIX(NLRModel) m;
+	GORegressionResult result;
+
+	g_return_val_if_fail (f != NULL, GO_REG_invalid_data);
+	g_return_val_if_fail (x_dim >= 1, GO_REG_invalid_dimensions);
+	g_return_val_if_fail (p_dim >= 1, GO_REG_invalid_dimensions);
+
+	memset (&m, 0, sizeof (m));
+	m.batch_f = f;
+	m.jac = jac;
+	m.user = user;
+	m.xvals = xvals;
+	m.yvals = yvals;
+	m.sigmas = sigmas;
+	m.x_dim = x_dim;
+	m.p_dim = p_dim;
+	m.work = g_new (DOUBLE, x_dim);
+	m.tpar = g_new (DOUBLE, p_dim);
+
+	result = SUFFIX(nlr_fit) (&m, par, chi, errors);
+
+	g_free (m.work);
+	g_free (m.tpar);
+	return result;
+}
+
+/*
+ * Below this many points per thread it is not worth the trouble of
+ * going parallel.
+ */
+#define NLR_PARALLEL_CHUNK 1024
+
+/**
+ * go_non_linear_regression_parallel:
+ * @f: (scope call): the model function
+ * @xvals: independent values.
+ * @par: model parameters.
+ * @yvals: dependent values.
+ * @sigmas: (nullable): standard deviations for the dependent values.
+ * @x_dim: Number of data points.
+ * @p_dim: Number of parameters.
+ * @chi: (out): Chi Squared of the final result.
+ * @errors: (out): MUST ALREADY BE ALLOCATED.  The standard error of each
+ * parameter, or -1 if it cannot be determined.  See
+ * go_non_linear_regression_batch.
+ *
+ * Non linear regression by the same method as
+ * go_non_linear_regression_batch, but with a model evaluated one point at
+ * a time.  The evaluation of the residuals and of the Jacobian is split
+ * over threads, so @f must be safe to call from several threads at once.
+ * The parameters passed to @f are a private copy per thread.
+ *
+ * The partial sums of the threads are merged exactly and in a fixed
+ * order, so the result does not depend on the number of threads.
+ *
+ * Returns: the result of the non-linear regression from the given initial
+ * values.  The resulting parameters are placed back into @par.
+ **/
+GORegressionResult
+SUFFIX(go_non_linear_regression_parallel) (SUFFIX(GORegressionFunction) f,
+					   MATRIX xvals,
+					   DOUBLE *par,
+					   DOUBLE *yvals,
+					   DOUBLE *sigmas,
+					   int x_dim,
+					   int p_dim,
+					   DOUBLE *chi,
+					   DOUBLE *errors)
+{
+	SUFFIX(NLRModel) m;
+	GORegressionResult result;
+	int i;
+
+	g_return_val_if_fail (f != NULL, GO_REG_invalid_data);
+	g_return_val_if_fail (x_dim >= 1, GO_REG_invalid_dimensions);
+	g_return_val_if_fail (p_dim >= 1, GO_REG_invalid_dimensions);
+
+	memset (&m, 0, sizeof (m));
+	m.f = f;
+	m.xvals = xvals;
+	m.yvals = yvals;
+	m.sigmas = sigmas;
+	m.x_dim = x_dim;
+	m.p_dim = p_dim;
+	m.nthreads = CLAMP (x_dim / NLR_PARALLEL_CHUNK,
+			    1, (int)g_get_num_processors ());
+	g_mutex_init (&m.lock);
+	g_cond_init (&m.cond);
+
+	m.jobs = g_new (SUFFIX(NLRJob), m.nthreads);
+	for (i = 0; i < m.nthreads; i++) {
+		m.jobs[i].m = &m;
+		m.jobs[i].start = (gint64)x_dim * i / m.nthreads;
+		m.jobs[i].end = (gint64)x_dim * (i + 1) / m.nthreads;
+		m.jobs[i].tpar = g_new (DOUBLE, p_dim);
+		m.jobs[i].acc = SUFFIX(go_accumulator_new) ();
+	}
+
+	/*
+	 * A non-exclusive pool borrows glib's shared threads.  The pool
+	 * lives for the whole fit; nlr_dispatch waits for each round of
+	 * jobs.
+	 */
+	if (m.nthreads > 1)
+		m.pool = g_thread_pool_new ((GFunc)SUFFIX(nlr_job_pooled), &m,
+					    m.nthreads - 1, FALSE, NULL);
+
+	result = SUFFIX(nlr_fit) (&m, par, chi, errors);
+
+	if (m.pool)
+		g_thread_pool_free (m.pool, FALSE, TRUE);
+	for (i = 0; i < m.nthreads; i++) {
+		g_free (m.jobs[i].tpar);
+		SUFFIX(go_accumulator_free) (m.jobs[i].acc);
+	}
+	g_free (m.jobs);
+	g_mutex_clear (&m.lock);
+	g_cond_clear (&m.cond);
+
+	return result;
+}
+
+#undef NLR_PARALLEL_CHUNK
+
 /*
  * Compute the diagonal of A (AT A)^-1 AT
  *
@@ -1709,7 +2531,7 @@ SUFFIX(go_linear_regression_leverage) (MATRIX A, DOUBLE *d, int m, int n)
 	qr = SUFFIX(go_quad_qr_new) (qA);
 	if (qr) {
 		int k;
-		QUAD *b = g_new (QUAD, n);
+		SUFFIX(GOQuadMatrix) *B = SUFFIX(go_quad_matrix_new) (n, m);
 		const SUFFIX(GOQuadMatrix) *R = SUFFIX(go_quad_qr_r) (qr);
 		DOUBLE emin, emax;
 
@@ -1718,37 +2540,31 @@ SUFFIX(go_linear_regression_leverage) (MATRIX A, DOUBLE *d, int m, int n)
 			? GO_REG_ok
 			: GO_REG_singular;
 
-		for (k = 0; k < m; k++) {
-			int i;
-			QUAD acc = SUFFIX(go_quad_zero);
-
-			/* b = AT e_k  */
-			for (i = 0; i < n; i++)
-				b[i] = qA->data[k][i];
-
-			/* Solve R^T b = AT e_k */
-			if (SUFFIX(go_quad_matrix_fwd_solve) (R, b, b, FALSE)) {
-				regres = GO_REG_singular;
-				break;
-			}
-
-			/* Solve R newb = b */
-			if (SUFFIX(go_quad_matrix_back_solve) (R, b, b, FALSE)) {
-				regres = GO_REG_singular;
-				break;
-			}
-
-			/* acc = (Ab)_k */
-			for (i = 0; i < n; i++) {
-				QUAD p;
-				SUFFIX(go_quad_mul) (&p, &qA->data[k][i], &b[i]);
-				SUFFIX(go_quad_add) (&acc, &acc, &p);
+		/*
+		 * Column k of B is b = AT e_k.  Solve R^T b = AT e_k and
+		 * then R newb = b for all k at once.
+		 */
+		SUFFIX(go_quad_matrix_transpose) (B, qA);
+		if (SUFFIX(go_quad_matrix_fwd_solve_multi) (R, B, B, FALSE) ||
+		    SUFFIX(go_quad_matrix_back_solve_multi) (R, B, B, FALSE))
+			regres = GO_REG_singular;
+		else {
+			for (k = 0; k < m; k++) {
+				QUAD acc = SUFFIX(go_quad_zero);
+
+				/* acc = (Ab)_k */
+				for (i = 0; i < n; i++) {
+					QUAD p;
+					SUFFIX(go_quad_mul) (&p, &qA->data[k][i],
+							     &B->data[i][k]);
+					SUFFIX(go_quad_add) (&acc, &acc, &p);
+				}
+
+				d[k] = SUFFIX(go_quad_value) (&acc);
 			}
-
-			d[k] = SUFFIX(go_quad_value) (&acc);
 		}
 
-		g_free (b);
+		SUFFIX(go_quad_matrix_free) (B);
 		SUFFIX(go_quad_qr_free) (qr);
 	} else
 		regres = GO_REG_invalid_data;
@@ -1799,6 +2615,496 @@ SUFFIX(go_matrix_pseudo_inverse) (CONSTMATRIX A, int m, int n,
 
 /* ------------------------------------------------------------------------- */
 
+struct INFIX(GORegressionState,_) {
+	int dim;
+	gboolean affine;
+	int p;			/* Number of columns: dim plus one if affine */
+	int n;			/* Number of observations */
+	SUFFIX(GOQuadMatrix) *R; /* p-by-p triangular factor */
+	QUAD *z;		/* First p elements of Q^T y */
+	QUAD rss;		/* Sum of squares of the remaining elements */
+	QUAD *sx;		/* Sums of the x-vectors */
+	GHashTable **exps;	/* Exponent counts of the x-vectors, for scaling */
+	QUAD sy, syy;		/* Sum of ys and of their squares */
+	QUAD *row, *a, *c, *s;	/* Work areas of size p */
+};
+
+/**
+ * go_regression_state_new: (skip)
+ * @dim: number of x-vectors
+ * @affine: if %TRUE, a non-zero constant is allowed
+ *
+ * Creates an empty state for incremental linear regression.  Observations
+ * are added and removed with go_regression_state_append and
+ * go_regression_state_remove, each at a cost of O(@dim^2) regardless of
+ * the number of observations.  The results are then available through
+ * go_regression_state_get_result.
+ *
+ * Returns: (transfer full): a new #GORegressionState.
+ **/
+SUFFIX(GORegressionState) *
+SUFFIX(go_regression_state_new) (int dim, gboolean affine)
+{
+	SUFFIX(GORegressionState) *state;
+	int j, p = dim + (affine ? 1 : 0);
+
+	g_return_val_if_fail (dim >= 1, NULL);
+
+	state = g_new0 (SUFFIX(GORegressionState), 1);
+	state->dim = dim;
+	state->affine = affine;
+	state->p = p;
+	state->R = SUFFIX(go_quad_matrix_new) (p, p);
+	state->z = g_new0 (QUAD, p);
+	state->sx = g_new0 (QUAD, dim);
+	state->exps = g_new (GHashTable *, dim);
+	for (j = 0; j < dim; j++)
+		state->exps[j] = g_hash_table_new (NULL, NULL);
+	state->row = g_new0 (QUAD, 4 * p);
+	state->a = state->row + p;
+	state->c = state->a + p;
+	state->s = state->c + p;
+
+	return state;
+}
+
+/**
+ * go_regression_state_free: (skip)
+ * @state: (transfer full): #GORegressionState to free
+ *
+ * Frees @state and its associated data.
+ **/
+void
+SUFFIX(go_regression_state_free) (SUFFIX(GORegressionState) *state)
+{
+	int j;
+
+	if (!state)
+		return;
+
+	SUFFIX(go_quad_matrix_free) (state->R);
+	g_free (state->z);
+	g_free (state->sx);
+	for (j = 0; j < state->dim; j++)
+		g_hash_table_destroy (state->exps[j]);
+	g_free (state->exps);
+	g_free (state->row);
+	g_free (state);
+}
+
+/**
+ * go_regression_state_get_n:
+ * @state: #GORegressionState
+ *
+ * Returns: the number of observations currently in @state.
+ **/
+int
+SUFFIX(go_regression_state_get_n) (SUFFIX(GORegressionState) const *state)
+{
+	g_return_val_if_fail (state != NULL, 0);
+
+	return state->n;
+}
+
+static void
+SUFFIX(regression_state_load_row) (SUFFIX(GORegressionState) *state,
+				   DOUBLE const *xs)
+{
+	int j, o = state->affine ? 1 : 0;
+
+	if (state->affine)
+		state->row[0] = SUFFIX(go_quad_one);
+	for (j = 0; j < state->dim; j++)
+		SUFFIX(go_quad_init) (&state->row[j + o], xs[j]);
+}
+
+/*
+ * calc_scale only depends on the exponent of the largest element, so
+ * counting the exponents of each x-vector lets us compute the same scale
+ * even after observations have been removed.
+ */
+static void
+SUFFIX(regression_state_count_exp) (GHashTable *exps, DOUBLE x,
+				    gboolean add)
+{
+	gpointer key;
+	int e, c;
+
+	if (x == 0 || !SUFFIX(go_finite) (x))
+		return;
+
+	(void)UNSCALBN (x, &e);
+	key = GINT_TO_POINTER (e);
+	c = GPOINTER_TO_INT (g_hash_table_lookup (exps, key)) + (add ? 1 : -1);
+	if (c > 0)
+		g_hash_table_insert (exps, key, GINT_TO_POINTER (c));
+	else
+		g_hash_table_remove (exps, key);
+}
+
+static DOUBLE
+SUFFIX(regression_state_scale) (GHashTable *exps)
+{
+	GHashTableIter iter;
+	gpointer key;
+	int e = 0;
+	gboolean any = FALSE;
+
+	g_hash_table_iter_init (&iter, exps);
+	while (g_hash_table_iter_next (&iter, &key, NULL)) {
+		int ek = GPOINTER_TO_INT (key);
+		if (!any || ek > e)
+			e = ek;
+		any = TRUE;
+	}
+
+	return any ? SUFFIX(scalbn) (1.0, e - 1) : 1;
+}
+
+static void
+SUFFIX(regression_state_sums) (SUFFIX(GORegressionState) *state,
+			       DOUBLE const *xs, DOUBLE y, gboolean add)
+{
+	void (*op) (QUAD *res, const QUAD *a, const QUAD *b) =
+		add ? SUFFIX(go_quad_add) : SUFFIX(go_quad_sub);
+	QUAD q;
+	int j;
+
+	for (j = 0; j < state->dim; j++) {
+		SUFFIX(go_quad_init) (&q, xs[j]);
+		op (&state->sx[j], &state->sx[j], &q);
+		SUFFIX(regression_state_count_exp) (state->exps[j], xs[j], add);
+	}
+	SUFFIX(go_quad_init) (&q, y);
+	op (&state->sy, &state->sy, &q);
+	SUFFIX(go_quad_mul12) (&q, y, y);
+	op (&state->syy, &state->syy, &q);
+}
+
+/* Replace (x,y) by (c*x+s*y,c*y-s*x).  */
+static void
+SUFFIX(quad_rotate) (const QUAD *c, const QUAD *s, QUAD *x, QUAD *y)
+{
+	QUAD t1, t2, u;
+
+	SUFFIX(go_quad_mul) (&t1, c, x);
+	SUFFIX(go_quad_mul) (&t2, s, y);
+	SUFFIX(go_quad_add) (&u, &t1, &t2);
+	SUFFIX(go_quad_mul) (&t1, c, y);
+	SUFFIX(go_quad_mul) (&t2, s, x);
+	SUFFIX(go_quad_sub) (y, &t1, &t2);
+	*x = u;
+}
+
+/**
+ * go_regression_state_append:
+ * @state: #GORegressionState
+ * @xs: (array): the x-values of the observation, one for each x-vector
+ * @y: the y-value of the observation
+ *
+ * Adds an observation to @state.  The triangular factor is updated by
+ * Givens rotations.
+ **/
+void
+SUFFIX(go_regression_state_append) (SUFFIX(GORegressionState) *state,
+				    DOUBLE const *xs, DOUBLE y)
+{
+	void *qstate;
+	QUAD yy, t;
+	QUAD *row;
+	int j, k, p;
+
+	g_return_if_fail (state != NULL);
+	g_return_if_fail (xs != NULL);
+
+	qstate = SUFFIX(go_quad_start) ();
+
+	p = state->p;
+	row = state->row;
+	SUFFIX(regression_state_load_row) (state, xs);
+	SUFFIX(go_quad_init) (&yy, y);
+
+	/* Rotate the new row into R, one element at a time.  */
+	for (k = 0; k < p; k++) {
+		QUAD *Rk = state->R->data[k];
+		QUAD r, c, s;
+
+		if (SUFFIX(go_quad_value) (&row[k]) == 0)
+			continue;
+
+		SUFFIX(go_quad_hypot) (&r, &Rk[k], &row[k]);
+		SUFFIX(go_quad_div) (&c, &Rk[k], &r);
+		SUFFIX(go_quad_div) (&s, &row[k], &r);
+		Rk[k] = r;
+		for (j = k + 1; j < p; j++)
+			SUFFIX(quad_rotate) (&c, &s, &Rk[j], &row[j]);
+		SUFFIX(quad_rotate) (&c, &s, &state->z[k], &yy);
+	}
+
+	/* What is left of y is in the orthogonal complement.  */
+	SUFFIX(go_quad_mul) (&t, &yy, &yy);
+	SUFFIX(go_quad_add) (&state->rss, &state->rss, &t);
+
+	SUFFIX(regression_state_sums) (state, xs, y, TRUE);
+	state->n++;
+
+	SUFFIX(go_quad_end) (qstate);
+}
+
+/**
+ * go_regression_state_remove:
+ * @state: #GORegressionState
+ * @xs: (array): the x-values of the observation, one for each x-vector
+ * @y: the y-value of the observation
+ *
+ * Removes an observation, previously added with go_regression_state_append,
+ * from @state.  This downdates the triangular factor as in LINPACK's dchdd.
+ *
+ * That is not possible when the remaining observations do not determine
+ * the regression.  In that case @state is left unchanged and must be
+ * rebuilt from scratch.
+ *
+ * Returns: %TRUE on error.
+ **/
+gboolean
+SUFFIX(go_regression_state_remove) (SUFFIX(GORegressionState) *state,
+				    DOUBLE const *xs, DOUBLE y)
+{
+	void *qstate;
+	QUAD *a, *c, *s;
+	QUAD alpha, xx, zeta, t;
+	int i, j, p;
+	gboolean err = FALSE;
+
+	g_return_val_if_fail (state != NULL, TRUE);
+	g_return_val_if_fail (xs != NULL, TRUE);
+
+	if (state->n == 0)
+		return TRUE;
+
+	qstate = SUFFIX(go_quad_start) ();
+
+	p = state->p;
+	a = state->a;
+	c = state->c;
+	s = state->s;
+	SUFFIX(regression_state_load_row) (state, xs);
+
+	/* Solve R^T a = row.  */
+	if (SUFFIX(go_quad_matrix_fwd_solve) (state->R, a, state->row, FALSE)) {
+		err = TRUE;
+		goto out;
+	}
+
+	/* alpha = sqrt (1 - |a|^2) */
+	SUFFIX(go_quad_dot_product) (&t, a, a, p);
+	SUFFIX(go_quad_sub) (&t, &SUFFIX(go_quad_one), &t);
+	if (!(SUFFIX(go_quad_value) (&t) > 0)) {
+		err = TRUE;
+		goto out;
+	}
+	SUFFIX(go_quad_sqrt) (&alpha, &t);
+
+	/* Determine the rotations.  */
+	for (i = p - 1; i >= 0; i--) {
+		QUAD scale, aa, bb, norm;
+
+		SUFFIX(go_quad_abs) (&t, &a[i]);
+		SUFFIX(go_quad_add) (&scale, &alpha, &t);
+		SUFFIX(go_quad_div) (&aa, &alpha, &scale);
+		SUFFIX(go_quad_div) (&bb, &a[i], &scale);
+		SUFFIX(go_quad_hypot) (&norm, &aa, &bb);
+		SUFFIX(go_quad_div) (&c[i], &aa, &norm);
+		SUFFIX(go_quad_div) (&s[i], &bb, &norm);
+		SUFFIX(go_quad_mul) (&alpha, &scale, &norm);
+	}
+
+	/* Apply them to R.  */
+	for (j = 0; j < p; j++) {
+		xx = SUFFIX(go_quad_zero);
+		for (i = j; i >= 0; i--)
+			SUFFIX(quad_rotate) (&c[i], &s[i], &xx,
+					     &state->R->data[i][j]);
+	}
+
+	/* And to z.  */
+	SUFFIX(go_quad_init) (&zeta, y);
+	for (i = 0; i < p; i++) {
+		SUFFIX(go_quad_mul) (&t, &s[i], &zeta);
+		SUFFIX(go_quad_sub) (&state->z[i], &state->z[i], &t);
+		SUFFIX(go_quad_div) (&state->z[i], &state->z[i], &c[i]);
+		SUFFIX(go_quad_mul) (&zeta, &c[i], &zeta);
+		SUFFIX(go_quad_mul) (&t, &s[i], &state->z[i]);
+		SUFFIX(go_quad_sub) (&zeta, &zeta, &t);
+	}
+
+	/* Whatever is left of zeta came from the residual.  */
+	SUFFIX(go_quad_mul) (&t, &zeta, &zeta);
+	SUFFIX(go_quad_sub) (&state->rss, &state->rss, &t);
+	if (SUFFIX(go_quad_value) (&state->rss) < 0)
+		state->rss = SUFFIX(go_quad_zero);
+
+	SUFFIX(regression_state_sums) (state, xs, y, FALSE);
+	state->n--;
+
+	if (state->n == 0) {
+		/* Start afresh without any rounding errors.  */
+		for (i = 0; i < p; i++)
+			for (j = 0; j < p; j++)
+				state->R->data[i][j] = SUFFIX(go_quad_zero);
+		for (i = 0; i < p; i++)
+			state->z[i] = SUFFIX(go_quad_zero);
+		for (j = 0; j < state->dim; j++) {
+			state->sx[j] = SUFFIX(go_quad_zero);
+			g_hash_table_remove_all (state->exps[j]);
+		}
+		state->rss = state->sy = state->syy = SUFFIX(go_quad_zero);
+	}
+
+out:
+	SUFFIX(go_quad_end) (qstate);
+
+	return err;
+}
+
+/**
+ * go_regression_state_get_result:
+ * @state: #GORegressionState
+ * @res: output place for constant[0] and slope1[1], slope2[2],... There
+ * will be dim+1 results.
+ * @stat_: (out) (optional): storage for additional results.
+ *
+ * Computes the linear regression of the observations in @state, just as
+ * go_linear_regression would.  This costs O(dim^3) regardless of the number
+ * of observations.
+ *
+ * Returns: #GORegressionResult as above.
+ **/
+GORegressionResult
+SUFFIX(go_regression_state_get_result) (SUFFIX(GORegressionState) *state,
+					DOUBLE *res,
+					SUFFIX(go_regression_stat_t) *stat_)
+{
+	GORegressionResult regerr;
+	SUFFIX(GOQuadMatrix) *R;
+	QUAD *qresult;
+	DOUBLE *result, *xscale;
+	DOUBLE emax, threshold = DEFAULT_THRESHOLD;
+	QUAD N, q;
+	void *qstate;
+	int i, k, p, m, df_resid, df_reg;
+	gboolean has_stat;
+
+	g_return_val_if_fail (state != NULL, GO_REG_invalid_dimensions);
+	g_return_val_if_fail (res != NULL, GO_REG_invalid_dimensions);
+
+	p = state->p;
+	m = state->n;
+	if (state->affine)
+		result = res;
+	else {
+		res[0] = 0;
+		result = res + 1;
+	}
+	ZERO_VECTOR (result, p);
+
+	if (p > m)
+		return GO_REG_not_enough_data;
+
+	has_stat = (stat_ != NULL);
+	if (!has_stat)
+		stat_ = SUFFIX(go_regression_stat_new)();
+
+	qstate = SUFFIX(go_quad_start) ();
+
+	/*
+	 * Scale the x-vectors just like general_linear_regression does and
+	 * judge degeneracy by the same criterion.  The scales are powers of
+	 * the radix, so this is exact.
+	 */
+	R = SUFFIX(go_quad_matrix_dup) (state->R);
+	xscale = g_new (DOUBLE, p);
+	k = 0;
+	if (state->affine)
+		xscale[k++] = 1;
+	for (i = 0; i < state->dim; i++)
+		xscale[k++] = SUFFIX(regression_state_scale) (state->exps[i]);
+	for (k = 0; k < p; k++) {
+		SUFFIX(go_quad_init) (&q, 1 / xscale[k]);
+		for (i = 0; i <= k; i++)
+			SUFFIX(go_quad_mul) (&R->data[i][k], &R->data[i][k], &q);
+	}
+
+	SUFFIX(go_quad_matrix_eigen_range) (R, NULL, &emax);
+	df_resid = m - p;
+	df_reg = p - (state->affine ? 1 : 0);
+	for (i = 0; i < p; i++) {
+		DOUBLE ei = SUFFIX(go_quad_value) (&R->data[i][i]);
+		if (!(SUFFIX(fabs) (ei) >= emax * threshold)) {
+			R->data[i][i] = SUFFIX(go_quad_zero);
+			df_resid++;
+			df_reg--;
+		}
+	}
+
+	qresult = g_new (QUAD, p);
+	SUFFIX(go_quad_matrix_back_solve) (R, qresult, state->z, TRUE);
+	for (i = 0; i < p; i++)
+		result[i] = SUFFIX(go_quad_value) (&qresult[i]) / xscale[i];
+
+	/*
+	 * |y - X b|^2 = |z - R b|^2 + rss.  The first term vanishes except
+	 * for the rows of degenerate dimensions.
+	 */
+	N = state->rss;
+	for (i = 0; i < p; i++) {
+		QUAD d = state->z[i];
+		for (k = i; k < p; k++) {
+			SUFFIX(go_quad_mul) (&q, &R->data[i][k], &qresult[k]);
+			SUFFIX(go_quad_sub) (&d, &d, &q);
+		}
+		SUFFIX(go_quad_mul) (&d, &d, &d);
+		SUFFIX(go_quad_add) (&N, &N, &d);
+	}
+	stat_->ss_resid = SUFFIX(go_quad_value) (&N);
+
+	SUFFIX(go_quad_init) (&N, m);
+	SUFFIX(go_quad_div) (&q, &state->sy, &N);
+	stat_->ybar = SUFFIX(go_quad_value) (&q);
+	if (state->affine) {
+		/* ss_total = syy - sy * sy / m */
+		SUFFIX(go_quad_mul) (&q, &q, &state->sy);
+		SUFFIX(go_quad_sub) (&q, &state->syy, &q);
+		stat_->ss_total = SUFFIX(go_quad_value) (&q);
+	} else
+		stat_->ss_total = SUFFIX(go_quad_value) (&state->syy);
+
+	stat_->xbar = g_new (DOUBLE, p);
+	k = 0;
+	if (state->affine)
+		stat_->xbar[k++] = 1;
+	for (i = 0; i < state->dim; i++) {
+		SUFFIX(go_quad_div) (&q, &state->sx[i], &N);
+		stat_->xbar[k++] = SUFFIX(go_quad_value) (&q);
+	}
+
+	regerr = SUFFIX(linear_regression_stats)
+		(R, xscale, result, p, m, df_resid, df_reg, stat_);
+
+	g_free (qresult);
+	g_free (xscale);
+	SUFFIX(go_quad_matrix_free) (R);
+
+	SUFFIX(go_quad_end) (qstate);
+
+	if (!has_stat)
+		SUFFIX(go_regression_stat_destroy) (stat_);
+
+	return regerr;
+}
+
+/* ------------------------------------------------------------------------- */
+
 // See comments at top
 #endif // SKIP_THIS_PASS
 #if INCLUDE_PASS < INCLUDE_PASS_LAST
@@ -103,6 +103,44 @@ GORegressionResult go_non_linear_regression (GORegressionFunction f,
 					     double *chi,
 					     double *errors);
 
+typedef GORegressionResult (*GORegressionBatchFunction) (double **xvals, int x_dim, double const *params, double *f, gpointer user);
+typedef GORegressionResult (*GORegressionJacobianFunction) (double **xvals, int x_dim, double const *params, double **jac, gpointer user);
+
+GORegressionResult go_non_linear_regression_batch (GORegressionBatchFunction f,
+						   GORegressionJacobianFunction jac,
+						   gpointer user,
+						   double **xvals,
+						   double *par,
+						   double *yvals,
+						   double *sigmas,
+						   int x_dim,
+						   int p_dim,
+						   double *chi,
+						   double *errors);
+
+GORegressionResult go_non_linear_regression_parallel (GORegressionFunction f,
+						      double **xvals,
+						      double *par,
+						      double *yvals,
+						      double *sigmas,
+						      int x_dim,
+						      int p_dim,
+						      double *chi,
+						      double *errors);
+
+typedef struct GORegressionState_ GORegressionState;
+
+GORegressionState *go_regression_state_new (int dim, gboolean affine);
+void go_regression_state_free (GORegressionState *state);
+void go_regression_state_append (GORegressionState *state,
+				 double const *xs, double y);
+gboolean go_regression_state_remove (GORegressionState *state,
+				     double const *xs, double y);
+int go_regression_state_get_n (GORegressionState const *state);
+GORegressionResult go_regression_state_get_result (GORegressionState *state,
+						   double *res,
+						   go_regression_stat_t *stat_);
+
 gboolean go_matrix_invert 	(double **A, int n);
 double   go_matrix_determinant 	(double *const *const A, int n);
 
@@ -191,6 +229,44 @@ GORegressionResult    go_non_linear_regressionl	(GORegressionFunctionl f,
 						 long double *chi,
 						 long double *errors);
 
+typedef GORegressionResult (*GORegressionBatchFunctionl) (long double **xvals, int x_dim, long double const *params, long double *f, gpointer user);
+typedef GORegressionResult (*GORegressionJacobianFunctionl) (long double **xvals, int x_dim, long double const *params, long double **jac, gpointer user);
+
+GORegressionResult go_non_linear_regression_batchl (GORegressionBatchFunctionl f,
+						    GORegressionJacobianFunctionl jac,
+						    gpointer user,
+						    long double **xvals,
+						    long double *par,
+						    long double *yvals,
+						    long double *sigmas,
+						    int x_dim,
+						    int p_dim,
+						    long double *chi,
+						    long double *errors);
+
+GORegressionResult go_non_linear_regression_parallell (GORegressionFunctionl f,
+						       long double **xvals,
+						       long double *par,
+						       long double *yvals,
+						       long double *sigmas,
+						       int x_dim,
+						       int p_dim,
+						       long double *chi,
+						       long double *errors);
+
+typedef struct GORegressionStatel_ GORegressionStatel;
+
+GORegressionStatel *go_regression_state_newl (int dim, gboolean affine);
+void go_regression_state_freel (GORegressionStatel *state);
+void go_regression_state_appendl (GORegressionStatel *state,
+				  long double const *xs, long double y);
+gboolean go_regression_state_removel (GORegressionStatel *state,
+				      long double const *xs, long double y);
+int go_regression_state_get_nl (GORegressionStatel const *state);
+GORegressionResult go_regression_state_get_resultl (GORegressionStatel *state,
+						    long double *res,
+						    go_regression_stat_tl *stat_);
+
 gboolean    go_matrix_invertl 		(long double **A, int n);
 long double go_matrix_determinantl 	(long double *const * const A, int n);
 
@@ -282,6 +358,44 @@ GORegressionResult    go_non_linear_regressionD	(GORegressionFunctionD f,
 						 _Decimal64 *chi,
 						 _Decimal64 *errors);
 
+typedef GORegressionResult (*GORegressionBatchFunctionD) (_Decimal64 **xvals, int x_dim, _Decimal64 const *params, _Decimal64 *f, gpointer user);
+typedef GORegressionResult (*GORegressionJacobianFunctionD) (_Decimal64 **xvals, int x_dim, _Decimal64 const *params, _Decimal64 **jac, gpointer user);
+
+GORegressionResult go_non_linear_regression_batchD (GORegressionBatchFunctionD f,
+						    GORegressionJacobianFunctionD jac,
+						    gpointer user,
+						    _Decimal64 **xvals,
+						    _Decimal64 *par,
+						    _Decimal64 *yvals,
+						    _Decimal64 *sigmas,
+						    int x_dim,
+						    int p_dim,
+						    _Decimal64 *chi,
+						    _Decimal64 *errors);
+
+GORegressionResult go_non_linear_regression_parallelD (GORegressionFunctionD f,
+						       _Decimal64 **xvals,
+						       _Decimal64 *par,
+						       _Decimal64 *yvals,
+						       _Decimal64 *sigmas,
+						       int x_dim,
+						       int p_dim,
+						       _Decimal64 *chi,
+						       _Decimal64 *errors);
+
+typedef struct GORegressionStateD_ GORegressionStateD;
+
+GORegressionStateD *go_regression_state_newD (int dim, gboolean affine);
+void go_regression_state_freeD (GORegressionStateD *state);
+void go_regression_state_appendD (GORegressionStateD *state,
+				  _Decimal64 const *xs, _Decimal64 y);
+gboolean go_regression_state_removeD (GORegressionStateD *state,
+				      _Decimal64 const *xs, _Decimal64 y);
+int go_regression_state_get_nD (GORegressionStateD const *state);
+GORegressionResult go_regression_state_get_resultD (GORegressionStateD *state,
+						    _Decimal64 *res,
+						    go_regression_stat_tD *stat_);
+
 gboolean    go_matrix_invertD 		(_Decimal64 **A, int n);
 _Decimal64 go_matrix_determinantD 	(_Decimal64 *const * const A, int n);
 
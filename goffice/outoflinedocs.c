@@ -52,6 +52,28 @@
  * @acc: accumulator
  **/
 
+/**
+ * go_accumulator_mergeD: (skip)
+ * @acc: accumulator
+ * @other: accumulator to add to @acc
+ *
+ * Adds the exact sum held by @other to @acc.  Since go_accumulator_value
+ * rounds correctly, accumulators filled with the parts of a set of values
+ * and merged give the same value as one accumulator filled with all of
+ * them, barring intermediate overflow.
+ **/
+
+/**
+ * go_accumulator_mergel: (skip)
+ * @acc: accumulator
+ * @other: accumulator to add to @acc
+ *
+ * Adds the exact sum held by @other to @acc.  Since go_accumulator_value
+ * rounds correctly, accumulators filled with the parts of a set of values
+ * and merged give the same value as one accumulator filled with all of
+ * them, barring intermediate overflow.
+ **/
+
 /**
  * go_accumulator_newD: (skip)
  **/
@@ -60,6 +82,22 @@
  * go_accumulator_newl: (skip)
  **/
 
+/**
+ * go_accumulator_roundD: (skip)
+ * @partials: non-overlapping partial sums in order of increasing magnitude
+ * @n: number of partials
+ *
+ * Returns: the correctly rounded sum of @partials.
+ **/
+
+/**
+ * go_accumulator_roundl: (skip)
+ * @partials: non-overlapping partial sums in order of increasing magnitude
+ * @n: number of partials
+ *
+ * Returns: the correctly rounded sum of @partials.
+ **/
+
 /**
  * go_accumulator_startD: (skip)
  **/
@@ -71,11 +109,15 @@
 /**
  * go_accumulator_valueD: (skip)
  * @acc: accumulator
+ *
+ * Returns: the sum of the values added, correctly rounded.
  **/
 
 /**
  * go_accumulator_valuel: (skip)
  * @acc: accumulator
+ *
+ * Returns: the sum of the values added, correctly rounded.
  **/
 
 /**
@@ -796,6 +838,90 @@
  * destroyed by a call to go_cspline_destroy.
  */
 
+/**
+ * go_cspline_refitD: (skip)
+ * @sp: a spline structure returned by go_cspline_init.
+ * @x: the x values
+ * @y: the y values
+ * @n: the number of x and y values
+ * @limits: how the limits must be treated, see go_cspline_init.
+ * @c0: the first derivative when using clamped splines.
+ * @cn: the last derivative when using clamped splines.
+ * @ws: (nullable): a workspace returned by go_cspline_workspace_new.
+ *
+ * Recomputes @sp for new data, as if it had been created by
+ * go_cspline_init with the same arguments.  The coefficient arrays are
+ * reused when @n is unchanged, and with @ws no scratch space needs to be
+ * allocated either, so refitting a spline to data that changes but keeps
+ * its size does not allocate at all.
+ *
+ * As with go_cspline_init, @sp keeps pointers to @x and @y.  All
+ * references to @sp see the new spline.
+ *
+ * Returns: %TRUE on success.  On failure, @sp is left unchanged.
+ */
+
+/**
+ * go_cspline_refitl: (skip)
+ * @sp: a spline structure returned by go_cspline_init.
+ * @x: the x values
+ * @y: the y values
+ * @n: the number of x and y values
+ * @limits: how the limits must be treated, see go_cspline_init.
+ * @c0: the first derivative when using clamped splines.
+ * @cn: the last derivative when using clamped splines.
+ * @ws: (nullable): a workspace returned by go_cspline_workspace_new.
+ *
+ * Recomputes @sp for new data, as if it had been created by
+ * go_cspline_init with the same arguments.  The coefficient arrays are
+ * reused when @n is unchanged, and with @ws no scratch space needs to be
+ * allocated either, so refitting a spline to data that changes but keeps
+ * its size does not allocate at all.
+ *
+ * As with go_cspline_init, @sp keeps pointers to @x and @y.  All
+ * references to @sp see the new spline.
+ *
+ * Returns: %TRUE on success.  On failure, @sp is left unchanged.
+ */
+
+/**
+ * go_cspline_workspace_freeD: (skip)
+ * @ws: a workspace returned by go_cspline_workspace_new.
+ *
+ * Frees the workspace.
+ */
+
+/**
+ * go_cspline_workspace_freel: (skip)
+ * @ws: a workspace returned by go_cspline_workspace_new.
+ *
+ * Frees the workspace.
+ */
+
+/**
+ * go_cspline_workspace_newD: (skip)
+ *
+ * Creates a workspace for go_cspline_refit.  Keeping one around for
+ * repeated refits means the scratch space for solving the tridiagonal
+ * system is allocated only once.  A workspace must not be used by more
+ * than one thread at a time.
+ *
+ * Returns: a new workspace which should be freed by a call to
+ * go_cspline_workspace_free.
+ */
+
+/**
+ * go_cspline_workspace_newl: (skip)
+ *
+ * Creates a workspace for go_cspline_refit.  Keeping one around for
+ * repeated refits means the scratch space for solving the tridiagonal
+ * system is allocated only once.  A workspace must not be used by more
+ * than one thread at a time.
+ *
+ * Returns: a new workspace which should be freed by a call to
+ * go_cspline_workspace_free.
+ */
+
 /**
  * go_exponential_regressionD:
  * @xss: x-vectors (i.e. independent data)
@@ -1028,6 +1154,112 @@
  * Returns: (transfer full): formatted value.
  **/
 
+/**
+ * go_format_values_gstringD:
+ * @dst: a GString to store (not append!) the resulting strings in.
+ * @offsets: (array length=n) (out caller-allocates): offsets into @dst
+ *           of the rendered values.
+ * @fmt: (nullable): #GOFormat
+ * @vals: (array length=n): floating-point values.  Must be finite.
+ * @n: number of values.
+ * @col_width: intended max width in characters.  -1 means no restriction.
+ * @date_conv: #GODateConventions
+ * @unicode_minus: Use unicode minuses, not hyphens.
+ *
+ * Render @n values with @fmt into a single string pool.  Each rendered
+ * value is terminated by a NUL character and the text for @vals[i] starts
+ * at @dst->str + @offsets[i].  Values that cannot be rendered with @fmt
+ * come out as "#####", like go_format_value() does.
+ *
+ * The result is the same as calling go_format_value_gstring() without a
+ * layout for each value, but unconditional formats are specialized only
+ * once and one scratch buffer is shared by all values.
+ *
+ * Returns: %GO_FORMAT_NUMBER_OK, or the error for the first value that
+ * could not be rendered.
+ **/
+
+/**
+ * go_format_values_gstringl:
+ * @dst: a GString to store (not append!) the resulting strings in.
+ * @offsets: (array length=n) (out caller-allocates): offsets into @dst
+ *           of the rendered values.
+ * @fmt: (nullable): #GOFormat
+ * @vals: (array length=n): floating-point values.  Must be finite.
+ * @n: number of values.
+ * @col_width: intended max width in characters.  -1 means no restriction.
+ * @date_conv: #GODateConventions
+ * @unicode_minus: Use unicode minuses, not hyphens.
+ *
+ * Render @n values with @fmt into a single string pool.  Each rendered
+ * value is terminated by a NUL character and the text for @vals[i] starts
+ * at @dst->str + @offsets[i].  Values that cannot be rendered with @fmt
+ * come out as "#####", like go_format_value() does.
+ *
+ * The result is the same as calling go_format_value_gstring() without a
+ * layout for each value, but unconditional formats are specialized only
+ * once and one scratch buffer is shared by all values.
+ *
+ * Returns: %GO_FORMAT_NUMBER_OK, or the error for the first value that
+ * could not be rendered.
+ **/
+
+/**
+ * go_fourier_fftD:
+ * @in: (array): input data.
+ * @n: number of values to transform.
+ * @skip: distance between consecutive values in @in.
+ * @fourier: (out) (transfer full) (array length=n): location for the
+ * transformed values.
+ * @inverse: whether to perform the inverse transform.
+ *
+ * Computes the discrete Fourier transform of @n values taken from @in,
+ * scaled by 1/@n.  Any @n works, but powers of two are fastest.  The
+ * twiddle factors are cached per size, so repeated transforms of the
+ * same size are cheap.
+ */
+
+/**
+ * go_fourier_fft_realD:
+ * @in: (array): input data.
+ * @n: number of values to transform.
+ * @skip: distance between consecutive values in @in.
+ * @fourier: (out) (transfer full) (array length=n): location for the
+ * transformed values.
+ *
+ * Computes the discrete Fourier transform of @n real values taken from
+ * @in, scaled by 1/@n, like go_fourier_fft.  For even @n this packs the
+ * values into a complex transform of half the size.
+ */
+
+/**
+ * go_fourier_fft_reall:
+ * @in: (array): input data.
+ * @n: number of values to transform.
+ * @skip: distance between consecutive values in @in.
+ * @fourier: (out) (transfer full) (array length=n): location for the
+ * transformed values.
+ *
+ * Computes the discrete Fourier transform of @n real values taken from
+ * @in, scaled by 1/@n, like go_fourier_fft.  For even @n this packs the
+ * values into a complex transform of half the size.
+ */
+
+/**
+ * go_fourier_fftl:
+ * @in: (array): input data.
+ * @n: number of values to transform.
+ * @skip: distance between consecutive values in @in.
+ * @fourier: (out) (transfer full) (array length=n): location for the
+ * transformed values.
+ * @inverse: whether to perform the inverse transform.
+ *
+ * Computes the discrete Fourier transform of @n values taken from @in,
+ * scaled by 1/@n.  Any @n works, but powers of two are fastest.  The
+ * twiddle factors are cached per size, so repeated transforms of the
+ * same size are cheap.
+ */
+
 /**
  * go_linear_regressionD:
  * @xss: x-vectors (i.e. independent data)
@@ -1172,7 +1404,11 @@
  * @chi: Chi Squared of the final result.  This value is not very
  * meaningful without the sigmas.
  * @errors: MUST ALREADY BE ALLOCATED.  These are the approximated standard
- * deviation for each parameter.
+ * deviation for each parameter, 1/sqrt(A[i][i]) where A = J J^T is the
+ * normal matrix and J the Jacobian of the model divided by @sigmas.  This
+ * ignores the correlation between parameters, so it is smaller than the
+ * standard error sqrt((A^-1)[i][i]) reported by
+ * go_non_linear_regression_batch unless the parameters are uncorrelated.
  *
  * SYNOPSIS:
  *   result = non_linear_regression (f, xvals, par, yvals, sigmas,
@@ -1183,6 +1419,124 @@
  * The resulting parameters are placed back into @par.
  **/
 
+/**
+ * go_non_linear_regression_batchD:
+ * @f: (scope call): the model function, evaluated at all points at once
+ * @jac: (scope call) (nullable): the Jacobian of the model, or %NULL to
+ * approximate it by finite differences of @f.  It must store the derivative
+ * of the model at xvals[k] with respect to params[j] in jac[j][k].
+ * @user: user data for @f and @jac
+ * @xvals: independent values.
+ * @par: model parameters.
+ * @yvals: dependent values.
+ * @sigmas: (nullable): standard deviations for the dependent values.
+ * @x_dim: Number of data points.
+ * @p_dim: Number of parameters.
+ * @chi: (out): Chi Squared of the final result.
+ * @errors: (out): MUST ALREADY BE ALLOCATED.  The standard error of each
+ * parameter, sqrt((A^-1)[i][i]) where A = J J^T is the normal matrix and J
+ * the Jacobian of the model divided by @sigmas, or -1 if A is singular.
+ * Unlike the errors of go_non_linear_regression, which are
+ * 1/sqrt(A[i][i]), these account for correlation between parameters and
+ * are never smaller.
+ *
+ * Non linear regression by the Levenberg-Marquardt method.  Unlike
+ * go_non_linear_regression, the model is evaluated once per point per
+ * function call and the residuals and Jacobian computed in an iteration
+ * are used for both the gradient and the normal matrix.  When a step is
+ * rejected only the damping changes, so the normal matrix is factored
+ * again but the model is not re-evaluated.
+ *
+ * Returns: the result of the non-linear regression from the given initial
+ * values.  The resulting parameters are placed back into @par.
+ **/
+
+/**
+ * go_non_linear_regression_batchl:
+ * @f: (scope call): the model function, evaluated at all points at once
+ * @jac: (scope call) (nullable): the Jacobian of the model, or %NULL to
+ * approximate it by finite differences of @f.  It must store the derivative
+ * of the model at xvals[k] with respect to params[j] in jac[j][k].
+ * @user: user data for @f and @jac
+ * @xvals: independent values.
+ * @par: model parameters.
+ * @yvals: dependent values.
+ * @sigmas: (nullable): standard deviations for the dependent values.
+ * @x_dim: Number of data points.
+ * @p_dim: Number of parameters.
+ * @chi: (out): Chi Squared of the final result.
+ * @errors: (out): MUST ALREADY BE ALLOCATED.  The standard error of each
+ * parameter, sqrt((A^-1)[i][i]) where A = J J^T is the normal matrix and J
+ * the Jacobian of the model divided by @sigmas, or -1 if A is singular.
+ * Unlike the errors of go_non_linear_regression, which are
+ * 1/sqrt(A[i][i]), these account for correlation between parameters and
+ * are never smaller.
+ *
+ * Non linear regression by the Levenberg-Marquardt method.  Unlike
+ * go_non_linear_regression, the model is evaluated once per point per
+ * function call and the residuals and Jacobian computed in an iteration
+ * are used for both the gradient and the normal matrix.  When a step is
+ * rejected only the damping changes, so the normal matrix is factored
+ * again but the model is not re-evaluated.
+ *
+ * Returns: the result of the non-linear regression from the given initial
+ * values.  The resulting parameters are placed back into @par.
+ **/
+
+/**
+ * go_non_linear_regression_parallelD:
+ * @f: (scope call): the model function
+ * @xvals: independent values.
+ * @par: model parameters.
+ * @yvals: dependent values.
+ * @sigmas: (nullable): standard deviations for the dependent values.
+ * @x_dim: Number of data points.
+ * @p_dim: Number of parameters.
+ * @chi: (out): Chi Squared of the final result.
+ * @errors: (out): MUST ALREADY BE ALLOCATED.  The standard error of each
+ * parameter, or -1 if it cannot be determined.  See
+ * go_non_linear_regression_batch.
+ *
+ * Non linear regression by the same method as
+ * go_non_linear_regression_batch, but with a model evaluated one point at
+ * a time.  The evaluation of the residuals and of the Jacobian is split
+ * over threads, so @f must be safe to call from several threads at once.
+ * The parameters passed to @f are a private copy per thread.
+ *
+ * The partial sums of the threads are merged exactly and in a fixed
+ * order, so the result does not depend on the number of threads.
+ *
+ * Returns: the result of the non-linear regression from the given initial
+ * values.  The resulting parameters are placed back into @par.
+ **/
+
+/**
+ * go_non_linear_regression_parallell:
+ * @f: (scope call): the model function
+ * @xvals: independent values.
+ * @par: model parameters.
+ * @yvals: dependent values.
+ * @sigmas: (nullable): standard deviations for the dependent values.
+ * @x_dim: Number of data points.
+ * @p_dim: Number of parameters.
+ * @chi: (out): Chi Squared of the final result.
+ * @errors: (out): MUST ALREADY BE ALLOCATED.  The standard error of each
+ * parameter, or -1 if it cannot be determined.  See
+ * go_non_linear_regression_batch.
+ *
+ * Non linear regression by the same method as
+ * go_non_linear_regression_batch, but with a model evaluated one point at
+ * a time.  The evaluation of the residuals and of the Jacobian is split
+ * over threads, so @f must be safe to call from several threads at once.
+ * The parameters passed to @f are a private copy per thread.
+ *
+ * The partial sums of the threads are merged exactly and in a fixed
+ * order, so the result does not depend on the number of threads.
+ *
+ * Returns: the result of the non-linear regression from the given initial
+ * values.  The resulting parameters are placed back into @par.
+ **/
+
 /**
  * go_non_linear_regressionl:
  * @f: (scope call): the model function
@@ -1195,7 +1549,11 @@
  * @chi: Chi Squared of the final result.  This value is not very
  * meaningful without the sigmas.
  * @errors: MUST ALREADY BE ALLOCATED.  These are the approximated standard
- * deviation for each parameter.
+ * deviation for each parameter, 1/sqrt(A[i][i]) where A = J J^T is the
+ * normal matrix and J the Jacobian of the model divided by @sigmas.  This
+ * ignores the correlation between parameters, so it is smaller than the
+ * standard error sqrt((A^-1)[i][i]) reported by
+ * go_non_linear_regression_batch unless the parameters are uncorrelated.
  *
  * SYNOPSIS:
  *   result = non_linear_regression (f, xvals, par, yvals, sigmas,
@@ -1206,6 +1564,98 @@
  * The resulting parameters are placed back into @par.
  **/
 
+/**
+ * go_plnorm_vD:
+ * @x: (array length=n): values
+ * @out: (out) (array length=n): location for results
+ * @n: number of values
+ * @logmean: mean of the underlying normal distribution
+ * @logsd: standard deviation of the underlying normal distribution
+ * @lower_tail: if %TRUE, compute P(X &le; x)
+ * @log_p: if %TRUE, return the logarithm of the probability
+ *
+ * Stores go_plnorm (@x[i], @logmean, @logsd, @lower_tail, @log_p) in
+ * @out[i] for all i.  @x and @out may be the same array.
+ */
+
+/**
+ * go_plnorm_vl:
+ * @x: (array length=n): values
+ * @out: (out) (array length=n): location for results
+ * @n: number of values
+ * @logmean: mean of the underlying normal distribution
+ * @logsd: standard deviation of the underlying normal distribution
+ * @lower_tail: if %TRUE, compute P(X &le; x)
+ * @log_p: if %TRUE, return the logarithm of the probability
+ *
+ * Stores go_plnorm (@x[i], @logmean, @logsd, @lower_tail, @log_p) in
+ * @out[i] for all i.  @x and @out may be the same array.
+ */
+
+/**
+ * go_pnorm_vD:
+ * @x: (array length=n): values
+ * @out: (out) (array length=n): location for results
+ * @n: number of values
+ * @mu: mean of the distribution
+ * @sigma: standard deviation of the distribution
+ * @lower_tail: if %TRUE, compute P(X &le; x)
+ * @log_p: if %TRUE, return the logarithm of the probability
+ *
+ * Stores go_pnorm (@x[i], @mu, @sigma, @lower_tail, @log_p) in @out[i]
+ * for all i.  @x and @out may be the same array.
+ */
+
+/**
+ * go_pnorm_vl:
+ * @x: (array length=n): values
+ * @out: (out) (array length=n): location for results
+ * @n: number of values
+ * @mu: mean of the distribution
+ * @sigma: standard deviation of the distribution
+ * @lower_tail: if %TRUE, compute P(X &le; x)
+ * @log_p: if %TRUE, return the logarithm of the probability
+ *
+ * Stores go_pnorm (@x[i], @mu, @sigma, @lower_tail, @log_p) in @out[i]
+ * for all i.  @x and @out may be the same array.
+ */
+
+/**
+ * go_polynomial_eval_vD:
+ * @a: (array): coefficients, constant term first
+ * @deg: degree of the polynomial, i.e., @a has @deg+1 elements
+ * @x: (array length=n): points
+ * @y: (out) (array length=n): result locations
+ * @n: number of points
+ *
+ * Evaluates the polynomial at @n points using compensated Horner: the
+ * rounding errors of each step are captured with error-free
+ * transformations and added back at the end, so the result is about as
+ * accurate as plain Horner in twice the precision.  That matters for
+ * large x, dates for example, where the terms cancel badly.
+ *
+ * The result for each point does not depend on the other points, so this
+ * is identical to evaluating the points one by one.
+ **/
+
+/**
+ * go_polynomial_eval_vl:
+ * @a: (array): coefficients, constant term first
+ * @deg: degree of the polynomial, i.e., @a has @deg+1 elements
+ * @x: (array length=n): points
+ * @y: (out) (array length=n): result locations
+ * @n: number of points
+ *
+ * Evaluates the polynomial at @n points using compensated Horner: the
+ * rounding errors of each step are captured with error-free
+ * transformations and added back at the end, so the result is about as
+ * accurate as plain Horner in twice the precision.  That matters for
+ * large x, dates for example, where the terms cancel badly.
+ *
+ * The result for each point does not depend on the other points, so this
+ * is identical to evaluating the points one by one.
+ **/
+
 /**
  * go_pow10D:
  * @n: exponent
@@ -1290,6 +1740,90 @@
  * Returns: @x^@y.
  */
 
+/**
+ * go_pweibull_vD:
+ * @x: (array length=n): values
+ * @out: (out) (array length=n): location for results
+ * @n: number of values
+ * @shape: shape parameter of the distribution
+ * @scale: scale parameter of the distribution
+ * @lower_tail: if %TRUE, compute P(X &le; x)
+ * @log_p: if %TRUE, return the logarithm of the probability
+ *
+ * Stores go_pweibull (@x[i], @shape, @scale, @lower_tail, @log_p) in
+ * @out[i] for all i.  @x and @out may be the same array.
+ */
+
+/**
+ * go_pweibull_vl:
+ * @x: (array length=n): values
+ * @out: (out) (array length=n): location for results
+ * @n: number of values
+ * @shape: shape parameter of the distribution
+ * @scale: scale parameter of the distribution
+ * @lower_tail: if %TRUE, compute P(X &le; x)
+ * @log_p: if %TRUE, return the logarithm of the probability
+ *
+ * Stores go_pweibull (@x[i], @shape, @scale, @lower_tail, @log_p) in
+ * @out[i] for all i.  @x and @out may be the same array.
+ */
+
+/**
+ * go_qlnorm_vD:
+ * @p: (array length=n): probabilities
+ * @out: (out) (array length=n): location for results
+ * @n: number of probabilities
+ * @logmean: mean of the underlying normal distribution
+ * @logsd: standard deviation of the underlying normal distribution
+ * @lower_tail: if %TRUE, @p are lower tail probabilities
+ * @log_p: if %TRUE, @p are logarithms of probabilities
+ *
+ * Stores go_qlnorm (@p[i], @logmean, @logsd, @lower_tail, @log_p) in
+ * @out[i] for all i.  @p and @out may be the same array.
+ */
+
+/**
+ * go_qlnorm_vl:
+ * @p: (array length=n): probabilities
+ * @out: (out) (array length=n): location for results
+ * @n: number of probabilities
+ * @logmean: mean of the underlying normal distribution
+ * @logsd: standard deviation of the underlying normal distribution
+ * @lower_tail: if %TRUE, @p are lower tail probabilities
+ * @log_p: if %TRUE, @p are logarithms of probabilities
+ *
+ * Stores go_qlnorm (@p[i], @logmean, @logsd, @lower_tail, @log_p) in
+ * @out[i] for all i.  @p and @out may be the same array.
+ */
+
+/**
+ * go_qnorm_vD:
+ * @p: (array length=n): probabilities
+ * @out: (out) (array length=n): location for results
+ * @n: number of probabilities
+ * @mu: mean of the distribution
+ * @sigma: standard deviation of the distribution
+ * @lower_tail: if %TRUE, @p are lower tail probabilities
+ * @log_p: if %TRUE, @p are logarithms of probabilities
+ *
+ * Stores go_qnorm (@p[i], @mu, @sigma, @lower_tail, @log_p) in @out[i]
+ * for all i.  @p and @out may be the same array.
+ */
+
+/**
+ * go_qnorm_vl:
+ * @p: (array length=n): probabilities
+ * @out: (out) (array length=n): location for results
+ * @n: number of probabilities
+ * @mu: mean of the distribution
+ * @sigma: standard deviation of the distribution
+ * @lower_tail: if %TRUE, @p are lower tail probabilities
+ * @log_p: if %TRUE, @p are logarithms of probabilities
+ *
+ * Stores go_qnorm (@p[i], @mu, @sigma, @lower_tail, @log_p) in @out[i]
+ * for all i.  @p and @out may be the same array.
+ */
+
 /**
  * go_quad_absD:
  * @res: (out): result location
@@ -1396,6 +1930,28 @@
  * by pi, storing the result in @res.
  **/
 
+/**
+ * go_quad_axpy_vD:
+ * @y: (array length=n) (inout): vector of quad-precision values
+ * @a: quad-precision value
+ * @x: (array length=n): vector of quad-precision values
+ * @n: length of vectors.
+ *
+ * This function adds @a times @x to @y.  The results are identical to
+ * using go_quad_mul and go_quad_add for each element.
+ **/
+
+/**
+ * go_quad_axpy_vl:
+ * @y: (array length=n) (inout): vector of quad-precision values
+ * @a: quad-precision value
+ * @x: (array length=n): vector of quad-precision values
+ * @n: length of vectors.
+ *
+ * This function adds @a times @x to @y.  The results are identical to
+ * using go_quad_mul and go_quad_add for each element.
+ **/
+
 /**
  * go_quad_constant8D:
  * @res: (out): result location
@@ -1480,6 +2036,34 @@
  * @n: length of vectors.
  **/
 
+/**
+ * go_quad_dot_product_vD:
+ * @res: (out) (array length=m): result locations
+ * @a: (array length=n): vector of quad-precision values
+ * @b: (array): n-by-m matrix of quad-precision values stored by rows
+ * @n: length of @a.
+ * @m: number of columns of @b.
+ *
+ * This function computes the dot products of @a with each of the columns
+ * of @b, storing them in @res.  The results are identical to calling
+ * go_quad_dot_product for each column, but the columns are handled side
+ * by side which is a good deal faster.
+ **/
+
+/**
+ * go_quad_dot_product_vl:
+ * @res: (out) (array length=m): result locations
+ * @a: (array length=n): vector of quad-precision values
+ * @b: (array): n-by-m matrix of quad-precision values stored by rows
+ * @n: length of @a.
+ * @m: number of columns of @b.
+ *
+ * This function computes the dot products of @a with each of the columns
+ * of @b, storing them in @res.  The results are identical to calling
+ * go_quad_dot_product for each column, but the columns are handled side
+ * by side which is a good deal faster.
+ **/
+
 /**
  * go_quad_dot_productl:
  * @res: (out): result location
@@ -1642,6 +2226,38 @@
  * This function solves the triangular system R*x=b.
  **/
 
+/**
+ * go_quad_matrix_back_solve_multiD:
+ * @R: An upper triangular matrix.
+ * @X: (out): Result matrix.
+ * @B: Input matrix.
+ * @allow_degenerate: If %TRUE, then degenerate dimensions are ignored other
+ * than being given a zero result.  A degenerate dimension is one whose
+ * diagonal entry is zero.
+ *
+ * Returns: %TRUE on error.
+ *
+ * This function solves the triangular system R*X=B, i.e., it does
+ * go_quad_matrix_back_solve for all columns of @B at once, and much faster
+ * than column by column.  @X may be the same matrix as @B.
+ **/
+
+/**
+ * go_quad_matrix_back_solve_multil:
+ * @R: An upper triangular matrix.
+ * @X: (out): Result matrix.
+ * @B: Input matrix.
+ * @allow_degenerate: If %TRUE, then degenerate dimensions are ignored other
+ * than being given a zero result.  A degenerate dimension is one whose
+ * diagonal entry is zero.
+ *
+ * Returns: %TRUE on error.
+ *
+ * This function solves the triangular system R*X=B, i.e., it does
+ * go_quad_matrix_back_solve for all columns of @B at once, and much faster
+ * than column by column.  @X may be the same matrix as @B.
+ **/
+
 /**
  * go_quad_matrix_back_solvel:
  * @R: An upper triangular matrix.
@@ -1760,6 +2376,38 @@
  * This function solves the triangular system RT*x=b.
  **/
 
+/**
+ * go_quad_matrix_fwd_solve_multiD:
+ * @R: An upper triangular matrix.
+ * @X: (out): Result matrix.
+ * @B: Input matrix.
+ * @allow_degenerate: If %TRUE, then degenerate dimensions are ignored other
+ * than being given a zero result.  A degenerate dimension is one whose
+ * diagonal entry is zero.
+ *
+ * Returns: %TRUE on error.
+ *
+ * This function solves the triangular system RT*X=B, i.e., it does
+ * go_quad_matrix_fwd_solve for all columns of @B at once, and much faster
+ * than column by column.  @X may be the same matrix as @B.
+ **/
+
+/**
+ * go_quad_matrix_fwd_solve_multil:
+ * @R: An upper triangular matrix.
+ * @X: (out): Result matrix.
+ * @B: Input matrix.
+ * @allow_degenerate: If %TRUE, then degenerate dimensions are ignored other
+ * than being given a zero result.  A degenerate dimension is one whose
+ * diagonal entry is zero.
+ *
+ * Returns: %TRUE on error.
+ *
+ * This function solves the triangular system RT*X=B, i.e., it does
+ * go_quad_matrix_fwd_solve for all columns of @B at once, and much faster
+ * than column by column.  @X may be the same matrix as @B.
+ **/
+
 /**
  * go_quad_matrix_fwd_solvel:
  * @R: An upper triangular matrix.
@@ -2186,6 +2834,34 @@
  * this may be called outside go_quad_start and go_quad_end sections.
  **/
 
+/**
+ * go_qweibull_vD:
+ * @p: (array length=n): probabilities
+ * @out: (out) (array length=n): location for results
+ * @n: number of probabilities
+ * @shape: shape parameter of the distribution
+ * @scale: scale parameter of the distribution
+ * @lower_tail: if %TRUE, @p are lower tail probabilities
+ * @log_p: if %TRUE, @p are logarithms of probabilities
+ *
+ * Stores go_qweibull (@p[i], @shape, @scale, @lower_tail, @log_p) in
+ * @out[i] for all i.  @p and @out may be the same array.
+ */
+
+/**
+ * go_qweibull_vl:
+ * @p: (array length=n): probabilities
+ * @out: (out) (array length=n): location for results
+ * @n: number of probabilities
+ * @shape: shape parameter of the distribution
+ * @scale: scale parameter of the distribution
+ * @lower_tail: if %TRUE, @p are lower tail probabilities
+ * @log_p: if %TRUE, @p are logarithms of probabilities
+ *
+ * Stores go_qweibull (@p[i], @shape, @scale, @lower_tail, @log_p) in
+ * @out[i] for all i.  @p and @out may be the same array.
+ */
+
 /**
  * go_range_averageD:
  * @xs: (array length=n): values.
@@ -2346,6 +3022,70 @@
  * Returns: 0 unless an error occurred.
  */
 
+/**
+ * go_range_fractilesD:
+ * @xs: (array length=n): values.
+ * @n: number of values
+ * @res: (out) (array length=nf): results.
+ * @fs: (array length=nf): fractiles
+ * @nf: number of fractiles
+ *
+ * This function computes the interpolated fractiles given by @fs and
+ * stores them in @res.
+ *
+ * Returns: 0 unless an error occurred.
+ */
+
+/**
+ * go_range_fractiles_nonconstD:
+ * @xs: (array length=n): values.
+ * @n: number of values
+ * @res: (out) (array length=nf): results.
+ * @fs: (array length=nf): fractiles
+ * @nf: number of fractiles
+ *
+ * This function computes the interpolated fractiles given by @fs and
+ * stores them in @res.  This takes time proportional to @n rather than
+ * sorting @xs.
+ * This function reorders the elements of @xs: the order statistics
+ * used end up in their sorted positions with smaller values before and
+ * larger values after each of them.
+ *
+ * Returns: 0 unless an error occurred.
+ */
+
+/**
+ * go_range_fractiles_nonconstl:
+ * @xs: (array length=n): values.
+ * @n: number of values
+ * @res: (out) (array length=nf): results.
+ * @fs: (array length=nf): fractiles
+ * @nf: number of fractiles
+ *
+ * This function computes the interpolated fractiles given by @fs and
+ * stores them in @res.  This takes time proportional to @n rather than
+ * sorting @xs.
+ * This function reorders the elements of @xs: the order statistics
+ * used end up in their sorted positions with smaller values before and
+ * larger values after each of them.
+ *
+ * Returns: 0 unless an error occurred.
+ */
+
+/**
+ * go_range_fractilesl:
+ * @xs: (array length=n): values.
+ * @n: number of values
+ * @res: (out) (array length=nf): results.
+ * @fs: (array length=nf): fractiles
+ * @nf: number of fractiles
+ *
+ * This function computes the interpolated fractiles given by @fs and
+ * stores them in @res.
+ *
+ * Returns: 0 unless an error occurred.
+ */
+
 /**
  * go_range_increasingD:
  * @xs: (array length=n): values.
@@ -2521,6 +3261,32 @@
  * Returns: 0 unless an error occurred.
  */
 
+/**
+ * go_range_sum_parallelD:
+ * @xs: (array length=n): values.
+ * @n: number of values
+ * @res: (out): result.
+ *
+ * The arithmetic sum of the input values will be stored in @res.  Large
+ * ranges are split across threads whose partial sums are merged exactly,
+ * so the result is the same as that of go_range_sum.
+ *
+ * Returns: 0 unless an error occurred.
+ */
+
+/**
+ * go_range_sum_parallell:
+ * @xs: (array length=n): values.
+ * @n: number of values
+ * @res: (out): result.
+ *
+ * The arithmetic sum of the input values will be stored in @res.  Large
+ * ranges are split across threads whose partial sums are merged exactly,
+ * so the result is the same as that of go_range_sum.
+ *
+ * Returns: 0 unless an error occurred.
+ */
+
 /**
  * go_range_suml:
  * @xs: (array length=n): values.
@@ -2598,6 +3364,142 @@
   * returned in @k.
   */
 
+/**
+ * go_regression_state_appendD:
+ * @state: #GORegressionState
+ * @xs: (array): the x-values of the observation, one for each x-vector
+ * @y: the y-value of the observation
+ *
+ * Adds an observation to @state.  The triangular factor is updated by
+ * Givens rotations.
+ **/
+
+/**
+ * go_regression_state_appendl:
+ * @state: #GORegressionState
+ * @xs: (array): the x-values of the observation, one for each x-vector
+ * @y: the y-value of the observation
+ *
+ * Adds an observation to @state.  The triangular factor is updated by
+ * Givens rotations.
+ **/
+
+/**
+ * go_regression_state_freeD: (skip)
+ * @state: (transfer full): #GORegressionState to free
+ *
+ * Frees @state and its associated data.
+ **/
+
+/**
+ * go_regression_state_freel: (skip)
+ * @state: (transfer full): #GORegressionState to free
+ *
+ * Frees @state and its associated data.
+ **/
+
+/**
+ * go_regression_state_get_nD:
+ * @state: #GORegressionState
+ *
+ * Returns: the number of observations currently in @state.
+ **/
+
+/**
+ * go_regression_state_get_nl:
+ * @state: #GORegressionState
+ *
+ * Returns: the number of observations currently in @state.
+ **/
+
+/**
+ * go_regression_state_get_resultD:
+ * @state: #GORegressionState
+ * @res: output place for constant[0] and slope1[1], slope2[2],... There
+ * will be dim+1 results.
+ * @stat_: (out) (optional): storage for additional results.
+ *
+ * Computes the linear regression of the observations in @state, just as
+ * go_linear_regression would.  This costs O(dim^3) regardless of the number
+ * of observations.
+ *
+ * Returns: #GORegressionResult as above.
+ **/
+
+/**
+ * go_regression_state_get_resultl:
+ * @state: #GORegressionState
+ * @res: output place for constant[0] and slope1[1], slope2[2],... There
+ * will be dim+1 results.
+ * @stat_: (out) (optional): storage for additional results.
+ *
+ * Computes the linear regression of the observations in @state, just as
+ * go_linear_regression would.  This costs O(dim^3) regardless of the number
+ * of observations.
+ *
+ * Returns: #GORegressionResult as above.
+ **/
+
+/**
+ * go_regression_state_newD: (skip)
+ * @dim: number of x-vectors
+ * @affine: if %TRUE, a non-zero constant is allowed
+ *
+ * Creates an empty state for incremental linear regression.  Observations
+ * are added and removed with go_regression_state_append and
+ * go_regression_state_remove, each at a cost of O(@dim^2) regardless of
+ * the number of observations.  The results are then available through
+ * go_regression_state_get_result.
+ *
+ * Returns: (transfer full): a new #GORegressionState.
+ **/
+
+/**
+ * go_regression_state_newl: (skip)
+ * @dim: number of x-vectors
+ * @affine: if %TRUE, a non-zero constant is allowed
+ *
+ * Creates an empty state for incremental linear regression.  Observations
+ * are added and removed with go_regression_state_append and
+ * go_regression_state_remove, each at a cost of O(@dim^2) regardless of
+ * the number of observations.  The results are then available through
+ * go_regression_state_get_result.
+ *
+ * Returns: (transfer full): a new #GORegressionState.
+ **/
+
+/**
+ * go_regression_state_removeD:
+ * @state: #GORegressionState
+ * @xs: (array): the x-values of the observation, one for each x-vector
+ * @y: the y-value of the observation
+ *
+ * Removes an observation, previously added with go_regression_state_append,
+ * from @state.  This downdates the triangular factor as in LINPACK's dchdd.
+ *
+ * That is not possible when the remaining observations do not determine
+ * the regression.  In that case @state is left unchanged and must be
+ * rebuilt from scratch.
+ *
+ * Returns: %TRUE on error.
+ **/
+
+/**
+ * go_regression_state_removel:
+ * @state: #GORegressionState
+ * @xs: (array): the x-values of the observation, one for each x-vector
+ * @y: the y-value of the observation
+ *
+ * Removes an observation, previously added with go_regression_state_append,
+ * from @state.  This downdates the triangular factor as in LINPACK's dchdd.
+ *
+ * That is not possible when the remaining observations do not determine
+ * the regression.  In that case @state is left unchanged and must be
+ * rebuilt from scratch.
+ *
+ * Returns: %TRUE on error.
+ **/
+
 /**
  * go_render_generalD:
  * @layout: Optional #PangoLayout, probably preseeded with font attribute.
@@ -34,6 +34,7 @@ static GHashTable	*font_hash;
 static GPtrArray	*font_array;
 static GSList		*font_watchers;
 static GOFont const	*font_default;
+static GQuark		 font_advances_quark;
 
 #if 0
 #define ref_debug(x)	x
@@ -384,6 +385,106 @@ go_font_metrics_new (PangoContext *context, GOFont const *font)
 	return res;
 }
 
+/*
+ * Advance widths of single characters in one font.  They are measured
+ * when first asked for and kept with the PangoContext, as they depend on
+ * its font map and resolution.
+ */
+struct _GOFontAdvances {
+	PangoLayout *layout;	/* For measuring */
+	int ascii[128];		/* -1 if not measured yet */
+	GHashTable *others;	/* gunichar -> width */
+};
+
+static void
+go_font_advances_free (GOFontAdvances *adv)
+{
+	g_object_unref (adv->layout);
+	g_hash_table_destroy (adv->others);
+	g_free (adv);
+}
+
+/**
+ * _go_font_advances_for_layout: (skip)
+ * @layout: #PangoLayout
+ *
+ * Returns: (transfer none): the advance width table for the font of
+ * @layout.  Changes to the resolution of the context after the first call
+ * are not noticed.
+ **/
+GOFontAdvances *
+_go_font_advances_for_layout (PangoLayout *layout)
+{
+	PangoContext *context = pango_layout_get_context (layout);
+	PangoFontDescription const *desc =
+		pango_layout_get_font_description (layout);
+	GHashTable *tables;
+	GOFontAdvances *res;
+
+	if (!desc)
+		desc = pango_context_get_font_description (context);
+
+	tables = g_object_get_qdata (G_OBJECT (context), font_advances_quark);
+	if (!tables) {
+		tables = g_hash_table_new_full (
+			(GHashFunc)pango_font_description_hash,
+			(GEqualFunc)pango_font_description_equal,
+			(GDestroyNotify)pango_font_description_free,
+			(GDestroyNotify)go_font_advances_free);
+		g_object_set_qdata_full (G_OBJECT (context),
+					 font_advances_quark, tables,
+					 (GDestroyNotify)g_hash_table_destroy);
+	}
+
+	res = g_hash_table_lookup (tables, desc);
+	if (!res) {
+		int i;
+
+		res = g_new (GOFontAdvances, 1);
+		res->layout = pango_layout_new (context);
+		pango_layout_set_font_description (res->layout, desc);
+		for (i = 0; i < 128; i++)
+			res->ascii[i] = -1;
+		res->others = g_hash_table_new (NULL, NULL);
+		g_hash_table_insert (tables,
+				     pango_font_description_copy (desc), res);
+	}
+
+	return res;
+}
+
+/**
+ * _go_font_advances_get: (skip)
+ * @adv: advance width table
+ * @uc: character
+ *
+ * Returns: the advance width of @uc on its own, in Pango units.
+ **/
+int
+_go_font_advances_get (GOFontAdvances *adv, gunichar uc)
+{
+	char buf[8];
+	gpointer val;
+	int w;
+
+	if (uc < 128 && adv->ascii[uc] >= 0)
+		return adv->ascii[uc];
+	if (uc >= 128 &&
+	    g_hash_table_lookup_extended (adv->others, GUINT_TO_POINTER (uc),
+					  NULL, &val))
+		return GPOINTER_TO_INT (val);
+
+	pango_layout_set_text (adv->layout, buf, g_unichar_to_utf8 (uc, buf));
+	pango_layout_get_size (adv->layout, &w, NULL);
+
+	if (uc < 128)
+		adv->ascii[uc] = w;
+	else
+		g_hash_table_insert (adv->others, GUINT_TO_POINTER (uc),
+				     GINT_TO_POINTER (w));
+	return w;
+}
+
 
 /**
  * go_font_metrics_free:
@@ -448,6 +549,8 @@ _go_fonts_init (void)
 	go_font_metrics_unit_var.thin_space = 0;
 	go_font_metrics_unit_var.thin_space_width = 1;
 
+	font_advances_quark = g_quark_from_static_string ("go-font-advances");
+
 	font_array = g_ptr_array_new ();
 	font_hash = g_hash_table_new_full (
 		(GHashFunc)pango_font_description_hash,
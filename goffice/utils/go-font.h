@@ -80,6 +80,10 @@ void go_font_cache_unregister (GClosure *callback);
 void _go_fonts_init     (void);
 void _go_fonts_shutdown (void);
 
+typedef struct _GOFontAdvances GOFontAdvances;
+GOFontAdvances *_go_font_advances_for_layout (PangoLayout *layout);
+int _go_font_advances_get (GOFontAdvances *adv, gunichar uc);
+
 G_END_DECLS
 
 #endif /* GO_FONT_H */
@@ -326,6 +326,17 @@ typedef enum {
 	GO_FMT_POSITION_MARKERS = 2
 } GOFormatShapeFlags;
 
+/*
+ * Number formats whose program has one of these shapes are rendered by
+ * SUFFIX(go_format_execute_fast) without running the interpreter.
+ */
+typedef enum {
+	GO_FMT_FAST_NONE,
+	GO_FMT_FAST_GENERAL,	/* General */
+	GO_FMT_FAST_FIXED,	/* 0, 0.00, #,##0.00, 0%, ... */
+	GO_FMT_FAST_SCIENTIFIC	/* 0.00E+00, ... */
+} GOFormatFastPath;
+
 typedef struct {
 	GOFormatConditionOp op;
 	unsigned implicit : 1;
@@ -341,13 +352,23 @@ typedef struct {
 } GOFormatLocale;
 
 
+typedef struct _GOFormatRenderCache GOFormatRenderCache;
+
+/*
+ * Once created, a GOFormat is never changed and may be used from any
+ * thread.  The reference count is atomic and the interning hash is
+ * protected by a lock.  (Rendering a format with a locale, "[$-xxx]",
+ * still temporarily changes the process' locale.)
+ */
 struct _GOFormat {
 	unsigned int typ : 8;
-	unsigned int ref_count : 24;
+	int ref_count;
 	GOColor color;
 	unsigned int has_fill : 7;
 	GOFormatMagic magic;
 	char *format;
+	/* Not part of the value; see go_format_render_cache_lookup.  */
+	GOFormatRenderCache *render_cache;
 	union {
 		struct {
 			int n;
@@ -374,6 +395,15 @@ struct _GOFormat {
 			unsigned int scale_is_2  : 1;
 			unsigned int has_general : 1;
 			unsigned int is_general  : 1;
+			/* See go_format_detect_fast_path: */
+			unsigned int fast_path   : 2;
+			unsigned int fast_thousands : 1;
+			unsigned int fast_percent   : 1;
+			unsigned int fast_point     : 1;
+			unsigned int fast_exp_sign  : 1;
+			guint8 fast_decimals;
+			guint8 fast_zeros;
+			guint8 fast_exp_zeros;
 		} number;
 
 		struct {
@@ -666,6 +696,7 @@ static GOFormat *default_empty_fmt;
 
 /* WARNING : Global */
 static GHashTable *style_format_hash = NULL;
+G_LOCK_DEFINE_STATIC (style_format_hash);
 
 /**
  * go_format_foreach:
@@ -677,9 +708,26 @@ static GHashTable *style_format_hash = NULL;
 void
 go_format_foreach (GHFunc func, gpointer user_data)
 {
-	if (style_format_hash != NULL)
-		g_hash_table_foreach  (style_format_hash,
-				       func, user_data);
+	GPtrArray *fmts = g_ptr_array_new ();
+	GHashTableIter iter;
+	gpointer value;
+	unsigned ui;
+
+	/* Don't call out with the lock held.  */
+	G_LOCK (style_format_hash);
+	if (style_format_hash != NULL) {
+		g_hash_table_iter_init (&iter, style_format_hash);
+		while (g_hash_table_iter_next (&iter, NULL, &value))
+			g_ptr_array_add (fmts, go_format_ref (value));
+	}
+	G_UNLOCK (style_format_hash);
+
+	for (ui = 0; ui < fmts->len; ui++) {
+		GOFormat *fmt = g_ptr_array_index (fmts, ui);
+		func (fmt->format, fmt, user_data);
+		go_format_unref (fmt);
+	}
+	g_ptr_array_free (fmts, TRUE);
 }
 
 /* used to generate formats when delocalizing so keep the leadings caps */
@@ -2407,6 +2455,153 @@ go_format_parse_number_fraction (GOFormatParseState *pstate)
 	return fmt;
 }
 
+/*
+ * Match the whole-part digits of a number program: a run of '0' digits
+ * followed by a run of '#' digits (we see them right-to-left) and then
+ * the rest of the whole part.
+ */
+static const guchar *
+go_format_detect_fast_whole (const guchar *prg, int *zeros)
+{
+	int z = 0;
+
+	while (prg[0] == OP_NUM_DIGIT_1 && prg[1] == '0') {
+		z++;
+		prg += 2;
+	}
+	while (prg[0] == OP_NUM_DIGIT_1 && prg[1] == '#')
+		prg += 2;
+	if (*prg++ != OP_NUM_REST_WHOLE || *prg++ != OP_NUM_APPEND_MODE)
+		return NULL;
+	if (z > G_MAXUINT8)
+		return NULL;
+
+	*zeros = z;
+	return prg;
+}
+
+/*
+ * Look for the handful of program shapes that cover the vast majority of
+ * formats in practice and record what is needed to render them without
+ * the interpreter.  Anything unusual -- literals, fills, locales, '?'
+ * digits, engineering notation, ... -- is left alone.
+ */
+static void
+go_format_detect_fast_path (GOFormat *fmt)
+{
+	const guchar *prg = fmt->u.number.program;
+	int scale = 0, decimals, zeros, exp_zeros = 0, i;
+	gboolean thousands = FALSE, point = FALSE, exp_sign = FALSE;
+	gboolean percent = FALSE, E = FALSE;
+
+	fmt->u.number.fast_path = GO_FMT_FAST_NONE;
+
+	if (fmt->u.number.is_general) {
+		if (prg[0] == OP_DATE_ROUND && prg[1] == 0 && prg[2] == 0 &&
+		    prg[3] == OP_NUM_GENERAL_MARK &&
+		    prg[4] == OP_NUM_GENERAL_DO &&
+		    prg[5] == OP_END)
+			fmt->u.number.fast_path = GO_FMT_FAST_GENERAL;
+		return;
+	}
+
+	if (prg[0] == OP_NUM_SCALE) {
+		if (prg[1] != 2)
+			return;
+		scale = 2;
+		prg += 2;
+	}
+
+	switch (*prg) {
+	case OP_NUM_PRINTF_F:
+		decimals = prg[1];
+		prg += 2;
+		if (*prg == OP_NUM_ENABLE_THOUSANDS) {
+			thousands = TRUE;
+			prg++;
+		}
+		break;
+	case OP_NUM_PRINTF_E:
+		/* Only one whole digit, i.e., no engineering notation.  */
+		if (scale || prg[2] != 1)
+			return;
+		decimals = prg[1];
+		prg += 3;
+		E = TRUE;
+		break;
+	default:
+		return;
+	}
+
+	if (*prg++ != OP_NUM_SIGN)
+		return;
+#ifdef ALLOW_EE_MARKUP
+	if (E && *prg++ != OP_NUM_MARK_MANTISSA)
+		return;
+#endif
+	if (*prg++ != OP_NUM_MOVETO_ONES)
+		return;
+
+	/* "0%" -- the percent sign comes before the digits.  */
+	if (scale && prg[0] == OP_CHAR && prg[1] == '%') {
+		percent = TRUE;
+		prg += 2;
+	}
+
+	prg = go_format_detect_fast_whole (prg, &zeros);
+	if (!prg || (E && zeros != 1))
+		return;
+
+	if (*prg == OP_NUM_DECIMAL_POINT) {
+		if (prg[1] != OP_NUM_MOVETO_DECIMALS)
+			return;
+		prg += 2;
+		point = TRUE;
+		for (i = 0; i < decimals; i++) {
+			if (prg[0] != OP_NUM_DECIMAL_1 || prg[1] != '0')
+				return;
+			prg += 2;
+		}
+	} else if (decimals != 0)
+		return;
+
+	/* "0.00%" -- the percent sign comes after the decimals.  */
+	if (scale && !percent && prg[0] == OP_CHAR && prg[1] == '%') {
+		percent = TRUE;
+		prg += 2;
+	}
+	if (scale && !percent)
+		return;
+
+	if (E) {
+		if (prg[0] != OP_NUM_VAL_EXPONENT ||
+		    prg[1] != OP_CHAR || prg[2] != 'E' ||
+		    prg[3] != OP_NUM_PRINTF_F || prg[4] != 0 ||
+		    prg[5] != OP_NUM_SIGN ||
+		    prg[6] != OP_NUM_EXPONENT_SIGN ||
+		    prg[8] != OP_NUM_MOVETO_ONES ||
+		    prg[9] != OP_NUM_STORE_POS)
+			return;
+		exp_sign = (prg[7] != 0);
+		prg = go_format_detect_fast_whole (prg + 10, &exp_zeros);
+		if (!prg)
+			return;
+	}
+
+	if (*prg != OP_END)
+		return;
+
+	fmt->u.number.fast_path =
+		E ? GO_FMT_FAST_SCIENTIFIC : GO_FMT_FAST_FIXED;
+	fmt->u.number.fast_thousands = thousands;
+	fmt->u.number.fast_percent = percent;
+	fmt->u.number.fast_point = point;
+	fmt->u.number.fast_exp_sign = exp_sign;
+	fmt->u.number.fast_decimals = decimals;
+	fmt->u.number.fast_zeros = zeros;
+	fmt->u.number.fast_exp_zeros = exp_zeros;
+}
+
 static GOFormat *
 go_format_parse (const char *str)
 {
@@ -2485,6 +2680,8 @@ go_format_parse (const char *str)
 
 		condition->fmt = fmt;
 		fmt->format = g_strndup (str, tail - str);
+		if (fmt->typ == GO_FMT_NUMBER)
+			go_format_detect_fast_path (fmt);
 		fmt->has_fill = state.fill_char != 0;
 		fmt->color = state.color;
 		if (is_magic) fmt->magic = state.locale.locale;
@@ -2959,6 +3156,58 @@ go_format_desired_width (PangoLayout *layout, PangoAttrList *attrs, int digits)
 
 
 #ifdef DEFINE_COMMON
+static gboolean
+attrs_have_font (PangoAttrList *attrs)
+{
+	static const PangoAttrType font_attrs[] = {
+		PANGO_ATTR_FAMILY, PANGO_ATTR_STYLE, PANGO_ATTR_WEIGHT,
+		PANGO_ATTR_VARIANT, PANGO_ATTR_STRETCH, PANGO_ATTR_SIZE,
+		PANGO_ATTR_FONT_DESC, PANGO_ATTR_SHAPE, PANGO_ATTR_SCALE,
+		PANGO_ATTR_LETTER_SPACING, PANGO_ATTR_ABSOLUTE_SIZE
+	};
+	PangoAttrIterator *iter;
+	gboolean res = FALSE;
+
+	if (!attrs)
+		return FALSE;
+
+	iter = pango_attr_list_get_iterator (attrs);
+	do {
+		unsigned ui;
+		for (ui = 0; !res && ui < G_N_ELEMENTS (font_attrs); ui++)
+			res = pango_attr_iterator_get (iter, font_attrs[ui]) != NULL;
+	} while (!res && pango_attr_iterator_next (iter));
+	pango_attr_iterator_destroy (iter);
+
+	return res;
+}
+
+/*
+ * Sum of the advance widths of the characters in s[0..len) in the font of
+ * @layout, or -1 if a character is one we do not trust to measure on its
+ * own.
+ */
+static int
+measure_advances (const char *s, size_t len, PangoLayout *layout)
+{
+	GOFontAdvances *adv = _go_font_advances_for_layout (layout);
+	const char *end = s + len;
+	int w = 0;
+
+	for (; s < end; s = g_utf8_next_char (s)) {
+		gunichar uc = g_utf8_get_char (s);
+
+		if (uc < 0x80
+		    ? !g_ascii_isprint (uc)
+		    : (uc != UNICODE_MINUS &&
+		       g_unichar_type (uc) != G_UNICODE_SPACE_SEPARATOR))
+			return -1;
+		w += _go_font_advances_get (adv, uc);
+	}
+
+	return w;
+}
+
 static void
 blank_characters (GString *dst, PangoAttrList *attrs, int start, int length,
 		  PangoLayout *layout)
@@ -2969,16 +3218,25 @@ blank_characters (GString *dst, PangoAttrList *attrs, int start, int length,
 		PangoAttribute *attr;
 		PangoAttrList *new_attrs = pango_attr_list_new ();
 		PangoRectangle logical_rect = {0, 0, 0, 2 * PANGO_SCALE};
+		int width = attrs_have_font (attrs)
+			? -1
+			: measure_advances (dst->str + start, length, layout);
 
-		pango_layout_set_text (layout, dst->str, -1);
-		pango_layout_set_attributes (layout, attrs);
-		full_width = go_format_measure_pango (NULL, layout);
-		g_string_erase (dst, start, length);
-		go_pango_attr_list_erase (attrs, start, length);
-		pango_layout_set_text (layout, dst->str, -1);
-		pango_layout_set_attributes (layout, attrs);
-		short_width = go_format_measure_pango (NULL, layout);
-		logical_rect.width = full_width - short_width;
+		if (width >= 0) {
+			g_string_erase (dst, start, length);
+			go_pango_attr_list_erase (attrs, start, length);
+		} else {
+			pango_layout_set_text (layout, dst->str, -1);
+			pango_layout_set_attributes (layout, attrs);
+			full_width = go_format_measure_pango (NULL, layout);
+			g_string_erase (dst, start, length);
+			go_pango_attr_list_erase (attrs, start, length);
+			pango_layout_set_text (layout, dst->str, -1);
+			pango_layout_set_attributes (layout, attrs);
+			short_width = go_format_measure_pango (NULL, layout);
+			width = full_width - short_width;
+		}
+		logical_rect.width = width;
 		g_string_insert_c (dst, start, ' ');
 		attr = pango_attr_shape_new (&logical_rect, &logical_rect);
 		attr->start_index = 0;
@@ -3821,7 +4079,7 @@ SUFFIX(go_format_execute) (PangoLayout *layout, GString *dst,
 			if (numtxt)
 				g_string_free (numtxt, TRUE);
 			if (oldlocale) {
-				go_setlocale (LC_ALL, oldlocale);
+				_go_setlocale_temporarily (LC_ALL, oldlocale);
 				g_free (oldlocale);
 			}
 			return res;
@@ -3889,11 +4147,11 @@ SUFFIX(go_format_execute) (PangoLayout *layout, GString *dst,
 			prg += strlen (lang) + 1;
 
 			if (oldlocale == NULL)
-				oldlocale = g_strdup (go_setlocale (LC_ALL, NULL));
+				oldlocale = g_strdup (setlocale (LC_ALL, NULL));
 			/* Setting LC_TIME should be enough, but glib gets
 			   confused over character sets.  */
-			go_setlocale (LC_TIME, lang);
-			go_setlocale (LC_CTYPE, lang);
+			_go_setlocale_temporarily (LC_TIME, lang);
+			_go_setlocale_temporarily (LC_CTYPE, lang);
 			break;
 		}
 
@@ -4750,6 +5008,124 @@ SUFFIX(go_format_execute) (PangoLayout *layout, GString *dst,
 	}
 }
 
+/*
+ * Render @val for a format recognized by go_format_detect_fast_path.  The
+ * result must be exactly what go_format_execute produces for the format's
+ * program.  We print the number into @dst, append the formatted result
+ * after it, and then drop the raw text.
+ */
+static GOFormatNumberError
+SUFFIX(go_format_execute_fast) (PangoLayout *layout, GString *dst,
+				const GOFormatMeasure measure,
+				const GOFontMetrics *metrics,
+				GOFormat const *fmt,
+				int col_width,
+				DOUBLE val,
+				gboolean unicode_minus)
+{
+	const GString *decimal = go_locale_get_decimal ();
+	const GString *comma = go_locale_get_thousand ();
+	int decimals = fmt->u.number.fast_decimals;
+	int zeros = fmt->u.number.fast_zeros;
+	gboolean thousands = fmt->u.number.fast_thousands;
+	gboolean E = (fmt->u.number.fast_path == GO_FMT_FAST_SCIENTIFIC);
+	int exponent = 0;
+	gsize raw_len, ws, we, fs, fe, i;
+	const char *dot;
+	gboolean neg;
+	int k, nwhole;
+
+	if (fmt->u.number.fast_path == GO_FMT_FAST_GENERAL) {
+		SUFFIX(go_render_general)
+			(layout, dst, measure, metrics,
+			 val, col_width, unicode_minus, 0, 0);
+		goto done;
+	}
+
+	if (E) {
+		const char *epos;
+
+		go_dtoa (dst, "=^.*" FORMAT_E, decimals, val);
+		epos = strchr (dst->str, 'E');
+		if (epos) {
+			exponent = atoi (epos + 1);
+			fe = epos - dst->str;
+		} else
+			fe = dst->len;
+	} else {
+		if (fmt->u.number.fast_percent)
+			val *= SUFFIX(go_pow10) (2);
+		go_dtoa (dst, "=^.*" FORMAT_f, decimals, val);
+		fe = dst->len;
+	}
+	raw_len = dst->len;
+
+	neg = (dst->str[0] == '-');
+	ws = neg ? 1 : 0;
+	dot = strstr (dst->str, decimal->str);
+	if (dot && (gsize)(dot - dst->str) > fe)
+		dot = NULL;
+	we = dot ? (gsize)(dot - dst->str) : fe;
+	fs = dot ? we + decimal->len : fe;
+
+	if (!E && neg && we == ws + 1 && dst->str[ws] == '0') {
+		/* "-0.00" is shown as "0.00".  */
+		for (i = fs; i < fe && dst->str[i] == '0'; i++)
+			;
+		if (i == fe)
+			neg = FALSE;
+	}
+
+	/* Ignore the zero in "0.xxx" */
+	if (dot && we == ws + 1 && dst->str[ws] == '0')
+		we = ws;
+
+	if (neg) {
+		if (unicode_minus)
+			g_string_append_len (dst, UTF8_MINUS, 3);
+		else
+			g_string_append_c (dst, '-');
+	}
+
+	nwhole = we - ws;
+	for (k = MAX (nwhole, zeros); k >= 1; k--) {
+		g_string_append_c (dst, k <= nwhole ? dst->str[we - k] : '0');
+		if (thousands && k > 3 && k % 3 == 1)
+			go_string_append_gstring (dst, comma);
+	}
+
+	if (fmt->u.number.fast_point) {
+		go_string_append_gstring (dst, decimal);
+		for (i = 0; i < (gsize)decimals; i++)
+			g_string_append_c (dst,
+					   fs + i < fe ? dst->str[fs + i] : '0');
+	}
+
+	if (fmt->u.number.fast_percent)
+		g_string_append_c (dst, '%');
+
+	if (E) {
+		g_string_append_c (dst, 'E');
+		if (exponent < 0) {
+			if (unicode_minus)
+				g_string_append_len (dst, UTF8_MINUS, 3);
+			else
+				g_string_append_c (dst, '-');
+		} else if (fmt->u.number.fast_exp_sign)
+			g_string_append_c (dst, '+');
+		g_string_append_printf (dst, "%0*d",
+					(int)fmt->u.number.fast_exp_zeros,
+					ABS (exponent));
+	}
+
+	g_string_erase (dst, 0, raw_len);
+
+ done:
+	if (layout)
+		pango_layout_set_text (layout, dst->str, -1);
+	return GO_FORMAT_NUMBER_OK;
+}
+
 /*********************************************************************/
 
 #ifdef DEFINE_COMMON
@@ -4789,6 +5165,35 @@ go_format_measure_pango (G_GNUC_UNUSED const GString *str,
 }
 #endif
 
+#ifdef DEFINE_COMMON
+/**
+ * go_format_measure_advances:
+ * @str: string to measure
+ * @layout: PangoLayout to measure
+ *
+ * Measures @str by adding up the advance widths of its characters in the
+ * font of @layout.  This avoids shaping and is much faster than
+ * go_format_measure_pango, but ignores kerning.  Strings with characters
+ * other than ASCII, the Unicode minus and spaces, and layouts with
+ * attributes that change the font are handed to go_format_measure_pango.
+ *
+ * Returns: the width of @str in Pango units.
+ */
+int
+go_format_measure_advances (const GString *str, PangoLayout *layout)
+{
+	int w;
+
+	if (!layout)
+		return go_format_measure_strlen (str, layout);
+
+	w = attrs_have_font (pango_layout_get_attributes (layout))
+		? -1
+		: measure_advances (str->str, str->len, layout);
+	return w < 0 ? go_format_measure_pango (str, layout) : w;
+}
+#endif
+
 #ifdef DEFINE_COMMON
 /**
  * go_format_measure_strlen:
@@ -5175,39 +5580,299 @@ SUFFIX(go_render_general) (PangoLayout *layout, GString *str,
 	return;
 }
 
-#define FREE_NEW_STR do { if (new_str) (void)g_string_free (new_str, TRUE); } while (0)
+#ifdef DEFINE_COMMON
+/*
+ * A small per-format cache of rendered values.  Only plain, numeric
+ * renderings without a layout are cached.  Everything that can affect the
+ * result apart from the format itself is part of the key.
+ *
+ * The cache is set associative: a key hashes to a set of
+ * RENDER_CACHE_WAYS entries and only that set is searched, replacing the
+ * least recently used entry on a miss.  Each cache has its own lock, so
+ * threads rendering different formats do not contend.  The global
+ * read-write lock is only taken for writing when the size changes; that
+ * frees all caches.
+ */
+typedef struct {
+	guint64 bits;
+	int col_width;
+	gboolean unicode_minus;
+	GOFormatMeasure measure;
+	const GOFontMetrics *metrics;
+	GODateConventions const *date_conv;
+	guint locale_serial;
+} GOFormatRenderKey;
+
+typedef struct {
+	GOFormatRenderKey key;
+	guint64 last_use;
+	GOColor color;
+	GOFormatNumberError err;
+	char *str;		/* NULL for unused entries */
+	gsize len;
+} GOFormatRenderEntry;
+
+#define RENDER_CACHE_WAYS 4
+
+struct _GOFormatRenderCache {
+	GMutex lock;
+	GOFormat *fmt;
+	guint set_mask;
+	guint64 clock;
+	gsize hits, misses;
+	GOFormatRenderEntry *entries;
+};
+
+static int render_cache_size = 0;
+static GRWLock render_cache_rwlock;
+/* Protects the list of caches, the render_cache members, and the totals */
+G_LOCK_DEFINE_STATIC (render_cache_list);
+static GSList *render_caches;
+static gsize render_cache_hits, render_cache_misses;
+
+static GOFormatRenderCache *
+go_format_render_cache_new (GOFormat *fmt, int size)
+{
+	GOFormatRenderCache *cache = g_new0 (GOFormatRenderCache, 1);
+	guint n_sets = 1;
+
+	while (n_sets * RENDER_CACHE_WAYS < (guint)size)
+		n_sets *= 2;
+
+	g_mutex_init (&cache->lock);
+	cache->fmt = fmt;
+	cache->set_mask = n_sets - 1;
+	cache->entries = g_new0 (GOFormatRenderEntry,
+				 n_sets * RENDER_CACHE_WAYS);
+	return cache;
+}
+
+/* Call with the list lock held.  */
+static void
+go_format_render_cache_free (GOFormatRenderCache *cache)
+{
+	guint i;
+
+	if (!cache)
+		return;
+
+	render_caches = g_slist_remove (render_caches, cache);
+	cache->fmt->render_cache = NULL;
+	render_cache_hits += cache->hits;
+	render_cache_misses += cache->misses;
+
+	for (i = 0; i < (cache->set_mask + 1) * RENDER_CACHE_WAYS; i++)
+		g_free (cache->entries[i].str);
+	g_free (cache->entries);
+	g_mutex_clear (&cache->lock);
+	g_free (cache);
+}
+
+static gboolean
+go_format_render_key_equal (GOFormatRenderKey const *a,
+			    GOFormatRenderKey const *b)
+{
+	return (a->bits == b->bits &&
+		a->col_width == b->col_width &&
+		a->unicode_minus == b->unicode_minus &&
+		a->measure == b->measure &&
+		a->metrics == b->metrics &&
+		a->date_conv == b->date_conv &&
+		a->locale_serial == b->locale_serial);
+}
+
+static GOFormatRenderEntry *
+go_format_render_cache_set (GOFormatRenderCache *cache,
+			    GOFormatRenderKey const *key)
+{
+	guint64 h = key->bits ^ ((guint64)key->col_width << 32) ^
+		key->locale_serial;
+	h *= G_GUINT64_CONSTANT (0x9e3779b97f4a7c15);
+	return cache->entries +
+		((guint)(h >> 40) & cache->set_mask) * RENDER_CACHE_WAYS;
+}
+
+/*
+ * Call with the read lock held.  Returns the cache of @fmt, creating it
+ * if caching is on.
+ */
+static GOFormatRenderCache *
+go_format_render_cache_get (GOFormat *fmt)
+{
+	GOFormatRenderCache *cache = g_atomic_pointer_get (&fmt->render_cache);
+	int size = g_atomic_int_get (&render_cache_size);
+
+	if (cache || size <= 0)
+		return cache;
+
+	G_LOCK (render_cache_list);
+	cache = fmt->render_cache;
+	if (!cache) {
+		cache = go_format_render_cache_new (fmt, size);
+		render_caches = g_slist_prepend (render_caches, cache);
+		g_atomic_pointer_set (&fmt->render_cache, cache);
+	}
+	G_UNLOCK (render_cache_list);
+
+	return cache;
+}
+
+static gboolean
+go_format_render_cache_lookup (GOFormat const *fmt_,
+			       GOFormatRenderKey const *key,
+			       GString *str, GOColor *color,
+			       GOFormatNumberError *err)
+{
+	GOFormatRenderCache *cache;
+	gboolean found = FALSE;
+	int i;
+
+	g_rw_lock_reader_lock (&render_cache_rwlock);
+	cache = go_format_render_cache_get ((GOFormat *)fmt_);
+	if (cache) {
+		GOFormatRenderEntry *set;
+
+		g_mutex_lock (&cache->lock);
+		set = go_format_render_cache_set (cache, key);
+		for (i = 0; i < RENDER_CACHE_WAYS; i++) {
+			GOFormatRenderEntry *e = set + i;
+			if (e->str && go_format_render_key_equal (&e->key, key)) {
+				e->last_use = ++cache->clock;
+				g_string_append_len (str, e->str, e->len);
+				*color = e->color;
+				*err = e->err;
+				found = TRUE;
+				break;
+			}
+		}
+		if (found)
+			cache->hits++;
+		else
+			cache->misses++;
+		g_mutex_unlock (&cache->lock);
+	}
+	g_rw_lock_reader_unlock (&render_cache_rwlock);
+
+	return found;
+}
+
+static void
+go_format_render_cache_store (GOFormat const *fmt_,
+			      GOFormatRenderKey const *key,
+			      GString const *str, GOColor color,
+			      GOFormatNumberError err)
+{
+	GOFormatRenderCache *cache;
+	int i;
+
+	g_rw_lock_reader_lock (&render_cache_rwlock);
+	cache = g_atomic_pointer_get (&((GOFormat *)fmt_)->render_cache);
+	if (cache) {
+		GOFormatRenderEntry *set, *victim = NULL;
+
+		g_mutex_lock (&cache->lock);
+		/* Use a free entry, or else the least recently used one.  */
+		set = go_format_render_cache_set (cache, key);
+		for (i = 0; i < RENDER_CACHE_WAYS; i++) {
+			GOFormatRenderEntry *e = set + i;
+			if (!e->str) {
+				victim = e;
+				break;
+			}
+			if (!victim || e->last_use < victim->last_use)
+				victim = e;
+		}
+		g_free (victim->str);
+		victim->key = *key;
+		victim->last_use = ++cache->clock;
+		victim->color = color;
+		victim->err = err;
+		victim->str = g_strndup (str->str, str->len);
+		victim->len = str->len;
+		g_mutex_unlock (&cache->lock);
+	}
+	g_rw_lock_reader_unlock (&render_cache_rwlock);
+}
 
 /**
- * go_format_value_gstring:
- * @layout: Optional PangoLayout, probably preseeded with font attribute.
- * @str: a GString to store (not append!) the resulting string in.
- * @measure: (scope call): Function to measure width of string/layout.
- * @metrics: Font metrics corresponding to @measure.
- * @fmt: #GOFormat
- * @val: floating-point value.  Must be finite.
- * @type: a format character
- * @sval: a string to append to @str after @val
- * @go_color: a color to render
- * @col_width: intended max width of layout in pango units.  -1 means
- *             no restriction.
- * @date_conv: #GODateConventions
- * @unicode_minus: Use unicode minuses, not hyphens.
+ * go_format_set_render_cache_size:
+ * @size: number of rendered values to remember per format.
  *
- * Render a floating-point value into @layout in such a way that the
- * layouting width does not needlessly exceed @col_width.  Optionally
- * use unicode minus instead of hyphen.
- * Returns: a #GOFormatNumberError
+ * Enables a cache of recently rendered values for each format.  This helps
+ * when the same values are rendered over and over, as is common for dates
+ * and round numbers in spreadsheet columns.  Only renderings without a
+ * layout are cached.  A @size of 0, the default, disables caching.
+ *
+ * Any change of size drops the existing caches and frees their memory.
  **/
-GOFormatNumberError
-SUFFIX(go_format_value_gstring) (PangoLayout *layout, GString *str,
-				 const GOFormatMeasure measure,
-				 const GOFontMetrics *metrics,
-				 GOFormat const *fmt,
-				 DOUBLE val, char type, const char *sval,
-				 GOColor *go_color,
-				 int col_width,
-				 GODateConventions const *date_conv,
-				 gboolean unicode_minus)
+void
+go_format_set_render_cache_size (int size)
+{
+	g_return_if_fail (size >= 0);
+
+	g_rw_lock_writer_lock (&render_cache_rwlock);
+	G_LOCK (render_cache_list);
+	while (render_caches)
+		go_format_render_cache_free (render_caches->data);
+	g_atomic_int_set (&render_cache_size, size);
+	G_UNLOCK (render_cache_list);
+	g_rw_lock_writer_unlock (&render_cache_rwlock);
+}
+
+/**
+ * go_format_get_render_cache_stats:
+ * @fmt: (nullable): a #GOFormat
+ * @hits: (out) (optional): number of lookups that were found in the cache
+ * @misses: (out) (optional): number of lookups that were not
+ *
+ * Reports how well the render cache, see go_format_set_render_cache_size,
+ * works for @fmt, or for all formats if @fmt is %NULL.  The numbers for
+ * a format start over when the cache size changes.
+ **/
+void
+go_format_get_render_cache_stats (GOFormat const *fmt,
+				  gsize *hits, gsize *misses)
+{
+	gsize h = 0, m = 0;
+	GSList *l;
+
+	G_LOCK (render_cache_list);
+	if (fmt == NULL) {
+		h = render_cache_hits;
+		m = render_cache_misses;
+	}
+	for (l = render_caches; l; l = l->next) {
+		GOFormatRenderCache *cache = l->data;
+		if (fmt && cache->fmt != fmt)
+			continue;
+		g_mutex_lock (&cache->lock);
+		h += cache->hits;
+		m += cache->misses;
+		g_mutex_unlock (&cache->lock);
+	}
+	G_UNLOCK (render_cache_list);
+
+	if (hits)
+		*hits = h;
+	if (misses)
+		*misses = m;
+}
+
+#undef RENDER_CACHE_WAYS
+#endif
+
+#define FREE_NEW_STR do { if (new_str) (void)g_string_free (new_str, TRUE); } while (0)
+
+static GOFormatNumberError
+SUFFIX(go_format_value_gstring_1) (PangoLayout *layout, GString *str,
+				   const GOFormatMeasure measure,
+				   const GOFontMetrics *metrics,
+				   GOFormat const *fmt,
+				   DOUBLE val, char type, const char *sval,
+				   GOColor *go_color,
+				   int col_width,
+				   GODateConventions const *date_conv,
+				   gboolean unicode_minus)
 {
 	gboolean inhibit = FALSE;
 	GString *new_str =  NULL;
@@ -5268,6 +5933,18 @@ SUFFIX(go_format_value_gstring) (PangoLayout *layout, GString *str,
 				if (inhibit)
 					val = SUFFIX(fabs)(val);
 			}
+			if (fmt->u.number.fast_path != GO_FMT_FAST_NONE) {
+				err = SUFFIX(go_format_execute_fast)
+					(layout, str,
+					 measure, metrics,
+					 fmt,
+					 col_width,
+					 val,
+					 unicode_minus);
+				FREE_NEW_STR;
+				return err;
+			}
+
 #ifdef DEBUG_PROGRAMS
 			g_printerr ("Executing %s\n", fmt->format);
 			go_format_dump_program (fmt->u.number.program);
@@ -5332,6 +6009,84 @@ SUFFIX(go_format_value_gstring) (PangoLayout *layout, GString *str,
 
 #undef FREE_NEW_STR
 
+/**
+ * go_format_value_gstring:
+ * @layout: Optional PangoLayout, probably preseeded with font attribute.
+ * @str: a GString to store (not append!) the resulting string in.
+ * @measure: (scope call): Function to measure width of string/layout.
+ * @metrics: Font metrics corresponding to @measure.
+ * @fmt: #GOFormat
+ * @val: floating-point value.  Must be finite.
+ * @type: a format character
+ * @sval: a string to append to @str after @val
+ * @go_color: a color to render
+ * @col_width: intended max width of layout in pango units.  -1 means
+ *             no restriction.
+ * @date_conv: #GODateConventions
+ * @unicode_minus: Use unicode minuses, not hyphens.
+ *
+ * Render a floating-point value into @layout in such a way that the
+ * layouting width does not needlessly exceed @col_width.  Optionally
+ * use unicode minus instead of hyphen.
+ * Returns: a #GOFormatNumberError
+ **/
+GOFormatNumberError
+SUFFIX(go_format_value_gstring) (PangoLayout *layout, GString *str,
+				 const GOFormatMeasure measure,
+				 const GOFontMetrics *metrics,
+				 GOFormat const *fmt,
+				 DOUBLE val, char type, const char *sval,
+				 GOColor *go_color,
+				 int col_width,
+				 GODateConventions const *date_conv,
+				 gboolean unicode_minus)
+{
+#ifdef DEFINE_COMMON
+	if (layout == NULL && str != NULL && fmt != NULL && type == 'F' &&
+	    g_atomic_int_get (&render_cache_size) > 0) {
+		GOFormatRenderKey key;
+		GOFormatNumberError err;
+		GOColor color = 0;
+		guint switches = _go_locale_get_foreign_switches ();
+
+		memset (&key, 0, sizeof (key));
+		memcpy (&key.bits, &val, sizeof (val));
+		key.col_width = col_width;
+		key.unicode_minus = unicode_minus;
+		key.measure = measure;
+		key.metrics = metrics;
+		key.date_conv = date_conv;
+		key.locale_serial = _go_locale_get_serial ();
+
+		g_string_truncate (str, 0);
+		if (!go_format_render_cache_lookup (fmt, &key, str,
+						    &color, &err)) {
+			err = SUFFIX(go_format_value_gstring_1)
+				(layout, str, measure, metrics, fmt,
+				 val, type, sval, &color,
+				 col_width, date_conv, unicode_minus);
+			/*
+			 * Another thread rendering a format with a locale
+			 * tag may have switched the locale under us.
+			 */
+			if (key.locale_serial == _go_locale_get_serial () &&
+			    switches == _go_locale_get_foreign_switches ())
+				go_format_render_cache_store
+					(fmt, &key, str, color, err);
+		}
+
+		if (go_color)
+			*go_color = color;
+		return err;
+	}
+#endif
+
+	return SUFFIX(go_format_value_gstring_1)
+		(layout, str, measure, metrics, fmt,
+		 val, type, sval, go_color,
+		 col_width, date_conv, unicode_minus);
+}
+
 /**
  * go_format_value:
  * @fmt: a #GOFormat
@@ -5359,6 +6114,127 @@ SUFFIX(go_format_value) (GOFormat const *fmt, DOUBLE val)
 	return g_string_free (res, FALSE);
 }
 
+/**
+ * go_format_values_gstring:
+ * @dst: a GString to store (not append!) the resulting strings in.
+ * @offsets: (array length=n) (out caller-allocates): offsets into @dst
+ *           of the rendered values.
+ * @fmt: (nullable): #GOFormat
+ * @vals: (array length=n): floating-point values.  Must be finite.
+ * @n: number of values.
+ * @col_width: intended max width in characters.  -1 means no restriction.
+ * @date_conv: #GODateConventions
+ * @unicode_minus: Use unicode minuses, not hyphens.
+ *
+ * Render @n values with @fmt into a single string pool.  Each rendered
+ * value is terminated by a NUL character and the text for @vals[i] starts
+ * at @dst->str + @offsets[i].  Values that cannot be rendered with @fmt
+ * come out as "#####", like go_format_value() does.
+ *
+ * The result is the same as calling go_format_value_gstring() without a
+ * layout for each value, but unconditional formats are specialized only
+ * once and one scratch buffer is shared by all values.
+ *
+ * Returns: %GO_FORMAT_NUMBER_OK, or the error for the first value that
+ * could not be rendered.
+ **/
+GOFormatNumberError
+SUFFIX(go_format_values_gstring) (GString *dst, gsize *offsets,
+				  GOFormat const *fmt,
+				  DOUBLE const *vals, gsize n,
+				  int col_width,
+				  GODateConventions const *date_conv,
+				  gboolean unicode_minus)
+{
+	GOFormatNumberError res = GO_FORMAT_NUMBER_OK;
+	GOFormat const *fixed = NULL;
+	GString *tmp;
+	gsize i;
+
+	g_return_val_if_fail (dst != NULL, (GOFormatNumberError)-1);
+	g_return_val_if_fail (offsets != NULL || n == 0,
+			      (GOFormatNumberError)-1);
+	g_return_val_if_fail (vals != NULL || n == 0,
+			      (GOFormatNumberError)-1);
+
+	g_string_truncate (dst, 0);
+
+	if (!fmt)
+		fmt = go_format_general ();
+	/* Only conditional formats depend on the value.  */
+	if (fmt->typ != GO_FMT_COND)
+		fixed = fmt;
+
+	tmp = g_string_sized_new (20);
+	for (i = 0; i < n; i++) {
+		DOUBLE val = vals[i];
+		gboolean inhibit = FALSE;
+		GOFormat const *sfmt = fixed
+			? fixed
+			: SUFFIX(go_format_specialize) (fmt, val, 'F', &inhibit);
+		GOFormatNumberError err;
+
+		if (inhibit)
+			val = SUFFIX(fabs)(val);
+
+		g_string_truncate (tmp, 0);
+		switch (sfmt->typ) {
+		case GO_FMT_TEXT:
+			SUFFIX(go_render_general)
+				(NULL, tmp,
+				 go_format_measure_strlen,
+				 go_font_metrics_unit,
+				 val,
+				 col_width, unicode_minus, 0, 0);
+			err = GO_FORMAT_NUMBER_OK;
+			break;
+
+		case GO_FMT_NUMBER:
+			if (sfmt->u.number.fast_path != GO_FMT_FAST_NONE) {
+				err = SUFFIX(go_format_execute_fast)
+					(NULL, tmp,
+					 go_format_measure_strlen,
+					 go_font_metrics_unit,
+					 sfmt,
+					 col_width,
+					 val,
+					 unicode_minus);
+				break;
+			}
+			err = SUFFIX(go_format_execute)
+				(NULL, tmp,
+				 go_format_measure_strlen,
+				 go_font_metrics_unit,
+				 sfmt->u.number.program,
+				 col_width,
+				 val, NULL, date_conv,
+				 unicode_minus);
+			break;
+
+		case GO_FMT_EMPTY:
+			err = GO_FORMAT_NUMBER_OK;
+			break;
+
+		default:
+			err = GO_FORMAT_NUMBER_INVALID_FORMAT;
+			break;
+		}
+
+		if (err) {
+			if (res == GO_FORMAT_NUMBER_OK)
+				res = err;
+			g_string_assign (tmp, "#####");
+		}
+
+		offsets[i] = dst->len;
+		/* Include the terminating NUL.  */
+		g_string_append_len (dst, tmp->str, tmp->len + 1);
+	}
+	g_string_free (tmp, TRUE);
+
+	return res;
+}
+
 
 
 #ifdef DEFINE_COMMON
@@ -5424,8 +6300,10 @@ _go_number_format_shutdown (void)
 	go_format_unref (default_empty_fmt);
 	default_empty_fmt = NULL;
 
+	G_LOCK (style_format_hash);
 	tmp = style_format_hash;
 	style_format_hash = NULL;
+	G_UNLOCK (style_format_hash);
 	g_hash_table_foreach (tmp, cb_format_leak, NULL);
 	g_hash_table_destroy (tmp);
 }
@@ -6191,13 +7069,21 @@ go_format_parse_markup (char *str)
 GOFormat *
 go_format_new_from_XL (char const *str)
 {
-	GOFormat *format;
+	GOFormat *format, *other;
 
 	g_return_val_if_fail (str != NULL, go_format_general ());
 
+	G_LOCK (style_format_hash);
 	format = g_hash_table_lookup (style_format_hash, str);
+	if (format)
+		go_format_ref (format);
+	G_UNLOCK (style_format_hash);
 
 	if (format == NULL) {
+		/*
+		 * Parse without holding the lock.  Another thread may beat
+		 * us to it, in which case we use its format instead.
+		 */
 		if (str[0] == '@' && str[1] == '[') {
 			PangoAttrList *attrs;
 			char *desc_copy = g_strdup (str);
@@ -6212,9 +7098,22 @@ go_format_new_from_XL (char const *str)
 		} else
 			format = go_format_parse (str);
 
-		g_hash_table_insert (style_format_hash,
-				     format->format,
-				     format);
+		G_LOCK (style_format_hash);
+		other = g_hash_table_lookup (style_format_hash, str);
+		if (other)
+			go_format_ref (other);
+		else {
+			g_hash_table_insert (style_format_hash,
+					     format->format,
+					     format);
+			go_format_ref (format);
+		}
+		G_UNLOCK (style_format_hash);
+
+		if (other) {
+			go_format_unref (format);
+			format = other;
+		}
 	}
 
 #ifdef DEBUG_REF_COUNT
@@ -6223,7 +7122,7 @@ go_format_new_from_XL (char const *str)
 		   format, format->format, format->ref_count);
 #endif
 
-	return go_format_ref (format);
+	return format;
 }
 #endif
 
@@ -6308,7 +7207,7 @@ go_format_ref (GOFormat const *gf_)
 
 	g_return_val_if_fail (gf != NULL, NULL);
 
-	gf->ref_count++;
+	g_atomic_int_inc (&gf->ref_count);
 #ifdef DEBUG_REF_COUNT
 	g_message ("%s: format=%p '%s' ref_count=%d",
 		   G_GNUC_FUNCTION,
@@ -6331,27 +7230,43 @@ void
 go_format_unref (GOFormat const *gf_)
 {
 	GOFormat *gf = (GOFormat *)gf_;
+	int refs;
 
 	if (gf == NULL)
 		return;
 
-	g_return_if_fail (gf->ref_count > 0);
+	g_return_if_fail (g_atomic_int_get (&gf->ref_count) > 0);
+
+	/*
+	 * As long as we stay above 1 there is nothing to do but count.
+	 * Below that we have to synchronize with go_format_new_from_XL
+	 * which might be resurrecting the format from the hash.
+	 */
+	while ((refs = g_atomic_int_get (&gf->ref_count)) > 2) {
+		if (g_atomic_int_compare_and_exchange (&gf->ref_count,
+						       refs, refs - 1))
+			return;
+	}
 
-	gf->ref_count--;
+	G_LOCK (style_format_hash);
+	refs = g_atomic_int_add (&gf->ref_count, -1) - 1;
 #ifdef DEBUG_REF_COUNT
 	g_message ("%s: format=%p '%s' ref_count=%d",
 		   G_GNUC_FUNCTION,
-		   gf, gf->format, gf->ref_count);
+		   gf, gf->format, refs);
 #endif
-	if (gf->ref_count > 1)
-		return;
+	if (refs == 1 &&
+	    NULL != style_format_hash &&
+	    gf_ == g_hash_table_lookup (style_format_hash, gf_->format)) {
+		/* Only the hash is left.  Drop its reference too.  */
+		g_hash_table_steal (style_format_hash, gf_->format);
+		g_atomic_int_set (&gf->ref_count, 0);
+		refs = 0;
+	}
+	G_UNLOCK (style_format_hash);
 
-	if (gf->ref_count == 1) {
-		if (NULL != style_format_hash &&
-		    gf_ == g_hash_table_lookup (style_format_hash, gf_->format))
-			g_hash_table_remove (style_format_hash, gf_->format);
+	if (refs > 0)
 		return;
-	}
 
 	switch (gf->typ) {
 	case GO_FMT_COND: {
@@ -6376,6 +7291,11 @@ go_format_unref (GOFormat const *gf_)
 		break;
 	}
 
+	if (gf->render_cache) {
+		G_LOCK (render_cache_list);
+		go_format_render_cache_free (gf->render_cache);
+		G_UNLOCK (render_cache_list);
+	}
 	g_free (gf->format);
 	g_free (gf);
 }
@@ -6842,9 +7762,11 @@ SUFFIX(go_format_specialize) (GOFormat const *fmt, DOUBLE val, char type,
 GOFormat *
 go_format_general (void)
 {
-	if (!default_general_fmt)
-		default_general_fmt = go_format_new_from_XL (
-			_go_format_builtins (GO_FORMAT_GENERAL)[0]);
+	if (g_once_init_enter (&default_general_fmt))
+		g_once_init_leave
+			(&default_general_fmt,
+			 go_format_new_from_XL
+			 (_go_format_builtins (GO_FORMAT_GENERAL)[0]));
 	return default_general_fmt;
 }
 #endif
@@ -6858,8 +7780,10 @@ go_format_general (void)
 GOFormat *
 go_format_empty (void)
 {
-	if (!default_empty_fmt)
-		default_empty_fmt = go_format_new_from_XL ("");
+	if (g_once_init_enter (&default_empty_fmt))
+		g_once_init_leave
+			(&default_empty_fmt,
+			 go_format_new_from_XL (""));
 	return default_empty_fmt;
 }
 #endif
@@ -6873,9 +7797,10 @@ go_format_empty (void)
 GOFormat *
 go_format_default_date (void)
 {
-	if (!default_date_fmt)
-		default_date_fmt =
-			go_format_new_magic (GO_FORMAT_MAGIC_SHORT_DATE);
+	if (g_once_init_enter (&default_date_fmt))
+		g_once_init_leave
+			(&default_date_fmt,
+			 go_format_new_magic (GO_FORMAT_MAGIC_SHORT_DATE));
 	return default_date_fmt;
 }
 #endif
@@ -6889,9 +7814,10 @@ go_format_default_date (void)
 GOFormat *
 go_format_default_time (void)
 {
-	if (!default_time_fmt)
-		default_time_fmt =
-			go_format_new_magic (GO_FORMAT_MAGIC_SHORT_TIME);
+	if (g_once_init_enter (&default_time_fmt))
+		g_once_init_leave
+			(&default_time_fmt,
+			 go_format_new_magic (GO_FORMAT_MAGIC_SHORT_TIME));
 	return default_time_fmt;
 }
 #endif
@@ -6905,9 +7831,10 @@ go_format_default_time (void)
 GOFormat *
 go_format_default_date_time (void)
 {
-	if (!default_date_time_fmt)
-		default_date_time_fmt =
-			go_format_new_magic (GO_FORMAT_MAGIC_SHORT_DATETIME);
+	if (g_once_init_enter (&default_date_time_fmt))
+		g_once_init_leave
+			(&default_date_time_fmt,
+			 go_format_new_magic (GO_FORMAT_MAGIC_SHORT_DATETIME));
 	return default_date_time_fmt;
 }
 #endif
@@ -6921,9 +7848,11 @@ go_format_default_date_time (void)
 GOFormat *
 go_format_default_percentage (void)
 {
-	if (!default_percentage_fmt)
-		default_percentage_fmt = go_format_new_from_XL (
-			_go_format_builtins (GO_FORMAT_PERCENTAGE) [1]);
+	if (g_once_init_enter (&default_percentage_fmt))
+		g_once_init_leave
+			(&default_percentage_fmt,
+			 go_format_new_from_XL
+			 (_go_format_builtins (GO_FORMAT_PERCENTAGE)[1]));
 	return default_percentage_fmt;
 }
 #endif
@@ -6937,9 +7866,11 @@ go_format_default_percentage (void)
 GOFormat *
 go_format_default_money (void)
 {
-	if (!default_money_fmt)
-		default_money_fmt = go_format_new_from_XL (
-			_go_format_builtins (GO_FORMAT_CURRENCY)[2]);
+	if (g_once_init_enter (&default_money_fmt))
+		g_once_init_leave
+			(&default_money_fmt,
+			 go_format_new_from_XL
+			 (_go_format_builtins (GO_FORMAT_CURRENCY)[2]));
 	return default_money_fmt;
 }
 #endif
@@ -6953,9 +7884,11 @@ go_format_default_money (void)
 GOFormat *
 go_format_default_accounting (void)
 {
-	if (!default_accounting_fmt)
-		default_accounting_fmt = go_format_new_from_XL (
-			_go_format_builtins (GO_FORMAT_ACCOUNTING)[2]);
+	if (g_once_init_enter (&default_accounting_fmt))
+		g_once_init_leave
+			(&default_accounting_fmt,
+			 go_format_new_from_XL
+			 (_go_format_builtins (GO_FORMAT_ACCOUNTING)[2]));
 	return default_accounting_fmt;
 }
 #endif
@@ -134,6 +134,7 @@ gboolean go_format_allow_pi_slash (void);
 
 typedef int (*GOFormatMeasure) (const GString *str, PangoLayout *layout);
 int go_format_measure_zero (const GString *str, PangoLayout *layout);
+int go_format_measure_advances (const GString *str, PangoLayout *layout);
 int go_format_measure_pango (const GString *str, PangoLayout *layout);
 int go_format_measure_strlen (const GString *str, PangoLayout *layout);
 
@@ -259,6 +260,13 @@ go_format_value_gstring (PangoLayout *layout, GString *str,
 			 GODateConventions const *date_conv,
 			 gboolean unicode_minus);
 char	*go_format_value (GOFormat const *fmt, double val);
+GOFormatNumberError
+go_format_values_gstring (GString *dst, gsize *offsets,
+			  GOFormat const *fmt,
+			  double const *vals, gsize n,
+			  int col_width,
+			  GODateConventions const *date_conv,
+			  gboolean unicode_minus);
 #ifdef GOFFICE_WITH_LONG_DOUBLE
 GOFormatNumberError
 go_format_value_gstringl (PangoLayout *layout, GString *str,
@@ -271,6 +279,13 @@ go_format_value_gstringl (PangoLayout *layout, GString *str,
 			  GODateConventions const *date_conv,
 			  gboolean unicode_minus);
 char	*go_format_valuel (GOFormat const *fmt, long double val);
+GOFormatNumberError
+go_format_values_gstringl (GString *dst, gsize *offsets,
+			   GOFormat const *fmt,
+			   long double const *vals, gsize n,
+			   int col_width,
+			   GODateConventions const *date_conv,
+			   gboolean unicode_minus);
 #endif
 #ifdef GOFFICE_WITH_DECIMAL64
 GOFormatNumberError
@@ -284,8 +299,19 @@ go_format_value_gstringD (PangoLayout *layout, GString *str,
 			  GODateConventions const *date_conv,
 			  gboolean unicode_minus);
 char	*go_format_valueD (GOFormat const *fmt, _Decimal64 val);
+GOFormatNumberError
+go_format_values_gstringD (GString *dst, gsize *offsets,
+			   GOFormat const *fmt,
+			   _Decimal64 const *vals, gsize n,
+			   int col_width,
+			   GODateConventions const *date_conv,
+			   gboolean unicode_minus);
 #endif
 
+void go_format_set_render_cache_size (int size);
+void go_format_get_render_cache_stats (GOFormat const *fmt,
+				       gsize *hits, gsize *misses);
+
 gboolean go_format_eq			(GOFormat const *a, GOFormat const *b);
 GOFormat *go_format_inc_precision	(GOFormat const *fmt);
 GOFormat *go_format_dec_precision	(GOFormat const *fmt);
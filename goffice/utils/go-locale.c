@@ -56,6 +56,22 @@ static gboolean boolean_cached = FALSE;
 static char const *lc_TRUE = NULL;
 static char const *lc_FALSE = NULL;
 
+static gint locale_serial = 0;
+static gint locale_switches = 0;
+/* The number of locale_switches made by the current thread.  */
+static GPrivate own_locale_switches = G_PRIVATE_INIT (NULL);
+
+static void
+go_locale_invalidate (void)
+{
+	locale_info_cached = FALSE;
+	date_format_cached = FALSE;
+	time_format_cached = FALSE;
+	date_order_cached = FALSE;
+	locale_is_24h_cached = FALSE;
+	boolean_cached = FALSE;
+}
+
 /**
  * go_setlocale:
  * @category: locale category (like LC_ALL)
@@ -70,15 +86,63 @@ static char const *lc_FALSE = NULL;
 char const *
 go_setlocale (int category, char const *val)
 {
-	locale_info_cached = FALSE;
-	date_format_cached = FALSE;
-	time_format_cached = FALSE;
-	date_order_cached = FALSE;
-	locale_is_24h_cached = FALSE;
-	boolean_cached = FALSE;
+	go_locale_invalidate ();
+	if (val != NULL)
+		g_atomic_int_inc (&locale_serial);
+	return setlocale (category, val);
+}
+
+/**
+ * _go_setlocale_temporarily: (skip)
+ * @category: locale category (like LC_ALL)
+ * @val: (nullable): locale name
+ *
+ * Like go_setlocale, but for a switch that the caller undoes when done,
+ * such as while rendering a format with a locale tag.  This does not
+ * change the serial returned by _go_locale_get_serial.
+ *
+ * Returns: (transfer none) (nullable): a string representation of the
+ * locale set.
+ */
+char const *
+_go_setlocale_temporarily (int category, char const *val)
+{
+	go_locale_invalidate ();
+	if (val != NULL) {
+		g_atomic_int_inc (&locale_switches);
+		g_private_set (&own_locale_switches,
+			       GUINT_TO_POINTER (GPOINTER_TO_UINT (g_private_get (&own_locale_switches)) + 1));
+	}
 	return setlocale (category, val);
 }
 
+/**
+ * _go_locale_get_serial: (skip)
+ *
+ * Returns: a number that changes whenever go_setlocale changes the
+ * locale.  This can be used to invalidate caches of locale dependent
+ * data.
+ */
+guint
+_go_locale_get_serial (void)
+{
+	return (guint)g_atomic_int_get (&locale_serial);
+}
+
+/**
+ * _go_locale_get_foreign_switches: (skip)
+ *
+ * Returns: a number that changes whenever another thread switches the
+ * locale with _go_setlocale_temporarily.  Locale dependent data computed
+ * while it changed may have used the wrong locale.
+ */
+guint
+_go_locale_get_foreign_switches (void)
+{
+	return (guint)g_atomic_int_get (&locale_switches) -
+		GPOINTER_TO_UINT (g_private_get (&own_locale_switches));
+}
+
 /**
  * _go_locale_shutdown: (skip)
  *
@@ -44,6 +44,9 @@ gboolean       go_locale_24h              (void);
 GString const *go_locale_get_date_format  (void);
 GString const *go_locale_get_time_format  (void);
 
+char const *   _go_setlocale_temporarily  (int category, char const *val);
+guint          _go_locale_get_serial      (void);
+guint          _go_locale_get_foreign_switches (void);
 void           _go_locale_shutdown        (void);
 
 G_END_DECLS
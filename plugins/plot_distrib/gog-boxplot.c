@@ -188,7 +188,7 @@ typedef struct {
 	GogSeries base;
 	int	 gap_percentage;
 	double vals[5];
-	double *svals; /* sorted data */
+	double *svals; /* valid data, partitioned at the quartiles */
 	int nb_valid;
 } GogBoxPlotSeries;
 typedef GogSeriesClass GogBoxPlotSeriesClass;
@@ -510,47 +510,36 @@ gog_box_plot_view_render (GogView *view, GogViewAllocation const *bbox)
 		gog_renderer_push_style (view->renderer, style);
 		if (model->outliers) {
 			double l1, l2, m1, m2, d, r = 2. * hrect * model->radius_ratio;
-			int i = 0;
+			int i;
 			d = series->vals[3] - series->vals[1];
 			l1 = series->vals[1] - d * 1.5;
 			l2 = series->vals[1] - d * 3.;
 			m1 = series->vals[3] + d * 1.5;
 			m2 = series->vals[3] + d * 3.;
-			while (i < series->nb_valid && series->svals[i] < l1) {
-				/* display the outlier as a mark */
-				d = gog_axis_map_to_view (map, series->svals[i]);
-				if (model->vertical) {
-					if (series->svals[i] < l2)
-						gog_renderer_stroke_circle (view->renderer, y, d, r);
-					else
-						gog_renderer_draw_circle (view->renderer, y, d, r);
-				} else {
-					if (series->svals[i] < l2)
-						gog_renderer_stroke_circle (view->renderer, d, y, r);
-					else
-						gog_renderer_draw_circle (view->renderer, d, y, r);
-				}
-				i++;
-			}
-			min = series->svals[i];
-			i = series->nb_valid - 1;
-			while (series->svals[i] > m1) {
+			min = go_pinf;
+			max = go_ninf;
+			for (i = 0; i < series->nb_valid; i++) {
+				double v = series->svals[i];
+				if (v >= l1 && v < min)
+					min = v;
+				if (v <= m1 && v > max)
+					max = v;
+				if (v >= l1 && v <= m1)
+					continue;
 				/* display the outlier as a mark */
-				d = gog_axis_map_to_view (map, series->svals[i]);
+				d = gog_axis_map_to_view (map, v);
 				if (model->vertical) {
-					if (series->svals[i] > m2)
+					if (v < l2 || v > m2)
 						gog_renderer_stroke_circle (view->renderer, y, d, r);
 					else
 						gog_renderer_draw_circle (view->renderer, y, d, r);
 				} else {
-					if (series->svals[i] > m2)
+					if (v < l2 || v > m2)
 						gog_renderer_stroke_circle (view->renderer, d, y, r);
 					else
 						gog_renderer_draw_circle (view->renderer, d, y, r);
 				}
-				i--;
 			}
-			max = series->svals[i];
 		} else {
 			min = series->vals[0];
 			max = series->vals[4];
@@ -653,15 +642,14 @@ gog_box_plot_series_update (GogObject *obj)
 	}
 	series->base.num_elements = len;
 	if (len > 0) {
-		double x;
+		static const double quartiles[5] = { 0, 0.25, 0.5, 0.75, 1 };
 		int n, max = 0;
 		series->svals = g_new (double, len);
 		for (n = 0; n < len; n++)
 			if (go_finite (vals[n]))
 				series->svals[max++] = vals[n];
-		go_range_fractile_inter_nonconst (series->svals, max, &series->vals[0], 0);
-		for (x = 0.25,n = 1; n < 5; n++, x+= 0.25)
-			go_range_fractile_inter_sorted (series->svals, max, &series->vals[n], x);
+		go_range_fractiles_nonconst (series->svals, max, series->vals,
+					     quartiles, 5);
 		series->nb_valid = max;
 	}
 	/* queue plot for redraw */
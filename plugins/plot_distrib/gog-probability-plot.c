@@ -586,12 +586,14 @@ gog_probability_plot_series_update (GogObject *obj)
 	g_free (series->y);
 	if (series->base.num_elements > 0) {
 		series->y = g_new0 (double, series->base.num_elements);
-		series->y[0] = go_distribution_get_ppf (dist, 1. - mn);
+		series->y[0] = 1. - mn;
 		if (series->base.num_elements > 1) {
 			for (i = 1; i < series->base.num_elements - 1; i++)
-				series->y[i] = go_distribution_get_ppf (dist, (i + .6825) / d);
-			series->y[i] = go_distribution_get_ppf (dist, mn);
+				series->y[i] = (i + .6825) / d;
+			series->y[i] = mn;
 		}
+		go_distribution_get_ppf_v (dist, series->y, series->y,
+					   series->base.num_elements);
 
 	} else
 		series->y = NULL;
@@ -33,6 +33,24 @@ gog_exp_reg_curve_get_value_at (GogRegCurve *curve, double x)
 	return exp (curve->a[0] + curve->a[1] * x);
 }
 
+static void
+gog_exp_reg_curve_get_values_at (GogRegCurve *curve, double const *x, double *y, int n)
+{
+	GogRegCurveClass *klass = (GogRegCurveClass *) G_OBJECT_GET_CLASS (curve);
+	double a0 = curve->a[0], a1 = curve->a[1];
+	int i;
+
+	/* See gog_lin_reg_curve_get_values_at.  */
+	if (klass->get_value_at != gog_exp_reg_curve_get_value_at) {
+		for (i = 0; i < n; i++)
+			y[i] = klass->get_value_at (curve, x[i]);
+		return;
+	}
+
+	for (i = 0; i < n; i++)
+		y[i] = exp (a0 + a1 * x[i]);
+}
+
 static gchar const*
 gog_exp_reg_curve_get_equation (GogRegCurve *curve)
 {
@@ -72,6 +90,7 @@ gog_exp_reg_curve_class_init (GogRegCurveClass *reg_curve_klass)
 	lin_reg_klass->lin_reg_func = go_exponential_regression_as_log;
 
 	reg_curve_klass->get_value_at = gog_exp_reg_curve_get_value_at;
+	reg_curve_klass->get_values_at = gog_exp_reg_curve_get_values_at;
 	reg_curve_klass->get_equation = gog_exp_reg_curve_get_equation;
 
 	gog_object_klass->type_name	= gog_exp_reg_curve_type_name;
@@ -35,6 +35,7 @@
 #include <glib/gi18n-lib.h>
 
 #include <gsf/gsf-impl-utils.h>
+#include <string.h>
 
 GOFFICE_PLUGIN_MODULE_HEADER;
 
@@ -48,13 +49,115 @@ enum {
 	REG_LIN_REG_CURVE_PROP_DIMS,
 };
 
+static void
+gog_lin_reg_curve_clear_state (GogLinRegCurve *rc)
+{
+	go_regression_state_free (rc->state);
+	rc->state = NULL;
+}
+
+static void
+gog_lin_reg_curve_free_values (double **x_vals, double *y_vals, int dims)
+{
+	int i;
+
+	if (x_vals) {
+		for (i = 0; i < dims; i++)
+			g_free (x_vals[i]);
+	}
+	g_free (x_vals);
+	g_free (y_vals);
+}
+
+static void
+gog_lin_reg_curve_clear_values (GogLinRegCurve *rc)
+{
+	gog_lin_reg_curve_free_values (rc->x_vals, rc->y_vals, rc->dims);
+	gog_lin_reg_curve_free_values (rc->prev_x_vals, rc->prev_y_vals, rc->dims);
+	rc->x_vals = rc->prev_x_vals = NULL;
+	rc->y_vals = rc->prev_y_vals = NULL;
+	rc->n_alloc = rc->prev_n_alloc = 0;
+}
+
+/*
+ * Makes room for n points in x_vals and y_vals for the build_values
+ * methods.  The arrays are kept between updates and only reallocated
+ * when they grow; their contents are not preserved.
+ */
+void
+gog_lin_reg_curve_reserve_values (GogLinRegCurve *rc, int n)
+{
+	int i;
+
+	if (rc->x_vals == NULL) {
+		rc->x_vals = g_new0 (double *, rc->dims);
+		rc->n_alloc = 0;
+	}
+	if (n <= rc->n_alloc && rc->y_vals != NULL)
+		return;
+	for (i = 0; i < rc->dims; i++) {
+		g_free (rc->x_vals[i]);
+		rc->x_vals[i] = g_new (double, n);
+	}
+	g_free (rc->y_vals);
+	rc->y_vals = g_new (double, n);
+	rc->n_alloc = n;
+}
+
+/*
+ * Plain linear regressions keep their QR state between updates.  When
+ * the old points are all still there, in the same order, which is what
+ * happens when points are appended to a series, only the new points
+ * need to be fed in.
+ */
+static GORegressionResult
+gog_lin_reg_curve_stream (GogLinRegCurve *rc, double **prev_x,
+			  double const *prev_y, int used,
+			  go_regression_stat_t *stats)
+{
+	int i, j, start;
+	double *xs;
+	GORegressionResult res;
+
+	start = rc->state ? go_regression_state_get_n (rc->state) : 0;
+	if (start > used || (start > 0 && (prev_x == NULL || prev_y == NULL)))
+		start = -1;
+	if (start > 0 && memcmp (prev_y, rc->y_vals, start * sizeof (double)))
+		start = -1;
+	for (j = 0; start > 0 && j < rc->dims; j++)
+		if (memcmp (prev_x[j], rc->x_vals[j], start * sizeof (double)))
+			start = -1;
+
+	if (start < 0) {
+		gog_lin_reg_curve_clear_state (rc);
+		start = 0;
+	}
+	if (rc->state == NULL)
+		rc->state = go_regression_state_new (rc->dims, rc->affine);
+
+	xs = g_new (double, rc->dims);
+	for (i = start; i < used; i++) {
+		for (j = 0; j < rc->dims; j++)
+			xs[j] = rc->x_vals[j][i];
+		go_regression_state_append (rc->state, xs, rc->y_vals[i]);
+	}
+	g_free (xs);
+
+	res = go_regression_state_get_result (rc->state, rc->base.a, stats);
+	if (res != GO_REG_ok)
+		gog_lin_reg_curve_clear_state (rc);
+	return res;
+}
+
 static void
 gog_lin_reg_curve_update (GogObject *obj)
 {
 	GogLinRegCurve *rc = GOG_LIN_REG_CURVE (obj);
+	GogLinRegCurveClass *klass = GOG_LIN_REG_CURVE_GET_CLASS (rc);
 	GogSeries *series = GOG_SERIES (obj->parent);
 	double const *y_vals, *x_vals = NULL;
-	int used, nb;
+	double **prev_x, *prev_y;
+	int used, nb, prev_n_alloc;
 
 	if (!gog_series_is_valid (series))
 		return;
@@ -71,19 +174,35 @@ gog_lin_reg_curve_update (GogObject *obj)
 	} else
 		rc->use_days_var = FALSE;
 
+	/*
+	 * Hang on to the previous values to see what changed, and build
+	 * the new ones in the buffers from the update before that.
+	 */
+	prev_x = rc->x_vals;
+	prev_y = rc->y_vals;
+	prev_n_alloc = rc->n_alloc;
+	rc->x_vals = rc->prev_x_vals;
+	rc->y_vals = rc->prev_y_vals;
+	rc->n_alloc = rc->prev_n_alloc;
+	rc->prev_x_vals = prev_x;
+	rc->prev_y_vals = prev_y;
+	rc->prev_n_alloc = prev_n_alloc;
+
 	nb = gog_series_get_xy_data (series, &x_vals, &y_vals);
-	used = (y_vals)? (GOG_LIN_REG_CURVE_GET_CLASS(rc))->build_values (rc, x_vals, y_vals, nb): 0;
+	used = (y_vals)? klass->build_values (rc, x_vals, y_vals, nb): 0;
 	if (used > 1) {
 		go_regression_stat_t *stats = go_regression_stat_new ();
-		GORegressionResult res =
-			(GOG_LIN_REG_CURVE_GET_CLASS(rc))->lin_reg_func (rc->x_vals, rc->dims,
-						rc->y_vals, used, rc->affine, rc->base.a, stats);
+		GORegressionResult res = (klass->lin_reg_func == go_linear_regression)
+			? gog_lin_reg_curve_stream (rc, prev_x, prev_y, used, stats)
+			: klass->lin_reg_func (rc->x_vals, rc->dims,
+					       rc->y_vals, used, rc->affine, rc->base.a, stats);
 		if (res == GO_REG_ok) {
 			rc->base.R2 = stats->sqr_r;
 		} else for (nb = 0; nb <= rc->dims; nb++)
 			rc->base.a[nb] = go_nan;
 		go_regression_stat_destroy (stats);
 	} else {
+		gog_lin_reg_curve_clear_state (rc);
 		rc->base.R2 = go_nan;
 		for (nb = 0; nb <= rc->dims; nb++)
 			rc->base.a[nb] = go_nan;
@@ -99,6 +218,27 @@ gog_lin_reg_curve_get_value_at (GogRegCurve *curve, double x)
 	return curve->a[0] + curve->a[1] * x;
 }
 
+static void
+gog_lin_reg_curve_get_values_at (GogRegCurve *curve, double const *x, double *y, int n)
+{
+	GogRegCurveClass *klass = (GogRegCurveClass *) G_OBJECT_GET_CLASS (curve);
+	double a0 = curve->a[0], a1 = curve->a[1];
+	int i;
+
+	/*
+	 * A derived class that overrides get_value_at, but not this,
+	 * inherits this method.  Don't give it our formula.
+	 */
+	if (klass->get_value_at != gog_lin_reg_curve_get_value_at) {
+		for (i = 0; i < n; i++)
+			y[i] = klass->get_value_at (curve, x[i]);
+		return;
+	}
+
+	for (i = 0; i < n; i++)
+		y[i] = a0 + a1 * x[i];
+}
+
 static gchar const*
 gog_lin_reg_curve_get_equation (GogRegCurve *curve)
 {
@@ -142,12 +282,7 @@ gog_lin_reg_curve_build_values (GogLinRegCurve *rc, double const *x_vals, double
 	double x, y;
 	double xmin, xmax;
 	gog_reg_curve_get_bounds (&rc->base, &xmin, &xmax);
-	if (rc->x_vals == NULL)
-		rc->x_vals = g_new0 (double*, 1);
-	g_free (*rc->x_vals);
-	*rc->x_vals = g_new (double, n);
-	g_free (rc->y_vals);
-	rc->y_vals = g_new (double, n);
+	gog_lin_reg_curve_reserve_values (rc, n);
 	for (i = 0, used = 0; i < n; i++) {
 		x = (x_vals)? x_vals[i]: i + 1;
 		y = y_vals[i];
@@ -226,17 +361,12 @@ gog_lin_reg_curve_set_property (GObject *obj, guint param_id,
 	switch (param_id) {
 	case REG_LIN_REG_CURVE_PROP_AFFINE:
 		rc->affine = g_value_get_boolean (value);
+		gog_lin_reg_curve_clear_state (rc);
 		break;
 	case REG_LIN_REG_CURVE_PROP_DIMS: {
 		int max_dims = ((GogLinRegCurveClass *) G_OBJECT_GET_CLASS (rc))->max_dims;
-		if (rc->x_vals) {
-			int i;
-			for (i = 0; i < rc->dims; i++){
-				g_free (rc->x_vals[i]);
-			}
-		}
-		g_free (rc->x_vals);
-		rc->x_vals = NULL;
+		gog_lin_reg_curve_clear_values (rc);
+		gog_lin_reg_curve_clear_state (rc);
 		rc->dims = g_value_get_uint (value);
 		if (rc->dims > max_dims) {
 			g_warning ("Invalid value %u for the \"dims\" property\n", rc->dims);
@@ -257,13 +387,8 @@ static void
 gog_lin_reg_curve_finalize (GObject *obj)
 {
 	GogLinRegCurve *rc = GOG_LIN_REG_CURVE (obj);
-	int i;
-	if (rc->x_vals) {
-		for (i = 0; i < rc->dims; i++)
-			g_free (rc->x_vals[i]);
-	}
-	g_free (rc->x_vals);
-	g_free (rc->y_vals);
+	gog_lin_reg_curve_clear_values (rc);
+	gog_lin_reg_curve_clear_state (rc);
 	(G_OBJECT_CLASS (gog_lin_reg_curve_parent_klass))->finalize (obj);
 }
 
@@ -284,6 +409,7 @@ gog_lin_reg_curve_class_init (GogRegCurveClass *reg_curve_klass)
 	gog_object_klass->type_name	= gog_lin_reg_curve_type_name;
 
 	reg_curve_klass->get_value_at = gog_lin_reg_curve_get_value_at;
+	reg_curve_klass->get_values_at = gog_lin_reg_curve_get_values_at;
 	reg_curve_klass->get_equation = gog_lin_reg_curve_get_equation;
 #ifdef GOFFICE_WITH_GTK
 	reg_curve_klass->populate_editor = gog_lin_reg_curve_populate_editor;
@@ -315,7 +441,12 @@ gog_lin_reg_curve_init (GogLinRegCurve *model)
 	model->affine = TRUE;
 	model->x_vals = NULL;
 	model->y_vals = NULL;
+	model->n_alloc = 0;
+	model->prev_x_vals = NULL;
+	model->prev_y_vals = NULL;
+	model->prev_n_alloc = 0;
 	model->dims = 1;
+	model->state = NULL;
 	model->use_days_var = FALSE;
 	model->xbasis = 0;
 }
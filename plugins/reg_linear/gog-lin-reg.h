@@ -34,6 +34,10 @@ typedef  struct {
 	int dims;
 	gboolean use_days_var;
 	double xbasis;
+	GORegressionState *state; /* holds the first prev_x_vals/prev_y_vals */
+	int n_alloc;		/* room in x_vals and y_vals */
+	double **prev_x_vals, *prev_y_vals; /* from the previous update */
+	int prev_n_alloc;
 } GogLinRegCurve;
 
 typedef struct {
@@ -55,6 +59,7 @@ typedef struct {
 
 GType gog_lin_reg_curve_get_type (void);
 void  gog_lin_reg_curve_register_type (GTypeModule *module);
+void  gog_lin_reg_curve_reserve_values (GogLinRegCurve *rc, int n);
 
 G_END_DECLS
 
@@ -34,12 +34,7 @@ gog_log_reg_curve_build_values (GogLinRegCurve *rc, double const *x_vals, double
 	double x, y;
 	double xmin, xmax;
 	gog_reg_curve_get_bounds (&rc->base, &xmin, &xmax);
-	if (rc->x_vals == NULL)
-		rc->x_vals = g_new0 (double*, 1);
-	g_free (*rc->x_vals);
-	*rc->x_vals = g_new (double, n);
-	g_free (rc->y_vals);
-	rc->y_vals = g_new (double, n);
+	gog_lin_reg_curve_reserve_values (rc, n);
 	for (i = 0, used = 0; i < n; i++) {
 		x = (x_vals)? x_vals[i]: i + 1;
 		y = y_vals[i];
@@ -64,6 +59,24 @@ gog_log_reg_curve_get_value_at (GogRegCurve *curve, double x)
 	return curve->a[0] + curve->a[1] * log (x);
 }
 
+static void
+gog_log_reg_curve_get_values_at (GogRegCurve *curve, double const *x, double *y, int n)
+{
+	GogRegCurveClass *klass = (GogRegCurveClass *) G_OBJECT_GET_CLASS (curve);
+	double a0 = curve->a[0], a1 = curve->a[1];
+	int i;
+
+	/* See gog_lin_reg_curve_get_values_at.  */
+	if (klass->get_value_at != gog_log_reg_curve_get_value_at) {
+		for (i = 0; i < n; i++)
+			y[i] = klass->get_value_at (curve, x[i]);
+		return;
+	}
+
+	for (i = 0; i < n; i++)
+		y[i] = a0 + a1 * log (x[i]);
+}
+
 static gchar const*
 gog_log_reg_curve_get_equation (GogRegCurve *curve)
 {
@@ -104,6 +117,7 @@ gog_log_reg_curve_class_init (GogRegCurveClass *reg_curve_klass)
 	lin_reg_klass->build_values = gog_log_reg_curve_build_values;
 
 	reg_curve_klass->get_value_at = gog_log_reg_curve_get_value_at;
+	reg_curve_klass->get_values_at = gog_log_reg_curve_get_values_at;
 	reg_curve_klass->get_equation = gog_log_reg_curve_get_equation;
 
 	gog_object_klass->type_name	= gog_log_reg_curve_type_name;
@@ -45,14 +45,7 @@ gog_polynom_reg_curve_build_values (GogLinRegCurve *rc, double const *x_vals,
 	int i, j, used;
 
 	gog_reg_curve_get_bounds (&rc->base, &xmin, &xmax);
-	if (rc->x_vals == NULL)
-		rc->x_vals = g_new0 (double*, rc->dims);
-	for (i = 0; i < rc->dims; i++) {
-		g_free (rc->x_vals[i]);
-		rc->x_vals[i] = g_new (double, n);
-	}
-	g_free (rc->y_vals);
-	rc->y_vals = g_new (double, n);
+	gog_lin_reg_curve_reserve_values (rc, n);
 	for (i = 0, used = 0; i < n; i++) {
 		x = (x_vals)? x_vals[i]: i + 1;
 		y = y_vals[i];
@@ -79,14 +72,27 @@ static double
 gog_polynom_reg_curve_get_value_at (GogRegCurve *curve, double x)
 {
 	GogLinRegCurve *lin = GOG_LIN_REG_CURVE (curve);
-	double result = curve->a[0] + curve->a[1] * x, xx = x;
+	double result;
+
+	go_polynomial_eval_v (curve->a, lin->dims, &x, &result, 1);
+	return result;
+}
+
+static void
+gog_polynom_reg_curve_get_values_at (GogRegCurve *curve, double const *x, double *y, int n)
+{
+	GogRegCurveClass *klass = (GogRegCurveClass *) G_OBJECT_GET_CLASS (curve);
+	GogLinRegCurve *lin = GOG_LIN_REG_CURVE (curve);
 	int i;
-	for (i = 1; i < lin->dims;) {
-		xx *= x;
-		i++;
-		result += xx * curve->a[i];
+
+	/* See gog_lin_reg_curve_get_values_at.  */
+	if (klass->get_value_at != gog_polynom_reg_curve_get_value_at) {
+		for (i = 0; i < n; i++)
+			y[i] = klass->get_value_at (curve, x[i]);
+		return;
 	}
-	return result;
+
+	go_polynomial_eval_v (curve->a, lin->dims, x, y, n);
 }
 
 static const char *const exponent[10] = {
@@ -234,6 +240,7 @@ gog_polynom_reg_curve_class_init (GogRegCurveClass *reg_curve_klass)
 	lin_reg_klass->max_dims = 10;
 
 	reg_curve_klass->get_value_at = gog_polynom_reg_curve_get_value_at;
+	reg_curve_klass->get_values_at = gog_polynom_reg_curve_get_values_at;
 	reg_curve_klass->get_equation = gog_polynom_reg_curve_get_equation;
 #ifdef GOFFICE_WITH_GTK
 	reg_curve_klass->populate_editor = gog_polynom_reg_curve_populate_editor;
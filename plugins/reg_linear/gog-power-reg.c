@@ -33,6 +33,24 @@ gog_power_reg_curve_get_value_at (GogRegCurve *curve, double x)
 	return exp (curve->a[0]) * pow (x, curve->a[1]);
 }
 
+static void
+gog_power_reg_curve_get_values_at (GogRegCurve *curve, double const *x, double *y, int n)
+{
+	GogRegCurveClass *klass = (GogRegCurveClass *) G_OBJECT_GET_CLASS (curve);
+	double f = exp (curve->a[0]), a1 = curve->a[1];
+	int i;
+
+	/* See gog_lin_reg_curve_get_values_at.  */
+	if (klass->get_value_at != gog_power_reg_curve_get_value_at) {
+		for (i = 0; i < n; i++)
+			y[i] = klass->get_value_at (curve, x[i]);
+		return;
+	}
+
+	for (i = 0; i < n; i++)
+		y[i] = f * pow (x[i], a1);
+}
+
 static gchar const*
 gog_power_reg_curve_get_equation (GogRegCurve *curve)
 {
@@ -72,6 +90,7 @@ gog_power_reg_curve_class_init (GogRegCurveClass *reg_curve_klass)
 	lin_reg_klass->lin_reg_func = go_power_regression;
 
 	reg_curve_klass->get_value_at = gog_power_reg_curve_get_value_at;
+	reg_curve_klass->get_values_at = gog_power_reg_curve_get_values_at;
 	reg_curve_klass->get_equation = gog_power_reg_curve_get_equation;
 
 	gog_object_klass->type_name	= gog_power_reg_curve_type_name;
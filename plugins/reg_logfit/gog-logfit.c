@@ -98,6 +98,28 @@ gog_log_fit_curve_get_value_at (GogRegCurve *curve, double x)
 		curve->a[1] + curve->a[2] * log (curve->a[3] - x);
 }
 
+static void
+gog_log_fit_curve_get_values_at (GogRegCurve *curve, double const *x, double *y, int n)
+{
+	GogRegCurveClass *klass = (GogRegCurveClass *) G_OBJECT_GET_CLASS (curve);
+	double a1 = curve->a[1], a2 = curve->a[2], a3 = curve->a[3];
+	int i;
+
+	/* See gog_lin_reg_curve_get_values_at.  */
+	if (klass->get_value_at != gog_log_fit_curve_get_value_at) {
+		for (i = 0; i < n; i++)
+			y[i] = klass->get_value_at (curve, x[i]);
+		return;
+	}
+
+	if (curve->a[0] > 0.)
+		for (i = 0; i < n; i++)
+			y[i] = a1 + a2 * log (x[i] - a3);
+	else
+		for (i = 0; i < n; i++)
+			y[i] = a1 + a2 * log (a3 - x[i]);
+}
+
 static gchar const*
 gog_log_fit_curve_get_equation (GogRegCurve *curve)
 {
@@ -157,6 +179,7 @@ gog_log_fit_curve_class_init (GogRegCurveClass *reg_curve_klass)
 	gog_object_klass->type_name	= gog_log_fit_curve_type_name;
 
 	reg_curve_klass->get_value_at = gog_log_fit_curve_get_value_at;
+	reg_curve_klass->get_values_at = gog_log_fit_curve_get_values_at;
 	reg_curve_klass->get_equation = gog_log_fit_curve_get_equation;
 }
 
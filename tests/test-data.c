@@ -0,0 +1,579 @@
+#include <goffice/goffice.h>
+#include <glib/gstdio.h>
+#include <string.h>
+#include <float.h>
+#include <math.h>
+
+/* ------------------------------------------------------------------------- */
+
+/*
+ * Write n doubles as a mapped data file, with a header for rows x columns
+ * if rows > 0.  extra bytes of junk are appended.
+ */
+static void
+write_mapped (const char *filename, const double *xs, int n,
+	      int rows, int columns, int extra)
+{
+	GString *s = g_string_new (NULL);
+	GError *err = NULL;
+	int i;
+
+	if (rows > 0) {
+		guint32 r = GUINT32_TO_LE (rows), c = GUINT32_TO_LE (columns);
+		g_string_append_len (s, GO_DATA_MAPPED_MAGIC, 8);
+		g_string_append_len (s, (char *)&r, 4);
+		g_string_append_len (s, (char *)&c, 4);
+	}
+	for (i = 0; i < n; i++) {
+		guint64 u;
+		memcpy (&u, xs + i, sizeof (u));
+		u = GUINT64_TO_LE (u);
+		g_string_append_len (s, (char *)&u, sizeof (u));
+	}
+	for (i = 0; i < extra; i++)
+		g_string_append_c (s, 'x');
+
+	if (!g_file_set_contents (filename, s->str, s->len, &err))
+		g_error ("%s", err->message);
+	g_string_free (s, TRUE);
+}
+
+static void
+expect_mapping_error (GOData *dat, GError *err, const char *what)
+{
+	g_printerr ("mapped %s: %s\n", what, err ? err->message : "(none)");
+	g_assert (dat == NULL);
+	g_assert (err != NULL);
+	g_error_free (err);
+}
+
+static void
+test_mapped (void)
+{
+	static const double xs[7] = { 1, -2.5, 3, 1e300, -0.0, 7, 8 };
+	char *filename;
+	GError *err = NULL;
+	GOData *dat, *dat2;
+	GODataVector *vec;
+	GODataMatrix *mat;
+	double minimum, maximum;
+	char *str;
+	int fd, i;
+
+	fd = g_file_open_tmp ("go-mapped-XXXXXX", &filename, &err);
+	g_assert (fd >= 0);
+	g_close (fd, NULL);
+
+	/* Headerless vector.  */
+	write_mapped (filename, xs, 6, 0, 0, 0);
+	dat = go_data_vector_mapped_new (filename, &err);
+	g_assert (dat != NULL && err == NULL);
+	vec = GO_DATA_VECTOR (dat);
+	g_assert (go_data_vector_get_len (vec) == 6);
+	for (i = 0; i < 6; i++)
+		g_assert (go_data_vector_get_value (vec, i) == xs[i]);
+	go_data_vector_get_minmax (vec, &minimum, &maximum);
+	g_assert (minimum == -2.5 && maximum == 1e300);
+
+	/* Rewriting the file is noticed by refresh, and only once.  */
+	write_mapped (filename, xs, 7, 0, 0, 0);
+	g_assert (go_data_mapped_refresh (dat, NULL));
+	g_assert (!go_data_mapped_refresh (dat, NULL));
+	g_assert (go_data_vector_get_len (vec) == 7);
+	go_data_vector_get_minmax (vec, &minimum, &maximum);
+	g_assert (minimum == -2.5 && maximum == 1e300);
+	g_assert (go_data_vector_get_value (vec, 6) == 8);
+
+	/* Values may be written to, without touching the file or a copy.  */
+	dat2 = go_data_dup (dat);
+	go_data_vector_get_values (vec)[0] = 42;
+	g_assert (go_data_vector_get_value (vec, 0) == 42);
+	g_assert (go_data_vector_get_value (GO_DATA_VECTOR (dat2), 0) == xs[0]);
+	g_object_unref (dat2);
+	dat2 = go_data_vector_mapped_new (filename, &err);
+	g_assert (dat2 != NULL && err == NULL);
+	g_assert (go_data_vector_get_value (GO_DATA_VECTOR (dat2), 0) == xs[0]);
+	g_object_unref (dat2);
+	g_object_unref (dat);
+
+	/* Headerless matrix with "RxC:" in the serialized form.  */
+	write_mapped (filename, xs, 6, 0, 0, 0);
+	dat = go_data_matrix_mapped_new (filename, 2, 3, &err);
+	g_assert (dat != NULL && err == NULL);
+	mat = GO_DATA_MATRIX (dat);
+	g_assert (go_data_matrix_get_rows (mat) == 2);
+	g_assert (go_data_matrix_get_columns (mat) == 3);
+	g_assert (go_data_matrix_get_value (mat, 1, 2) == xs[5]);
+	str = go_data_serialize (dat, NULL);
+	g_printerr ("mapped matrix: %s\n", str);
+	g_assert (g_str_has_prefix (str, "2x3:"));
+	dat2 = g_object_new (GO_TYPE_DATA_MATRIX_MAPPED, NULL);
+	g_assert (go_data_unserialize (dat2, str, NULL));
+	g_assert (go_data_eq (dat, dat2));
+	g_assert (go_data_matrix_get_value (GO_DATA_MATRIX (dat2), 1, 0) == xs[3]);
+	g_free (str);
+	g_object_unref (dat2);
+	g_object_unref (dat);
+
+	/* Header.  */
+	write_mapped (filename, xs, 6, 3, 2, 0);
+	dat = go_data_matrix_mapped_new (filename, 0, 0, &err);
+	g_assert (dat != NULL && err == NULL);
+	mat = GO_DATA_MATRIX (dat);
+	g_assert (go_data_matrix_get_rows (mat) == 3);
+	g_assert (go_data_matrix_get_columns (mat) == 2);
+	g_assert (go_data_matrix_get_value (mat, 2, 1) == xs[5]);
+	str = go_data_serialize (dat, NULL);
+	g_assert (strcmp (str, filename) == 0);
+	dat2 = g_object_new (GO_TYPE_DATA_MATRIX_MAPPED, NULL);
+	g_assert (go_data_unserialize (dat2, str, NULL));
+	g_assert (go_data_eq (dat, dat2));
+	g_free (str);
+	g_object_unref (dat2);
+	g_object_unref (dat);
+
+	dat = go_data_vector_mapped_new (filename, &err);
+	g_assert (dat != NULL && err == NULL);
+	g_assert (go_data_vector_get_len (GO_DATA_VECTOR (dat)) == 6);
+	g_assert (go_data_vector_get_value (GO_DATA_VECTOR (dat), 0) == xs[0]);
+	g_object_unref (dat);
+
+	/* Dimensions that do not match the header.  */
+	dat = go_data_matrix_mapped_new (filename, 2, 3, &err);
+	expect_mapping_error (dat, err, "dimension mismatch");
+	err = NULL;
+
+	/* Short files.  */
+	write_mapped (filename, xs, 5, 3, 2, 0);
+	dat = go_data_matrix_mapped_new (filename, 0, 0, &err);
+	expect_mapping_error (dat, err, "short with header");
+	err = NULL;
+	dat = go_data_vector_mapped_new (filename, &err);
+	expect_mapping_error (dat, err, "short vector with header");
+	err = NULL;
+
+	write_mapped (filename, xs, 5, 0, 0, 0);
+	dat = go_data_matrix_mapped_new (filename, 2, 3, &err);
+	expect_mapping_error (dat, err, "short without header");
+	err = NULL;
+	dat = go_data_matrix_mapped_new (filename, 0, 0, &err);
+	expect_mapping_error (dat, err, "no dimensions");
+	err = NULL;
+
+	write_mapped (filename, xs, 5, 0, 0, 3);
+	dat = go_data_vector_mapped_new (filename, &err);
+	expect_mapping_error (dat, err, "partial double");
+	err = NULL;
+
+	/* Not a regular file.  */
+	dat = go_data_vector_mapped_new (g_get_tmp_dir (), &err);
+	expect_mapping_error (dat, err, "directory");
+	err = NULL;
+
+	g_unlink (filename);
+	dat = go_data_vector_mapped_new (filename, &err);
+	expect_mapping_error (dat, err, "missing");
+	err = NULL;
+
+	g_free (filename);
+}
+
+/* ------------------------------------------------------------------------- */
+
+/* Base64 of a matrix with the given dimensions and n doubles.  */
+static char *
+base64_of (int rows, int columns, const double *xs, int n)
+{
+	GString *s = g_string_new (NULL);
+	guint32 r = GUINT32_TO_LE (rows), c = GUINT32_TO_LE (columns);
+	char *res;
+	int i;
+
+	g_string_append_len (s, (char *)&r, 4);
+	g_string_append_len (s, (char *)&c, 4);
+	for (i = 0; i < n; i++) {
+		guint64 u;
+		memcpy (&u, xs + i, sizeof (u));
+		u = GUINT64_TO_LE (u);
+		g_string_append_len (s, (char *)&u, sizeof (u));
+	}
+	res = g_base64_encode ((guchar *)s->str, s->len);
+	g_string_free (s, TRUE);
+	return res;
+}
+
+static void
+test_base64 (void)
+{
+	/* Large enough that graphs save it as base64.  */
+	int rows = 70, columns = 60, n = rows * columns, i;
+	double *xs = g_new (double, n), *ys;
+	GOData *dat, *dat2;
+	char *str;
+
+	for (i = 0; i < n; i++)
+		xs[i] = (i - 100) / 7.0;
+	xs[1] = go_nan;
+	xs[2] = go_pinf;
+	xs[3] = go_ninf;
+	xs[4] = -0.0;
+	xs[5] = DBL_MIN / 4;
+	xs[6] = DBL_MAX;
+
+	/* Vector round trip, bit for bit.  */
+	dat = go_data_vector_val_new (xs, n, NULL);
+	str = go_data_serialize_base64 (dat);
+	g_assert (str != NULL);
+	dat2 = go_data_vector_val_new (NULL, 0, NULL);
+	g_assert (go_data_unserialize_base64 (dat2, str));
+	g_assert (go_data_vector_get_len (GO_DATA_VECTOR (dat2)) == n);
+	ys = go_data_vector_get_values (GO_DATA_VECTOR (dat2));
+	g_assert (memcmp (xs, ys, n * sizeof (double)) == 0);
+	g_free (str);
+
+	/* Malformed: not a whole number of doubles.  The old values stay.  */
+	str = g_base64_encode ((guchar *)"twelve bytes", 12);
+	g_assert (!go_data_unserialize_base64 (dat2, str));
+	g_assert (go_data_vector_get_len (GO_DATA_VECTOR (dat2)) == n);
+	g_free (str);
+	g_object_unref (dat2);
+	g_object_unref (dat);
+
+	/* Matrix round trip.  */
+	dat = go_data_matrix_val_new (xs, rows, columns, NULL);
+	str = go_data_serialize_base64 (dat);
+	g_assert (str != NULL);
+	dat2 = go_data_matrix_val_new (NULL, 0, 0, NULL);
+	g_assert (go_data_unserialize_base64 (dat2, str));
+	g_assert (go_data_matrix_get_rows (GO_DATA_MATRIX (dat2)) == rows);
+	g_assert (go_data_matrix_get_columns (GO_DATA_MATRIX (dat2)) == columns);
+	ys = go_data_matrix_get_values (GO_DATA_MATRIX (dat2));
+	g_assert (memcmp (xs, ys, n * sizeof (double)) == 0);
+	g_free (str);
+
+	/* Malformed matrices: rows*columns does not match the values.  */
+	str = base64_of (3, 3, xs, 8);
+	g_assert (!go_data_unserialize_base64 (dat2, str));
+	g_free (str);
+	str = base64_of (0x10000, 0x10000, xs, 0);
+	g_assert (!go_data_unserialize_base64 (dat2, str));
+	g_free (str);
+	str = base64_of (3, 3, xs, 9);
+	g_assert (go_data_unserialize_base64 (dat2, str));
+	g_assert (go_data_matrix_get_rows (GO_DATA_MATRIX (dat2)) == 3);
+	g_free (str);
+	/* Too short for the dimensions.  */
+	str = g_base64_encode ((guchar *)"abc", 3);
+	g_assert (!go_data_unserialize_base64 (dat2, str));
+	g_assert (go_data_matrix_get_columns (GO_DATA_MATRIX (dat2)) == 3);
+	g_free (str);
+	g_object_unref (dat2);
+	g_object_unref (dat);
+
+	/* Not simple data.  */
+	dat = go_data_scalar_val_new (1);
+	g_assert (go_data_serialize_base64 (dat) == NULL);
+	g_assert (!go_data_unserialize_base64 (dat, ""));
+	g_object_unref (dat);
+
+	g_free (xs);
+}
+
+/* ------------------------------------------------------------------------- */
+
+/*
+ * Check the statistics of vec against a plain computation on its n values
+ * xs.  The steps of xs must be exact.
+ */
+static void
+check_stats (GODataVector *vec, const double *xs, int n)
+{
+	GODataVectorStats const *st = go_data_vector_get_stats (vec);
+	int n_finite = 0, n_missing = 0, first_missing = -1, i;
+	gboolean inc = go_range_increasing (xs, n);
+	gboolean dec = go_range_decreasing (xs, n);
+	gboolean even = n > 1 && (inc || dec);
+	double minimum = DBL_MAX, maximum = -DBL_MAX, vmin, vmax;
+
+	for (i = 0; i < n; i++) {
+		if (go_finite (xs[i])) {
+			n_finite++;
+			minimum = MIN (minimum, xs[i]);
+			maximum = MAX (maximum, xs[i]);
+		} else {
+			even = FALSE;
+			if (isnan (xs[i])) {
+				n_missing++;
+				if (first_missing < 0)
+					first_missing = i;
+			}
+		}
+		if (i > 1 && xs[i] - xs[i - 1] != xs[1] - xs[0])
+			even = FALSE;
+	}
+
+	g_assert (st->n_finite == n_finite);
+	g_assert (st->n_missing == n_missing);
+	g_assert (st->first_missing == first_missing);
+	g_assert (st->increasing == inc);
+	g_assert (st->decreasing == dec);
+	g_assert (st->evenly_spaced == even);
+	g_assert (st->step == (even ? xs[1] - xs[0] : 0));
+	g_assert (go_data_vector_increasing (vec) == inc);
+	g_assert (go_data_vector_decreasing (vec) == dec);
+	g_assert (go_data_vector_vary_uniformly (vec) == (inc || dec));
+	g_assert (go_data_is_increasing (GO_DATA (vec)) == inc);
+	g_assert (go_data_is_decreasing (GO_DATA (vec)) == dec);
+
+	go_data_vector_get_minmax (vec, &vmin, &vmax);
+	g_assert (vmin == minimum && vmax == maximum);
+}
+
+static void
+check_stats_val (const double *xs, int n)
+{
+	GOData *dat = go_data_vector_val_new ((double *)xs, n, NULL);
+	check_stats (GO_DATA_VECTOR (dat), xs, n);
+	g_object_unref (dat);
+}
+
+static void
+test_stats (void)
+{
+	static const double vals[] = { 0, 1, 2, 3, -1 };
+	double xs[41], ys[3] = { 3, 3, 3 };
+	int n, i, p, v, code;
+	GOData *dat;
+	GODataVector *vec;
+	GODataVectorStats const *st;
+
+	/* All short vectors over a few values, NaN and infinities.  */
+	for (n = 0; n <= 5; n++) {
+		int count = 1;
+		for (i = 0; i < n; i++)
+			count *= 8;
+		for (code = 0; code < count; code++) {
+			int c = code;
+			for (i = 0; i < n; i++, c /= 8) {
+				switch (c % 8) {
+				case 5: xs[i] = go_nan; break;
+				case 6: xs[i] = go_pinf; break;
+				case 7: xs[i] = go_ninf; break;
+				default: xs[i] = vals[c % 8];
+				}
+			}
+			check_stats_val (xs, n);
+		}
+	}
+
+	/* Longer ramps, either way, with one value spoiled.  */
+	for (n = 1; n <= 40; n++) {
+		for (p = -1; p < n; p++) {
+			for (v = 0; v < 8; v++) {
+				for (i = 0; i < n; i++)
+					xs[i] = (v & 1) ? 7 - 2 * i : 2 * i - 7;
+				if (p >= 0) {
+					switch (v >> 1) {
+					case 0: xs[p] = go_nan; break;
+					case 1: xs[p] = go_pinf; break;
+					case 2: xs[p] = p > 0 ? xs[p - 1] : 0; break;
+					case 3: xs[p] += 1; break;
+					}
+				}
+				check_stats_val (xs, n);
+			}
+		}
+	}
+
+	/* Constant.  */
+	dat = go_data_vector_val_new (ys, 3, NULL);
+	vec = GO_DATA_VECTOR (dat);
+	st = go_data_vector_get_stats (vec);
+	g_assert (!st->increasing && !st->decreasing && !st->evenly_spaced);
+	g_assert (!go_data_vector_vary_uniformly (vec));
+
+	/* The statistics are kept until the values are said to change.  */
+	ys[0] = 1;
+	ys[2] = 5;
+	g_assert (!go_data_vector_increasing (vec));
+	go_data_emit_changed (dat);
+	st = go_data_vector_get_stats (vec);
+	g_assert (st->increasing && st->evenly_spaced && st->step == 2);
+	check_stats (vec, ys, 3);
+
+	ys[1] = go_nan;
+	go_data_emit_changed (dat);
+	g_assert (go_data_vector_get_stats (vec)->first_missing == 1);
+	check_stats (vec, ys, 3);
+	g_object_unref (dat);
+}
+
+/* ------------------------------------------------------------------------- */
+
+static void
+cb_changed_range (GODataVector *vec, int first, int last, GString *log)
+{
+	g_string_append_printf (log, "range %d %d;", first, last);
+}
+
+static void
+cb_changed (GOData *dat, GString *log)
+{
+	g_string_append (log, "changed;");
+}
+
+static int n_freed;
+
+static void
+count_free (gpointer p)
+{
+	n_freed++;
+	g_free (p);
+}
+
+/* Check the bounds of vec against a plain scan of its values.  */
+static void
+check_minmax (GODataVector *vec, double expected_min, double expected_max)
+{
+	int i, n = go_data_vector_get_len (vec);
+	double *xs = go_data_vector_get_values (vec);
+	double minimum, maximum;
+
+	go_data_vector_get_minmax (vec, &minimum, &maximum);
+	g_assert (minimum == expected_min && maximum == expected_max);
+	for (i = 0; i < n; i++)
+		g_assert (!go_finite (xs[i]) ||
+			  (minimum <= xs[i] && xs[i] <= maximum));
+}
+
+static void
+test_changed_range (void)
+{
+	double buf[4] = { 1, 5, -2, 3 };
+	double more[2] = { 7, -4 };
+	double *owned;
+	GString *log = g_string_new (NULL);
+	GOData *dat;
+	GODataVector *vec;
+	double *xs;
+	int i;
+
+	/* Appending to a buffer owned by the caller copies it.  */
+	dat = go_data_vector_val_new (buf, 4, NULL);
+	vec = GO_DATA_VECTOR (dat);
+	g_signal_connect (dat, "changed-range",
+			  G_CALLBACK (cb_changed_range), log);
+	g_signal_connect (dat, "changed", G_CALLBACK (cb_changed), log);
+	check_minmax (vec, -2, 5);
+
+	go_data_vector_val_append (GO_DATA_VECTOR_VAL (dat), more, 2);
+	g_assert (strcmp (log->str, "range 4 6;changed;") == 0);
+	g_assert (go_data_vector_get_len (vec) == 6);
+	xs = go_data_vector_get_values (vec);
+	g_assert (xs != buf);
+	g_assert (xs[0] == 1 && xs[3] == 3 && xs[4] == 7 && xs[5] == -4);
+	g_assert (buf[0] == 1 && buf[1] == 5 && buf[2] == -2 && buf[3] == 3);
+	check_minmax (vec, -4, 7);
+
+	/* Many appends, which grow the copy.  */
+	for (i = 0; i < 1000; i++) {
+		double x = (i % 7) * (i % 2 ? 1 : -1) * 0.25;
+		g_string_truncate (log, 0);
+		go_data_vector_val_append (GO_DATA_VECTOR_VAL (dat), &x, 1);
+		g_assert (go_data_vector_get_len (vec) == 7 + i);
+		g_assert (go_data_vector_get_value (vec, 6 + i) == x);
+		check_minmax (vec, -4, 7);
+	}
+	g_assert (strcmp (log->str, "range 1005 1006;changed;") == 0);
+	g_assert (go_data_vector_get_values (vec)[1] == 5);
+
+	/* Nothing appended, nothing said.  */
+	g_string_truncate (log, 0);
+	go_data_vector_val_append (GO_DATA_VECTOR_VAL (dat), more, 0);
+	g_assert (log->len == 0);
+	g_object_unref (dat);
+
+	/* A buffer owned through another destroy notify is handed over.  */
+	owned = g_new (double, 3);
+	owned[0] = 2; owned[1] = 4; owned[2] = 6;
+	dat = go_data_vector_val_new (owned, 3, count_free);
+	vec = GO_DATA_VECTOR (dat);
+	g_assert (go_data_vector_increasing (vec));
+	n_freed = 0;
+	go_data_vector_val_append (GO_DATA_VECTOR_VAL (dat), buf + 2, 0);
+	g_assert (n_freed == 0);
+	buf[0] = 8;
+	go_data_vector_val_append (GO_DATA_VECTOR_VAL (dat), buf, 1);
+	g_assert (n_freed == 1);
+	g_assert (go_data_vector_get_stats (vec)->evenly_spaced);
+	go_data_vector_val_append (GO_DATA_VECTOR_VAL (dat), more + 1, 1);
+	g_assert (!go_data_vector_increasing (vec));
+	check_minmax (vec, -4, 8);
+	g_object_unref (dat);
+	g_assert (n_freed == 1);
+
+	/* In-place changes, including of the old extremes.  */
+	buf[0] = 4; buf[1] = 9; buf[2] = 1; buf[3] = 6;
+	dat = go_data_vector_val_new (buf, 4, NULL);
+	vec = GO_DATA_VECTOR (dat);
+	g_signal_connect (dat, "changed-range",
+			  G_CALLBACK (cb_changed_range), log);
+	g_signal_connect (dat, "changed", G_CALLBACK (cb_changed), log);
+	check_minmax (vec, 1, 9);
+
+	buf[1] = 2;
+	g_string_truncate (log, 0);
+	go_data_vector_emit_changed_range (vec, 1, 2);
+	g_assert (strcmp (log->str, "range 1 2;changed;") == 0);
+	check_minmax (vec, 1, 6);
+
+	buf[2] = 8;
+	go_data_vector_emit_changed_range (vec, 2, 3);
+	check_minmax (vec, 2, 8);
+
+	buf[0] = go_nan;
+	go_data_vector_emit_changed_range (vec, 0, 1);
+	check_minmax (vec, 2, 8);
+	g_assert (go_data_vector_get_stats (vec)->first_missing == 0);
+
+	buf[1] = buf[2] = buf[3] = go_pinf;
+	go_data_vector_emit_changed_range (vec, 1, 4);
+	check_minmax (vec, DBL_MAX, -DBL_MAX);
+	g_assert (go_data_vector_get_stats (vec)->n_finite == 0);
+
+	buf[3] = -1;
+	go_data_vector_emit_changed_range (vec, 3, 4);
+	check_minmax (vec, -1, -1);
+	g_object_unref (dat);
+
+	/* Without valid cache, everything is reloaded.  */
+	buf[0] = 3; buf[1] = 1; buf[2] = 4; buf[3] = 1;
+	dat = go_data_vector_val_new (buf, 4, NULL);
+	vec = GO_DATA_VECTOR (dat);
+	g_signal_connect (dat, "changed-range",
+			  G_CALLBACK (cb_changed_range), log);
+	g_string_truncate (log, 0);
+	go_data_vector_emit_changed_range (vec, 0, 4);
+	g_assert (strcmp (log->str, "range 0 4;") == 0);
+	check_minmax (vec, 1, 4);
+	g_object_unref (dat);
+
+	g_string_free (log, TRUE);
+}
+
+/* ------------------------------------------------------------------------- */
+
+int
+main (int argc, char **argv)
+{
+	libgoffice_init ();
+
+	test_mapped ();
+	test_base64 ();
+	test_stats ();
+	test_changed_range ();
+
+	libgoffice_shutdown ();
+
+	return 0;
+}
@@ -130,7 +130,53 @@ test1d_shortest (double d)
 	g_string_free (res, TRUE);
 }
 
+static void
+test_shortest_buf (double d, const char *expected)
+{
+	char buf[GO_DTOA_SHORTEST_BUF_SIZE];
+	int n = go_dtoa_shortest (d, buf);
 
+	if (n != (int)strlen (buf) || !g_str_equal (buf, expected)) {
+		g_printerr ("go_dtoa_shortest failed for %a (got \"%s\", expected \"%s\")\n",
+			    d, buf, expected);
+		fail++;
+	}
+}
+
+// Check that go_dtoa_shortest round-trips through both go_ascii_strtod
+// and g_ascii_strtod and that the two parsers agree.
+static void
+test_shortest_roundtrip (double d)
+{
+	char buf[GO_DTOA_SHORTEST_BUF_SIZE];
+	char *end;
+	double r;
+
+	go_dtoa_shortest (d, buf);
+	r = go_ascii_strtod (buf, &end);
+	if (r != d || *end || signbit (r) != signbit (d)) {
+		g_printerr ("Round-trip failure for %a (got \"%s\")\n", d, buf);
+		fail++;
+	}
+	if (g_ascii_strtod (buf, NULL) != r) {
+		g_printerr ("Parsers disagree for \"%s\"\n", buf);
+		fail++;
+	}
+}
+
+static void
+test_shortest_v (void)
+{
+	double xs[] = { 1, 0.5, -2e-300, 1e100 };
+	GString *res = g_string_new ("x");
+
+	go_dtoa_shortest_v (res, xs, G_N_ELEMENTS (xs), ';');
+	if (!g_str_equal (res->str, "x1;0.5;-2e-300;1e+100")) {
+		g_printerr ("go_dtoa_shortest_v failed (got \"%s\")\n", res->str);
+		fail++;
+	}
+	g_string_free (res, TRUE);
+}
 
 
 int
@@ -179,6 +225,31 @@ main (void)
 		test1d_shortest (d);
 	}
 
+	test_shortest_buf (0, "0");
+	test_shortest_buf (-0.0, "-0");
+	test_shortest_buf (0.1, "0.1");
+	test_shortest_buf (100, "100");
+	test_shortest_buf (1e-4, "0.0001");
+	test_shortest_buf (1e-5, "1e-05");
+	test_shortest_buf (1e16, "10000000000000000");
+	test_shortest_buf (1e17, "1e+17");
+	test_shortest_buf (5e-324, "5e-324");
+	test_shortest_buf (G_MAXDOUBLE, "1.7976931348623157e+308");
+	test_shortest_buf (go_pinf, "inf");
+	test_shortest_buf (go_ninf, "-inf");
+	test_shortest_v ();
+
+	for (int i = 0; i < 100000; i++) {
+		double n = g_rand_int_range (grand, -999999, +999999);
+		double d = go_pow10 (g_rand_int_range (grand, 0, 12));
+		guint64 u = ((guint64)g_rand_int (grand) << 32) | g_rand_int (grand);
+		double x;
+		memcpy (&x, &u, sizeof (x));
+		test_shortest_roundtrip (n / d);
+		if (go_finite (x))
+			test_shortest_roundtrip (x);
+	}
+
 	g_rand_free (grand);
 
 	return fail;
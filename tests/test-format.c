@@ -1,4 +1,5 @@
 #include <goffice/goffice.h>
+#include <pango/pangocairo.h>
 #include <string.h>
 
 /* ------------------------------------------------------------------------- */
@@ -126,12 +127,254 @@ test_general_format (void)
 
 /* ------------------------------------------------------------------------- */
 
+static void
+test_values_format_1 (const char *fmtstr)
+{
+	static const double vals[] = {
+		0, 1, -1, 0.5, -0.125, 1.0 / 3, 42, 1234.5678, -98765.4321,
+		1e-20, 6.02214076e23, 45678.25
+	};
+	size_t n = G_N_ELEMENTS (vals);
+	GOFormat *fmt = go_format_new_from_XL (fmtstr);
+	GString *pool = g_string_new (NULL);
+	gsize offsets[G_N_ELEMENTS (vals)];
+	size_t ui;
+
+	go_format_values_gstring (pool, offsets, fmt, vals, n,
+				  -1, NULL, FALSE);
+
+	for (ui = 0; ui < n; ui++) {
+		char *expected = go_format_value (fmt, vals[ui]);
+		const char *got = pool->str + offsets[ui];
+
+		g_printerr ("go_format_values_gstring: [%s] %.17g -> \"%s\"\n",
+			    fmtstr, vals[ui], got);
+
+		if (strcmp (got, expected) != 0) {
+			g_printerr ("Expected \"%s\"\n", expected);
+			g_assert (0);
+		}
+		g_free (expected);
+	}
+
+	g_string_free (pool, TRUE);
+	go_format_unref (fmt);
+}
+
+static void
+test_values_format (void)
+{
+	test_values_format_1 ("General");
+	test_values_format_1 ("0");
+	test_values_format_1 ("0.00");
+	test_values_format_1 ("#,##0.00");
+	test_values_format_1 ("0%");
+	test_values_format_1 ("0.00E+00");
+	test_values_format_1 ("# ?/?");
+	test_values_format_1 ("yyyy-mm-dd hh:mm:ss");
+	test_values_format_1 ("[Red]0.0;[Blue]-0.0;\"zero\"");
+	test_values_format_1 ("[>100]\"big\";[<0]\"neg\";0.000");
+}
+
+/* ------------------------------------------------------------------------- */
+
+static void
+test_format_1 (const char *fmtstr, double val, const char *expected)
+{
+	GOFormat *fmt = go_format_new_from_XL (fmtstr);
+	char *s = go_format_value (fmt, val);
+
+	g_printerr ("go_format_value: [%s] %.17g -> \"%s\"\n",
+		    fmtstr, val, s);
+
+	if (strcmp (s, expected) != 0) {
+		g_printerr ("Expected \"%s\"\n", expected);
+		g_assert (0);
+	}
+
+	g_free (s);
+	go_format_unref (fmt);
+}
+
+static void
+test_common_formats (void)
+{
+	/* These all take the fast path in go-format.c  */
+	test_format_1 ("General", 0.5, "0.5");
+	test_format_1 ("General", -1234.5678, "-1234.5678");
+
+	test_format_1 ("0", 0, "0");
+	test_format_1 ("0", 42, "42");
+	test_format_1 ("0", -1.25, "-1");
+	test_format_1 ("0", -0.25, "0");
+	test_format_1 ("0", 1234.5678, "1235");
+
+	test_format_1 ("0.00", 1234.5678, "1234.57");
+	test_format_1 ("0.00", -0.001, "0.00");
+	test_format_1 ("0.00", 0.5, "0.50");
+	test_format_1 ("0.00", -98765.4321, "-98765.43");
+	test_format_1 ("#.00", 0.5, ".50");
+	test_format_1 ("000.0", 1.26, "001.3");
+
+	test_format_1 ("#,##0", 999, "999");
+	test_format_1 ("#,##0", 1000, "1,000");
+	test_format_1 ("#,##0.00", 0.5, "0.50");
+	test_format_1 ("#,##0.00", 1234.5678, "1,234.57");
+	test_format_1 ("#,##0.00", -98765.4321, "-98,765.43");
+	test_format_1 ("#,##0.00", 1234567.891, "1,234,567.89");
+
+	test_format_1 ("0%", 0.5, "50%");
+	test_format_1 ("0%", -0.126, "-13%");
+	test_format_1 ("0.00%", 0.1236, "12.36%");
+
+	test_format_1 ("0.00E+00", 0, "0.00E+00");
+	test_format_1 ("0.00E+00", 1234.5678, "1.23E+03");
+	test_format_1 ("0.00E+00", -98765.4321, "-9.88E+04");
+	test_format_1 ("0.00E+00", 1e-20, "1.00E-20");
+	test_format_1 ("0.00E+000", 6.02214076e23, "6.02E+023");
+	test_format_1 ("0.0E-0", 1234.5678, "1.2E3");
+}
+
+/* ------------------------------------------------------------------------- */
+
+static void
+test_render_cache (void)
+{
+	static const double vals[] = { 45678.25, 1.5, 45678.25, 1.5, 2.5 };
+	GOFormat *fmt = go_format_new_from_XL ("yyyy-mmm-dd hh:mm"), *fmt2;
+	char *uncached[G_N_ELEMENTS (vals)];
+	char *s;
+	gsize hits, misses;
+	size_t ui;
+
+	for (ui = 0; ui < G_N_ELEMENTS (vals); ui++)
+		uncached[ui] = go_format_value (fmt, vals[ui]);
+
+	go_format_set_render_cache_size (2);
+	for (ui = 0; ui < G_N_ELEMENTS (vals); ui++) {
+		s = go_format_value (fmt, vals[ui]);
+		g_printerr ("cached: %.17g -> \"%s\"\n", vals[ui], s);
+		g_assert (strcmp (s, uncached[ui]) == 0);
+		g_free (s);
+		g_free (uncached[ui]);
+	}
+
+	go_format_get_render_cache_stats (fmt, &hits, &misses);
+	g_printerr ("render cache: %d hits, %d misses\n",
+		    (int)hits, (int)misses);
+	g_assert (hits == 2 && misses == 3);
+
+	// Disabling frees the caches but keeps the totals.
+	go_format_set_render_cache_size (0);
+	go_format_get_render_cache_stats (fmt, &hits, &misses);
+	g_assert (hits == 0 && misses == 0);
+	go_format_get_render_cache_stats (NULL, &hits, &misses);
+	g_assert (hits >= 2 && misses >= 3);
+	s = go_format_value (fmt, vals[0]);
+	go_format_get_render_cache_stats (fmt, &hits, &misses);
+	g_assert (hits == 0 && misses == 0);
+	g_free (s);
+
+	// Rendering a format with a locale tag, which switches the locale
+	// while it renders, must not spoil the caches of other formats.
+	go_format_set_render_cache_size (8);
+	fmt2 = go_format_new_from_XL ("[$-409]yyyy-mmm-dd hh:mm");
+	for (ui = 0; ui < 6; ui++) {
+		s = go_format_value (ui % 2 ? fmt2 : fmt, vals[0]);
+		g_free (s);
+	}
+	go_format_get_render_cache_stats (fmt, &hits, &misses);
+	g_printerr ("render cache with locale tags: %d hits, %d misses\n",
+		    (int)hits, (int)misses);
+	g_assert (hits == 2 && misses == 1);
+	go_format_get_render_cache_stats (fmt2, &hits, &misses);
+	g_assert (hits == 2 && misses == 1);
+	go_format_set_render_cache_size (0);
+	go_format_unref (fmt2);
+
+	go_format_unref (fmt);
+}
+
+/* ------------------------------------------------------------------------- */
+
+static int
+measure_pango_text (PangoLayout *layout, const char *text)
+{
+	int w;
+	pango_layout_set_text (layout, text, -1);
+	pango_layout_set_attributes (layout, NULL);
+	pango_layout_get_size (layout, &w, NULL);
+	return w;
+}
+
+static void
+test_measure_advances (void)
+{
+	PangoContext *context =
+		pango_font_map_create_context (pango_cairo_font_map_get_default ());
+	PangoFontDescription *desc = pango_font_description_from_string ("Sans 10");
+	PangoLayout *layout = pango_layout_new (context);
+	GString *str = g_string_new (NULL);
+	GOFormat *fmt = go_format_new_from_XL ("0_)");
+	static const char *strs[] = {
+		"0", "7", "-", "+", "E", ".", " ", "\xe2\x88\x92",
+		"12345", "-1.25E+07", "\xe2\x88\x92" "42"
+	};
+	unsigned ui;
+	int w, wp;
+
+	pango_layout_set_font_description (layout, desc);
+
+	for (ui = 0; ui < G_N_ELEMENTS (strs); ui++) {
+		size_t n = g_utf8_strlen (strs[ui], -1);
+
+		g_string_assign (str, strs[ui]);
+		w = go_format_measure_advances (str, layout);
+		wp = measure_pango_text (layout, strs[ui]);
+		g_printerr ("advances: \"%s\" -> %d, pango %d\n",
+			    strs[ui], w, wp);
+		// Single characters must match; longer strings may differ
+		// by rounding of each advance.
+		if (n == 1)
+			g_assert (w == wp);
+		else
+			g_assert (ABS (w - wp) <= (int)n);
+	}
+
+	// Second lookup comes from the table.
+	g_string_assign (str, "0");
+	g_assert (go_format_measure_advances (str, layout) ==
+		  measure_pango_text (layout, "0"));
+
+	// The blank left by "_)" is as wide as ")".
+	g_string_truncate (str, 0);
+	go_format_value_gstring (layout, str, go_format_measure_pango,
+				 go_font_metrics_unit,
+				 fmt, 1, 'F', NULL, NULL, -1, NULL, FALSE);
+	pango_layout_get_size (layout, &w, NULL);
+	wp = measure_pango_text (layout, "1)");
+	g_printerr ("advances: blank for \")\" -> %d, pango %d\n", w, wp);
+	g_assert (ABS (w - wp) <= 2);
+
+	go_format_unref (fmt);
+	g_string_free (str, TRUE);
+	pango_font_description_free (desc);
+	g_object_unref (layout);
+	g_object_unref (context);
+}
+
+/* ------------------------------------------------------------------------- */
+
 int
 main (int argc, char **argv)
 {
 	libgoffice_init ();
 
 	test_general_format ();
+	test_common_formats ();
+	test_values_format ();
+	test_render_cache ();
+	test_measure_advances ();
 
 	libgoffice_shutdown ();
 
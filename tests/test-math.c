@@ -1,4 +1,5 @@
 #include <goffice/goffice.h>
+#include <string.h>
 
 #ifdef GOFFICE_WITH_DECIMAL64
 /*
@@ -276,6 +277,719 @@ strto_tests (void)
 }
 
 
+/* ------------------------------------------------------------------------- */
+
+static void
+rangefunc_tests (void)
+{
+	static const double cancel[] = { 1e100, 1, -1e100, 1e-100 };
+	static const double shifted[] = { 1e9 + 1, 1e9 + 2, 1e9 + 3 };
+	static const double fs[] = { 0.5, 0, 1, 0.25, 0.75, 0.1, 0.99 };
+	double xs[1000], fres[G_N_ELEMENTS (fs)];
+	double r, ref;
+	GOAccumulator *acc;
+	void *state;
+	int i, n;
+
+	go_range_sum (cancel, G_N_ELEMENTS (cancel), &r);
+	g_printerr ("go_range_sum(cancel) = %.17g\n", r);
+	g_assert (r == 1);
+
+	go_range_devsq (shifted, G_N_ELEMENTS (shifted), &r);
+	g_printerr ("go_range_devsq(shifted) = %.17g\n", r);
+	g_assert (r == 2);
+
+	go_range_sumsq (shifted, 1, &r);
+	g_assert (r == shifted[0] * shifted[0]);
+
+	/* Must agree bit-for-bit with the accumulator.  */
+	for (i = 0; i < (int)G_N_ELEMENTS (xs); i++)
+		xs[i] = ldexp (sin (i * 1.25), (i * 37) % 200 - 100);
+	state = go_accumulator_start ();
+	acc = go_accumulator_new ();
+	for (i = G_N_ELEMENTS (xs) - 1; i >= 0; i--)
+		go_accumulator_add (acc, xs[i]);
+	ref = go_accumulator_value (acc);
+	go_accumulator_free (acc);
+	go_accumulator_end (state);
+	go_range_sum (xs, G_N_ELEMENTS (xs), &r);
+	g_printerr ("go_range_sum(xs) = %.17g  [%.17g]\n", r, ref);
+	g_assert (r == ref);
+
+	/*
+	 * Widely spread exponents need more partials than go_range_sum
+	 * keeps on the stack.  The tail is just above half an ulp of the
+	 * leading term so the sum must round up.
+	 */
+	for (n = 0; n < 36; n++)
+		xs[n] = ldexp (1, 1000 - 53 * n);
+	go_range_sum (xs, n, &r);
+	g_printerr ("go_range_sum(spread) = %a\n", r);
+	g_assert (r == ldexp (1, 1000) + ldexp (1, 948));
+
+	/* Merged and parallel sums must agree bit-for-bit.  */
+	{
+		int N = 400000;
+		double *big = g_new (double, N);
+		GOAccumulator *acc2;
+
+		for (i = 0; i < N; i++)
+			big[i] = ldexp (cos (i * 0.75), (i * 13) % 120 - 60);
+		go_range_sum (big, N, &ref);
+		go_range_sum_parallel (big, N, &r);
+		g_printerr ("go_range_sum_parallel(big) = %.17g  [%.17g]\n", r, ref);
+		g_assert (r == ref);
+
+		state = go_accumulator_start ();
+		acc = go_accumulator_new ();
+		acc2 = go_accumulator_new ();
+		for (i = 0; i < N; i++)
+			go_accumulator_add (i < N / 3 ? acc : acc2, big[i]);
+		go_accumulator_merge (acc2, acc);
+		r = go_accumulator_value (acc2);
+		go_accumulator_free (acc);
+		go_accumulator_free (acc2);
+		go_accumulator_end (state);
+		g_printerr ("go_accumulator_merge(big) = %.17g  [%.17g]\n", r, ref);
+		g_assert (r == ref);
+
+		for (i = 0; i < N; i++)
+			big[i] = (i % 3 ? 1 : -1) *
+				ldexp (1 + (i % 7) * 0x1p-30, 1000 - 53 * (i % 39));
+		go_range_sum (big, N, &ref);
+		go_range_sum_parallel (big, N, &r);
+		g_printerr ("go_range_sum_parallel(spread) = %a  [%a]\n", r, ref);
+		g_assert (r == ref);
+
+		g_free (big);
+	}
+
+	/* Selection must agree with sorting.  */
+	for (i = 0; i < (int)G_N_ELEMENTS (xs); i++)
+		xs[i] = (i * 7919) % 101;
+	for (n = 1; n <= (int)G_N_ELEMENTS (xs); n = n * 3 + 1) {
+		double *sorted = go_range_sort (xs, n);
+		go_range_fractiles (xs, n, fres, fs, G_N_ELEMENTS (fs));
+		for (i = 0; i < (int)G_N_ELEMENTS (fs); i++) {
+			go_range_fractile_inter_sorted (sorted, n, &ref, fs[i]);
+			g_printerr ("go_range_fractiles(%d,%g) = %.17g  [%.17g]\n",
+				    n, fs[i], fres[i], ref);
+			g_assert (fres[i] == ref);
+		}
+		g_free (sorted);
+	}
+}
+
+/* ------------------------------------------------------------------------- */
+
+static void
+fft_tests (void)
+{
+	int n;
+
+	for (n = 1; n <= 40; n++) {
+		go_complex *in = g_new (go_complex, n), *f, *back, *fr;
+		double *rin = g_new (double, n);
+		int i;
+
+		for (i = 0; i < n; i++) {
+			rin[i] = sin (i * 1.5) + i;
+			in[i].re = rin[i];
+			in[i].im = 0;
+		}
+
+		go_fourier_fft (in, n, 1, &f, FALSE);
+		go_fourier_fft_real (rin, n, 1, &fr);
+		for (i = 0; i < n; i++)
+			f[i].re *= n, f[i].im *= n;
+		go_fourier_fft (f, n, 1, &back, TRUE);
+
+		for (i = 0; i < n; i++) {
+			g_assert (fabs (back[i].re - in[i].re) < 1e-12 * n);
+			g_assert (fabs (back[i].im) < 1e-12 * n);
+			g_assert (fabs (fr[i].re * n - f[i].re) < 1e-12 * n);
+			g_assert (fabs (fr[i].im * n - f[i].im) < 1e-12 * n);
+		}
+		g_printerr ("fft(%d) ok\n", n);
+
+		g_free (in);
+		g_free (rin);
+		g_free (f);
+		g_free (fr);
+		g_free (back);
+	}
+}
+		g_free (back);
+	}
+}
+
+/* Naive O(n^2) transform in long double, scaled like go_fourier_fft.  */
+static void
+naive_dft (go_complex const *in, int n, go_complex *out, gboolean inverse)
+{
+	int j, k;
+
+	for (k = 0; k < n; k++) {
+		long double re = 0, im = 0;
+		for (j = 0; j < n; j++) {
+			/* Reduce jk mod n first to keep the angle exact.  */
+			long double a = (inverse ? 2 : -2) * (long double)M_PI *
+				(long double)((long long)j * k % n) / n;
+			long double c = cosl (a), s = sinl (a);
+			re += in[j].re * c - in[j].im * s;
+			im += in[j].re * s + in[j].im * c;
+		}
+		out[k].re = re / n;
+		out[k].im = im / n;
+	}
+}
+
+static void
+fft_naive_tests (void)
+{
+	static const int sizes[] = {
+		1, 2, 4, 8, 16, 64, 256, 1024,
+		3, 5, 6, 7, 12, 17, 100, 127, 243, 1000
+	};
+	unsigned ui;
+
+	for (ui = 0; ui < G_N_ELEMENTS (sizes); ui++) {
+		int n = sizes[ui], i, inverse;
+		go_complex *in = g_new (go_complex, n);
+		go_complex *ref = g_new (go_complex, n);
+
+		for (i = 0; i < n; i++) {
+			in[i].re = cos (i * 0.7) + (i % 5) - 2;
+			in[i].im = sin (i * 1.3) * 0.5;
+		}
+
+		for (inverse = 0; inverse <= 1; inverse++) {
+			go_complex *f;
+			double err = 0;
+
+			go_fourier_fft (in, n, 1, &f, inverse);
+			naive_dft (in, n, ref, inverse);
+			for (i = 0; i < n; i++) {
+				err = MAX (err, fabs (f[i].re - ref[i].re));
+				err = MAX (err, fabs (f[i].im - ref[i].im));
+			}
+			g_printerr ("fft(%d%s) vs naive dft: max error %g\n",
+				    n, inverse ? ", inverse" : "", err);
+			g_assert (err < 1e-13);
+			g_free (f);
+		}
+
+		g_free (in);
+		g_free (ref);
+	}
+}
+
+/* ------------------------------------------------------------------------- */
+
+static void
+distribution_batch_tests (void)
+{
+	int const n = 1000;
+	double *x = g_new (double, n), *p = g_new (double, n);
+	double *res = g_new (double, n);
+	int i, lt;
+
+	for (i = 0; i < n; i++) {
+		x[i] = (i - n / 2) / 100.;
+		p[i] = i / (n - 1.);
+	}
+	x[3] = go_nan;
+	p[3] = go_nan;
+
+	for (lt = 0; lt <= 1; lt++) {
+#define CHECK_BATCH(f_,xs_,a_,b_) do {					\
+	f_ ## _v (xs_, res, n, a_, b_, lt, FALSE);			\
+	for (i = 0; i < n; i++) {					\
+		double e = f_ (xs_[i], a_, b_, lt, FALSE);		\
+		g_assert (e == res[i] || (isnan (e) && isnan (res[i])));\
+	}								\
+} while (0)
+		CHECK_BATCH (go_pnorm, x, 1, 2);
+		CHECK_BATCH (go_qnorm, p, 1, 2);
+		CHECK_BATCH (go_plnorm, x, 0.5, 0.75);
+		CHECK_BATCH (go_qlnorm, p, 0.5, 0.75);
+		CHECK_BATCH (go_pweibull, x, 1.5, 3);
+		CHECK_BATCH (go_qweibull, p, 1.5, 3);
+		CHECK_BATCH (go_pnorm, x, 0, -1);
+#undef CHECK_BATCH
+	}
+
+	for (i = 0; i < (int)GO_DISTRIBUTION_MAX; i++) {
+		GODistribution *dist = go_distribution_new (i);
+		int j;
+
+		if (!dist)
+			continue;
+		go_distribution_scale (dist, 2, 3);
+		go_distribution_get_ppf_v (dist, p, res, n);
+		for (j = 0; j < n; j++) {
+			double e = go_distribution_get_ppf (dist, p[j]);
+			g_assert (e == res[j] || (isnan (e) && isnan (res[j])));
+		}
+		g_object_unref (dist);
+	}
+	g_printerr ("distribution batch ok\n");
+
+	g_free (x);
+	g_free (p);
+	g_free (res);
+}
+
+/* ------------------------------------------------------------------------- */
+
+static void
+cspline_check_batch (GOCSpline const *sp, double const *q, int m)
+{
+	double *vals = go_cspline_get_values (sp, q, m);
+	double *derivs = go_cspline_get_derivs (sp, q, m);
+	int i;
+
+	g_assert (vals != NULL && derivs != NULL);
+	for (i = 0; i < m; i++) {
+		double v = go_cspline_get_value (sp, q[i]);
+		double d = go_cspline_get_deriv (sp, q[i]);
+		g_assert (fabs (vals[i] - v) <= 1e-12 * (1 + fabs (v)));
+		g_assert (fabs (derivs[i] - d) <= 1e-12 * (1 + fabs (d)));
+	}
+	g_free (vals);
+	g_free (derivs);
+}
+
+static void
+cspline_tests (void)
+{
+	static const int sizes[][2] = { { 50, 1000 }, { 2000, 100 } };
+	unsigned si;
+
+	for (si = 0; si < G_N_ELEMENTS (sizes); si++) {
+		int n = sizes[si][0], m = sizes[si][1];
+		double *x = g_new (double, n), *y = g_new (double, n);
+		double *q = g_new (double, m), *res = g_new (double, m);
+		GOCSpline *sp;
+		int i;
+
+		for (i = 0; i < n; i++) {
+			x[i] = i + (i % 3) / 4.;
+			y[i] = sin (x[i] / 5);
+		}
+		sp = go_cspline_init (x, y, n, GO_CSPLINE_NATURAL, 0, 0);
+		g_assert (sp != NULL);
+
+		// The batch functions walk the knots instead of bisecting for
+		// each value.  Compare with go_cspline_get_value, which picks
+		// the other polynomial at one knot, hence the tolerance.
+		for (i = 0; i < m; i++)
+			q[i] = -2 + (n + 4) * (double)i / m;
+		cspline_check_batch (sp, x, n);
+		cspline_check_batch (sp, q, m);
+
+		// Unsorted values are refused.
+		res[0] = q[1];
+		res[1] = q[0];
+		g_assert (go_cspline_get_values (sp, res, 2) == NULL);
+
+		go_cspline_destroy (sp);
+		g_free (x);
+		g_free (y);
+		g_free (q);
+		g_free (res);
+	}
+	g_printerr ("cspline ok\n");
+}
+
+static void
+cspline_refit_tests (void)
+{
+	static const int sizes[] = { 20, 20, 7, 30, 30 };
+	int const nmax = 30;
+	double *x = g_new (double, nmax), *y = g_new (double, nmax);
+	GOCSplineWorkspace *ws = go_cspline_workspace_new ();
+	GOCSpline *sp = NULL;
+	unsigned si;
+	int i, type;
+
+	for (si = 0; si < G_N_ELEMENTS (sizes); si++) {
+		int n = sizes[si];
+
+		for (i = 0; i < n; i++) {
+			x[i] = i + (i % 3) / 4. + si;
+			y[i] = cos (x[i] * (si + 1) / 7);
+		}
+
+		for (type = 0; type < GO_CSPLINE_MAX; type++) {
+			GOCSpline *fresh =
+				go_cspline_init (x, y, n, type, 0.5, -1.5);
+
+			if (sp == NULL)
+				sp = go_cspline_init (x, y, n, type, 0.5, -1.5);
+			else
+				g_assert (go_cspline_refit (sp, x, y, n, type, 0.5, -1.5,
+							    (type & 1) ? ws : NULL));
+			g_assert (sp->n == n);
+			for (i = 0; i < n - 1; i++) {
+				g_assert (sp->a[i] == fresh->a[i]);
+				g_assert (sp->b[i] == fresh->b[i]);
+				g_assert (sp->c[i] == fresh->c[i]);
+			}
+			go_cspline_destroy (fresh);
+		}
+	}
+
+	// A failed refit leaves the spline alone.
+	x[1] = x[0];
+	g_assert (!go_cspline_refit (sp, x, y, 10, GO_CSPLINE_NATURAL, 0, 0, ws));
+	g_assert (sp->n == sizes[G_N_ELEMENTS (sizes) - 1]);
+
+	g_printerr ("cspline refit ok\n");
+
+	go_cspline_destroy (sp);
+	go_cspline_workspace_free (ws);
+	g_free (x);
+	g_free (y);
+}
+
+/* ------------------------------------------------------------------------- */
+
+static GORegressionResult
+nlr_model (double **xs, int n, double const *par, double *f, gpointer user)
+{
+	int k;
+
+	for (k = 0; k < n; k++)
+		f[k] = par[0] * exp (-par[1] * xs[k][0]) + par[2];
+	return GO_REG_ok;
+}
+
+static GORegressionResult
+nlr_jacobian (double **xs, int n, double const *par, double **jac, gpointer user)
+{
+	int k;
+
+	for (k = 0; k < n; k++) {
+		double e = exp (-par[1] * xs[k][0]);
+		jac[0][k] = e;
+		jac[1][k] = -par[0] * xs[k][0] * e;
+		jac[2][k] = 1;
+	}
+	return GO_REG_ok;
+}
+
+static GORegressionResult
+nlr_model_1 (double *x, double *par, double *f)
+{
+	return nlr_model (&x, 1, par, f, NULL);
+}
+
+static void
+non_linear_regression_tests (void)
+{
+	static const double truth[3] = { 2.5, 0.75, -1 };
+	int const n = 200;
+	double **xs = g_new (double *, n), *ys = g_new (double, n);
+	int k, pass;
+
+	for (k = 0; k < n; k++) {
+		xs[k] = g_new (double, 1);
+		xs[k][0] = k / 20.;
+		nlr_model (&xs[k], 1, truth, &ys[k], NULL);
+	}
+
+	for (pass = 0; pass < 3; pass++) {
+		double par[3] = { 1, 1, 0 }, errors[3], chi;
+		GORegressionResult res;
+
+		if (pass == 2)
+			res = go_non_linear_regression_parallel
+				(nlr_model_1, xs, par, ys, NULL, n, 3,
+				 &chi, errors);
+		else
+			res = go_non_linear_regression_batch
+				(nlr_model, pass ? nlr_jacobian : NULL, NULL,
+				 xs, par, ys, NULL, n, 3, &chi, errors);
+		g_printerr ("nlr(%d): %g %g %g, chi=%g\n",
+			    pass, par[0], par[1], par[2], chi);
+		g_assert (res == GO_REG_ok);
+		for (k = 0; k < 3; k++)
+			g_assert (fabs (par[k] - truth[k]) < 1e-6);
+		g_assert (chi < 1e-12);
+	}
+
+	for (k = 0; k < n; k++)
+		g_free (xs[k]);
+	g_free (xs);
+	g_free (ys);
+}
+
+/* A = J J^T at par, J as from nlr_jacobian divided by sigma.  */
+static void
+nlr_normal_matrix (double **xs, int n, double const *par, double sigma,
+		   double **A)
+{
+	double **J = g_new (double *, 3);
+	int i, j, k;
+
+	for (i = 0; i < 3; i++)
+		J[i] = g_new (double, n);
+	nlr_jacobian (xs, n, par, J, NULL);
+	for (i = 0; i < 3; i++) {
+		for (j = 0; j < 3; j++) {
+			double s = 0;
+			for (k = 0; k < n; k++)
+				s += J[i][k] * J[j][k];
+			A[i][j] = s / (sigma * sigma);
+		}
+	}
+	for (i = 0; i < 3; i++)
+		g_free (J[i]);
+	g_free (J);
+}
+
+/*
+ * go_non_linear_regression reports 1/sqrt(A[i][i]) and
+ * go_non_linear_regression_batch sqrt((A^-1)[i][i]).  Check both on one
+ * noisy problem with correlated parameters.
+ */
+static void
+non_linear_regression_errors_tests (void)
+{
+	static const double truth[3] = { 2.5, 0.75, -1 };
+	int const n = 200;
+	double const sigma = 0.1;
+	double **xs = g_new (double *, n), *ys = g_new (double, n);
+	double *sigmas = g_new (double, n);
+	double par_old[3] = { 2, 1, 0 }, err_old[3];
+	double par_new[3] = { 2, 1, 0 }, err_new[3];
+	double *A[3], a[3][3], chi;
+	int i, k;
+
+	for (k = 0; k < n; k++) {
+		xs[k] = g_new (double, 1);
+		xs[k][0] = k / 20.;
+		nlr_model (&xs[k], 1, truth, &ys[k], NULL);
+		ys[k] += sigma * sin (k * 12.9898);
+		sigmas[k] = sigma;
+	}
+	for (i = 0; i < 3; i++)
+		A[i] = a[i];
+
+	g_assert (go_non_linear_regression (nlr_model_1, xs, par_old, ys,
+					    sigmas, n, 3, &chi, err_old)
+		  == GO_REG_ok);
+	g_assert (go_non_linear_regression_batch (nlr_model, nlr_jacobian,
+						  NULL, xs, par_new, ys,
+						  sigmas, n, 3, &chi, err_new)
+		  == GO_REG_ok);
+
+	nlr_normal_matrix (xs, n, par_old, sigma, A);
+	for (i = 0; i < 3; i++) {
+		double e = 1 / sqrt (A[i][i]);
+		g_printerr ("nlr errors: old %g [%g]\n", err_old[i], e);
+		g_assert (fabs (err_old[i] - e) < 1e-3 * e);
+	}
+
+	nlr_normal_matrix (xs, n, par_new, sigma, A);
+	g_assert (go_matrix_invert (A, 3));
+	for (i = 0; i < 3; i++) {
+		double e = sqrt (A[i][i]);
+		g_printerr ("nlr errors: batch %g [%g]\n", err_new[i], e);
+		g_assert (fabs (err_new[i] - e) < 1e-8 * e);
+		g_assert (err_new[i] > err_old[i]);
+		g_assert (fabs (par_new[i] - par_old[i]) < err_new[i]);
+	}
+
+	for (k = 0; k < n; k++)
+		g_free (xs[k]);
+	g_free (xs);
+	g_free (ys);
+	g_free (sigmas);
+}
+
+/* ------------------------------------------------------------------------- */
+
+static void
+polynomial_tests (void)
+{
+	// (x-1)^5 expanded.  Near 1 the terms cancel so badly that plain
+	// Horner gets not even the sign right.
+	static const double a[6] = { -1, 5, -10, 10, -5, 1 };
+	int n = 200, i;
+	double *x = g_new (double, n), *y = g_new (double, n);
+
+	// Go past the block size and end with a partial block.
+	for (i = 0; i < n; i++)
+		x[i] = 1 + (i - n / 2) / 1024.0;
+	go_polynomial_eval_v (a, 5, x, y, n);
+
+	for (i = 0; i < n; i++) {
+		double d = (i - n / 2) / 1024.0;
+		double exact = d * d * d * d * d, y1;
+
+		go_polynomial_eval_v (a, 5, &x[i], &y1, 1);
+		g_assert (y1 == y[i]);
+		g_assert (fabs (y[i] - exact) <= 1e-12 * fabs (exact));
+	}
+
+	// Degree zero.
+	go_polynomial_eval_v (a + 5, 0, x, y, n);
+	for (i = 0; i < n; i++)
+		g_assert (y[i] == 1);
+
+	g_free (x);
+	g_free (y);
+}
+
+static void
+linear_regression_tests (void)
+{
+	/* Small enough for the all-GOQuad code and big enough for the
+	   fast path.  */
+	static const int sizes[] = { 20, 5000 };
+	static const double coeffs[4] = { 1, 2, -0.5, 0.25 };
+	unsigned ui;
+
+	for (ui = 0; ui < G_N_ELEMENTS (sizes); ui++) {
+		int m = sizes[ui], i, j;
+		double *xss[3], *ys = g_new (double, m), res[4];
+		go_regression_stat_t *stat = go_regression_stat_new ();
+		GORegressionResult regres;
+
+		for (j = 0; j < 3; j++)
+			xss[j] = g_new (double, m);
+		for (i = 0; i < m; i++) {
+			double x = i * 4.0 / m;
+			xss[0][i] = x;
+			xss[1][i] = x * x;
+			xss[2][i] = x * x * x;
+			ys[i] = coeffs[0] + coeffs[1] * x +
+				coeffs[2] * x * x + coeffs[3] * x * x * x;
+		}
+
+		regres = go_linear_regression (xss, 3, ys, m, TRUE, res, stat);
+		g_printerr ("linreg(%d): %.17g %.17g %.17g %.17g\n",
+			    m, res[0], res[1], res[2], res[3]);
+		g_assert (regres == GO_REG_ok);
+		for (j = 0; j < 4; j++)
+			g_assert (fabs (res[j] - coeffs[j]) < 1e-12);
+		g_assert (fabs (stat->sqr_r - 1) < 1e-12);
+
+		for (j = 0; j < 3; j++)
+			g_free (xss[j]);
+		g_free (ys);
+		go_regression_stat_destroy (stat);
+	}
+}
+
+static void
+regression_state_tests (void)
+{
+	int m = 200, i, j;
+	double *xss[2], *ys = g_new (double, m), xs[2];
+	double res[3], sres[3];
+	go_regression_stat_t *stat = go_regression_stat_new ();
+	go_regression_stat_t *sstat = go_regression_stat_new ();
+	GORegressionState *state = go_regression_state_new (2, TRUE);
+	GORegressionResult regres;
+
+	for (j = 0; j < 2; j++)
+		xss[j] = g_new (double, m);
+	for (i = 0; i < m; i++) {
+		xss[0][i] = i;
+		xss[1][i] = sin (i);
+		ys[i] = 3 + 0.5 * i - 2 * sin (i) + cos (i * 1.7);
+	}
+
+	// Add all points, then remove the first half again.
+	for (i = 0; i < m; i++) {
+		xs[0] = xss[0][i];
+		xs[1] = xss[1][i];
+		go_regression_state_append (state, xs, ys[i]);
+	}
+	for (i = 0; i < m / 2; i++) {
+		xs[0] = xss[0][i];
+		xs[1] = xss[1][i];
+		g_assert (!go_regression_state_remove (state, xs, ys[i]));
+	}
+	g_assert (go_regression_state_get_n (state) == m - m / 2);
+
+	for (j = 0; j < 2; j++)
+		xss[j] += m / 2;
+	regres = go_linear_regression (xss, 2, ys + m / 2, m - m / 2,
+				       TRUE, res, stat);
+	g_assert (regres == GO_REG_ok);
+	regres = go_regression_state_get_result (state, sres, sstat);
+	g_assert (regres == GO_REG_ok);
+	g_printerr ("state linreg: %.17g %.17g %.17g\n",
+		    sres[0], sres[1], sres[2]);
+
+	for (j = 0; j < 3; j++) {
+		g_assert (fabs (sres[j] - res[j]) <= 1e-12 * fabs (res[j]));
+		g_assert (fabs (sstat->se[j] - stat->se[j]) <= 1e-10 * stat->se[j]);
+	}
+	g_assert (fabs (sstat->ss_resid - stat->ss_resid) <= 1e-10 * stat->ss_resid);
+	g_assert (fabs (sstat->sqr_r - stat->sqr_r) <= 1e-12);
+	g_assert (sstat->df_resid == stat->df_resid);
+
+	for (j = 0; j < 2; j++)
+		g_free (xss[j] - m / 2);
+	g_free (ys);
+	go_regression_state_free (state);
+	go_regression_stat_destroy (sstat);
+	go_regression_stat_destroy (stat);
+}
+
+static void
+regression_state_degenerate_tests (void)
+{
+	int m = 30, i, j;
+	double *xss[2], *ys = g_new (double, m), xs[2];
+	double res[3], sres[3];
+	go_regression_stat_t *stat = go_regression_stat_new ();
+	go_regression_stat_t *sstat = go_regression_stat_new ();
+	GORegressionState *state = go_regression_state_new (2, TRUE);
+	GORegressionResult regres;
+
+	// The second x-vector is the first plus a perturbation far below
+	// the degeneracy threshold, but y has a component along it.
+	for (j = 0; j < 2; j++)
+		xss[j] = g_new (double, m);
+	for (i = 0; i < m; i++) {
+		xss[0][i] = i;
+		xss[1][i] = 2 * i + 1;
+		if (i % 3 == 0)
+			xss[1][i] = nextafter (xss[1][i], 1000);
+		ys[i] = 3 + 0.5 * i + cos (i * 1.7);
+		xs[0] = xss[0][i];
+		xs[1] = xss[1][i];
+		go_regression_state_append (state, xs, ys[i]);
+	}
+
+	regres = go_linear_regression (xss, 2, ys, m, TRUE, res, stat);
+	g_assert (regres == GO_REG_ok);
+	regres = go_regression_state_get_result (state, sres, sstat);
+	g_assert (regres == GO_REG_ok);
+	g_printerr ("degenerate state linreg: %.17g %.17g %.17g\n",
+		    sres[0], sres[1], sres[2]);
+
+	g_assert (res[2] == 0 && sres[2] == 0);
+	for (j = 0; j < 2; j++)
+		g_assert (fabs (sres[j] - res[j]) <= 1e-12 * fabs (res[j]));
+	g_assert (fabs (sstat->ss_resid - stat->ss_resid) <= 1e-10 * stat->ss_resid);
+	g_assert (sstat->df_resid == stat->df_resid);
+	g_assert (sstat->df_reg == stat->df_reg);
+
+	for (j = 0; j < 2; j++)
+		g_free (xss[j]);
+	g_free (ys);
+	go_regression_state_free (state);
+	go_regression_stat_destroy (sstat);
+	go_regression_stat_destroy (stat);
+}
+
 /* ------------------------------------------------------------------------- */
 
 int
@@ -285,6 +999,18 @@ main (int argc, char **argv)
 
 	trig_tests ();
 	strto_tests ();
+	rangefunc_tests ();
+	fft_tests ();
+	fft_naive_tests ();
+	distribution_batch_tests ();
+	cspline_tests ();
+	cspline_refit_tests ();
+	non_linear_regression_tests ();
+	non_linear_regression_errors_tests ();
+	polynomial_tests ();
+	linear_regression_tests ();
+	regression_state_tests ();
+	regression_state_degenerate_tests ();
 
 	libgoffice_shutdown ();
 
@@ -403,6 +403,376 @@ init_tests (void)
 
 /* ------------------------------------------------------------------------- */
 
+static void
+matrix_fill (GOQuadMatrix *A, GRand *r)
+{
+	GOQuad three, t;
+	int i, j;
+
+	// Divide by three to get something with a low part.
+	go_quad_init (&three, 3);
+	for (i = 0; i < A->m; i++) {
+		for (j = 0; j < A->n; j++) {
+			go_quad_init (&t, g_rand_double_range (r, -1, 1));
+			go_quad_div (&A->data[i][j], &t, &three);
+		}
+	}
+}
+
+// Reference versions of the matrix kernels: the straightforward,
+// untiled code they replaced, written with the scalar GOQuad functions.
+
+static void
+ref_matrix_multiply (GOQuadMatrix *C, const GOQuadMatrix *A,
+		     const GOQuadMatrix *B)
+{
+	int i, j, k;
+
+	for (i = 0; i < C->m; i++) {
+		for (j = 0; j < C->n; j++) {
+			GOQuad p, acc = go_quad_zero;
+			for (k = 0; k < A->n; k++) {
+				go_quad_mul (&p, &A->data[i][k], &B->data[k][j]);
+				go_quad_add (&acc, &acc, &p);
+			}
+			C->data[i][j] = acc;
+		}
+	}
+}
+
+static gboolean
+ref_solve (const GOQuadMatrix *R, GOQuad *x, const GOQuad *b,
+	   gboolean fwd, gboolean allow_degenerate)
+{
+	int n = R->m, step = fwd ? 1 : -1, i, j, l;
+
+	for (l = 0; l < n; l++) {
+		GOQuad d, Rii, p;
+
+		i = fwd ? l : n - 1 - l;
+		d = b[i];
+		Rii = R->data[i][i];
+		if (go_quad_value (&Rii) == 0) {
+			if (allow_degenerate) {
+				x[i] = go_quad_zero;
+				continue;
+			}
+			for (; i >= 0 && i < n; i += step)
+				x[i] = go_quad_zero;
+			return TRUE;
+		}
+
+		for (j = fwd ? 0 : i + 1; j < (fwd ? i : n); j++) {
+			go_quad_mul (&p, fwd ? &R->data[j][i] : &R->data[i][j],
+				     &x[j]);
+			go_quad_sub (&d, &d, &p);
+		}
+		go_quad_div (&x[i], &d, &Rii);
+	}
+
+	return FALSE;
+}
+
+// Householder QR of the m-by-n A.  R is n-by-n and V m-by-n.
+static int
+ref_qr (const GOQuadMatrix *A, GOQuadMatrix *R, GOQuadMatrix *V)
+{
+	int m = A->m, n = A->n, qdet = 1, i, j, k;
+	GOQuadMatrix *W = go_quad_matrix_dup (A);
+	GOQuad *tmp = g_new (GOQuad, n);
+
+	for (k = 0; k < n; k++) {
+		GOQuad L, L2 = go_quad_zero, L2p = L2, s, p;
+
+		for (i = m - 1; i >= k; i--) {
+			V->data[i][k] = W->data[i][k];
+			go_quad_mul (&s, &V->data[i][k], &V->data[i][k]);
+			L2p = L2;
+			go_quad_add (&L2, &L2, &s);
+		}
+		go_quad_sqrt (&L, &L2);
+
+		if (go_quad_value (&V->data[k][k]) < 0)
+			go_quad_sub (&V->data[k][k], &V->data[k][k], &L);
+		else
+			go_quad_add (&V->data[k][k], &V->data[k][k], &L);
+
+		go_quad_mul (&s, &V->data[k][k], &V->data[k][k]);
+		go_quad_add (&L2p, &L2p, &s);
+		go_quad_sqrt (&L, &L2p);
+		if (go_quad_value (&L) == 0)
+			continue;
+		for (i = k; i < m; i++)
+			go_quad_div (&V->data[i][k], &V->data[i][k], &L);
+		qdet = -qdet;
+
+		for (j = k; j < n; j++) {
+			tmp[j] = go_quad_zero;
+			for (i = k; i < m; i++) {
+				go_quad_mul (&p, &V->data[i][k], &W->data[i][j]);
+				go_quad_add (&tmp[j], &tmp[j], &p);
+			}
+		}
+		for (j = k; j < n; j++) {
+			for (i = k; i < m; i++) {
+				go_quad_mul (&p, &V->data[i][k], &tmp[j]);
+				go_quad_add (&p, &p, &p);
+				go_quad_sub (&W->data[i][j], &W->data[i][j], &p);
+			}
+		}
+		for (i = k + 1; i < m; i++)
+			W->data[i][k] = go_quad_zero;
+	}
+
+	for (i = 0; i < n; i++)
+		for (j = 0; j < n; j++)
+			R->data[i][j] = W->data[i][j];
+
+	g_free (tmp);
+	go_quad_matrix_free (W);
+	return qdet;
+}
+
+static void
+ref_qr_multiply_qt (const GOQuadMatrix *V, GOQuad *x)
+{
+	int i, k;
+
+	for (k = 0; k < V->n; k++) {
+		GOQuad s = go_quad_zero, p;
+		for (i = k; i < V->m; i++) {
+			go_quad_mul (&p, &x[i], &V->data[i][k]);
+			go_quad_add (&s, &s, &p);
+		}
+		go_quad_add (&s, &s, &s);
+		for (i = k; i < V->m; i++) {
+			go_quad_mul (&p, &s, &V->data[i][k]);
+			go_quad_sub (&x[i], &x[i], &p);
+		}
+	}
+}
+
+static void
+assert_same_quads (const GOQuad *a, const GOQuad *b, int n)
+{
+	g_assert (memcmp (a, b, n * sizeof (GOQuad)) == 0);
+}
+
+// The tiled kernels must give the very same bits as the reference code.
+static void
+matrix_tests (void)
+{
+	GRand *r = g_rand_new_with_seed (42);
+	void *state = go_quad_start ();
+	int n, i, j, fwd, deg;
+
+	// Sizes below, at, and above the tile width.
+	for (n = 1; n <= 70; n += 23) {
+		int p = n + 3, c = 37;
+		GOQuadMatrix *A = go_quad_matrix_new (n, p);
+		GOQuadMatrix *B = go_quad_matrix_new (p, c);
+		GOQuadMatrix *C = go_quad_matrix_new (n, c);
+		GOQuadMatrix *Cref = go_quad_matrix_new (n, c);
+		GOQuadMatrix *R = go_quad_matrix_new (n, n);
+		GOQuadMatrix *X = go_quad_matrix_new (n, c);
+		GOQuad *b = g_new (GOQuad, n), *x = g_new (GOQuad, n);
+
+		matrix_fill (A, r);
+		matrix_fill (B, r);
+		go_quad_matrix_multiply (C, A, B);
+		ref_matrix_multiply (Cref, A, B);
+		for (i = 0; i < n; i++)
+			assert_same_quads (C->data[i], Cref->data[i], c);
+
+		matrix_fill (R, r);
+		for (i = 0; i < n; i++) {
+			for (j = 0; j < i; j++)
+				R->data[i][j] = go_quad_zero;
+			go_quad_add (&R->data[i][i], &R->data[i][i], &go_quad_one);
+		}
+
+		for (deg = 0; deg < 2; deg++) {
+			if (deg)
+				R->data[n / 2][n / 2] = go_quad_zero;
+			for (fwd = 0; fwd < 2; fwd++) {
+				gboolean err, err_multi;
+
+				err_multi = fwd
+					? go_quad_matrix_fwd_solve_multi (R, X, C, deg)
+					: go_quad_matrix_back_solve_multi (R, X, C, deg);
+				g_assert (!err_multi);
+				for (j = 0; j < c; j++) {
+					for (i = 0; i < n; i++)
+						b[i] = C->data[i][j];
+					g_assert (!ref_solve (R, x, b, fwd, deg));
+					for (i = 0; i < n; i++)
+						assert_same_quads (&x[i], &X->data[i][j], 1);
+
+					err = fwd
+						? go_quad_matrix_fwd_solve (R, b, b, deg)
+						: go_quad_matrix_back_solve (R, b, b, deg);
+					g_assert (!err);
+					assert_same_quads (b, x, n);
+				}
+
+				// Without allow_degenerate a zero on the
+				// diagonal is an error.
+				if (deg) {
+					for (i = 0; i < n; i++)
+						b[i] = C->data[i][0];
+					g_assert (ref_solve (R, x, b, fwd, FALSE));
+					err = fwd
+						? go_quad_matrix_fwd_solve (R, b, b, FALSE)
+						: go_quad_matrix_back_solve (R, b, b, FALSE);
+					g_assert (err);
+				}
+			}
+		}
+		g_printerr ("Matrix kernels of size %d ok\n", n);
+
+		g_free (x);
+		g_free (b);
+		go_quad_matrix_free (X);
+		go_quad_matrix_free (R);
+		go_quad_matrix_free (Cref);
+		go_quad_matrix_free (C);
+		go_quad_matrix_free (B);
+		go_quad_matrix_free (A);
+	}
+
+	for (n = 1; n <= 70; n += 23) {
+		int m = 2 * n + 5, qdet;
+		GOQuadMatrix *A = go_quad_matrix_new (m, n);
+		GOQuadMatrix *Rref = go_quad_matrix_new (n, n);
+		GOQuadMatrix *V = go_quad_matrix_new (m, n);
+		GOQuad *x = g_new (GOQuad, m), *xref = g_new (GOQuad, m);
+		GOQuad det, detref;
+		const GOQuadMatrix *R;
+		GOQuadQR *qr;
+
+		matrix_fill (A, r);
+		// A column that is all zero below the top.
+		for (i = 1; i < m; i++)
+			A->data[i][n - 1] = go_quad_zero;
+		qr = go_quad_qr_new (A);
+		qdet = ref_qr (A, Rref, V);
+
+		R = go_quad_qr_r (qr);
+		for (i = 0; i < n; i++)
+			assert_same_quads (R->data[i], Rref->data[i], n);
+
+		for (j = 0; j < n; j++) {
+			for (i = 0; i < m; i++)
+				x[i] = xref[i] = A->data[i][j];
+			go_quad_qr_multiply_qt (qr, x);
+			ref_qr_multiply_qt (V, xref);
+			assert_same_quads (x, xref, m);
+		}
+
+		go_quad_qr_determinant (qr, &det);
+		go_quad_init (&detref, qdet);
+		for (i = 0; i < n; i++)
+			go_quad_mul (&detref, &detref, &Rref->data[i][i]);
+		assert_same_quads (&det, &detref, 1);
+		g_printerr ("QR of size %dx%d ok\n", m, n);
+
+		go_quad_qr_free (qr);
+		g_free (xref);
+		g_free (x);
+		go_quad_matrix_free (V);
+		go_quad_matrix_free (Rref);
+		go_quad_matrix_free (A);
+	}
+
+	go_quad_end (state);
+	g_rand_free (r);
+}
+
+// The array kernels must give the very same bits as the scalar functions.
+static void
+vector_tests (void)
+{
+	GRand *r = g_rand_new_with_seed (17);
+	void *state = go_quad_start ();
+	int const n = 50, m = 70;
+	GOQuadMatrix *B = go_quad_matrix_new (n, m);
+	GOQuadMatrix *A = go_quad_matrix_new (1, n);
+	GOQuad *a, *y = g_new (GOQuad, n * m), *res = g_new (GOQuad, m);
+	GOQuad *col = g_new (GOQuad, n);
+	int i, j;
+
+	matrix_fill (A, r);
+	matrix_fill (B, r);
+	a = A->data[0];
+	// Big enough that splitting needs scaling, zero, and tiny.  The
+	// big values will overflow when multiplied with each other.
+	go_quad_init (&a[3], 1e305);
+	a[4] = go_quad_zero;
+	go_quad_init (&a[5], 1e-300);
+	go_quad_init (&B->data[6][7], -1e305);
+
+	go_quad_dot_product_v (res, a, B->data[0], n, m);
+	for (j = 0; j < m; j++) {
+		GOQuad acc = go_quad_zero, t;
+		for (i = 0; i < n; i++) {
+			go_quad_mul (&t, &a[i], &B->data[i][j]);
+			go_quad_add (&acc, &acc, &t);
+		}
+		g_assert (memcmp (&acc, &res[j], sizeof (acc)) == 0);
+		for (i = 0; i < n; i++)
+			col[i] = B->data[i][j];
+		go_quad_dot_product (&acc, a, col, n);
+		g_assert (memcmp (&acc, &res[j], sizeof (acc)) == 0);
+	}
+
+	// Known results.  With x = 1 + 2^-30, x*x is 1 + 2^-29 + 2^-60
+	// exactly, and x*x - (1 + 2^-29) is 2^-60 where plain doubles give 0.
+	{
+		double x = 1 + ldexp (1, -30);
+		GOQuad kv[2], kb[4], kr[2], ky[2];
+
+		go_quad_init (&kv[0], x);
+		go_quad_init (&kv[1], -1);
+		go_quad_init (&kb[0], x);
+		go_quad_init (&kb[1], 0);
+		go_quad_init (&kb[2], 1 + ldexp (1, -29));
+		go_quad_init (&kb[3], 1);
+		go_quad_dot_product_v (kr, kv, kb, 2, 2);
+		g_assert (kr[0].h == ldexp (1, -60) && kr[0].l == 0);
+		g_assert (kr[1].h == -1 && kr[1].l == 0);
+
+		ky[0] = go_quad_zero;
+		ky[1] = kb[2];
+		go_quad_axpy_v (ky, &kv[0], kv, 2);
+		g_assert (ky[0].h == 1 + ldexp (1, -29) &&
+			  ky[0].l == ldexp (1, -60));
+		g_assert (ky[1].h == ldexp (1, -30) && ky[1].l == 0);
+	}
+
+	memcpy (y, B->data[0], n * m * sizeof (GOQuad));
+	for (i = 0; i < n; i++) {
+		go_quad_axpy_v (y, &a[i], B->data[0], n * m);
+		for (j = 0; j < n * m; j++) {
+			GOQuad t;
+			go_quad_mul (&t, &a[i], &B->data[0][j]);
+			go_quad_add (&t, &B->data[0][j], &t);
+			g_assert (memcmp (&t, &y[j], sizeof (t)) == 0);
+		}
+		memcpy (y, B->data[0], n * m * sizeof (GOQuad));
+	}
+	g_printerr ("Vector kernels ok\n");
+
+	g_free (col);
+	g_free (res);
+	g_free (y);
+	go_quad_matrix_free (A);
+	go_quad_matrix_free (B);
+	go_quad_end (state);
+	g_rand_free (r);
+}
+
+/* ------------------------------------------------------------------------- */
+
 int
 main (int argc, char **argv)
 {
@@ -414,6 +784,8 @@ main (int argc, char **argv)
 	atan2_tests ();
 	hypot_tests ();
 	trig_tests ();
+	matrix_tests ();
+	vector_tests ();
 
 	return 0;
 }